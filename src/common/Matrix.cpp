@@ -309,6 +309,162 @@ void Matrix4::shear(float kx, float ky)
 	this->operator *=(t);
 }
 
+#if defined(LOVE_SIMD_SSE)
+
+// Converts 4 interleaved xyz points (stored in 3 registers) to separate x, y,
+// and z registers, and back.
+static inline void deinterleaveXYZ(__m128 a, __m128 b, __m128 c, __m128 &x, __m128 &y, __m128 &z)
+{
+	x = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void interleaveXYZ(__m128 x, __m128 y, __m128 z, __m128 &a, __m128 &b, __m128 &c)
+{
+	a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+#endif
+
+void Matrix4::transformXY(Vector2 *dst, const Vector2 *src, int size) const
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+
+	// Two points fit in each register: (x0, y0, x1, y1).
+	const __m128 cx = _mm_setr_ps(e[0], e[1], e[0], e[1]);
+	const __m128 cy = _mm_setr_ps(e[4], e[5], e[4], e[5]);
+	const __m128 ct = _mm_setr_ps(e[12], e[13], e[12], e[13]);
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m128 p0 = _mm_loadu_ps(&src[i + 0].x);
+		__m128 p1 = _mm_loadu_ps(&src[i + 2].x);
+
+		__m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(p0, p0, _MM_SHUFFLE(2, 2, 0, 0)), cx),
+			_mm_mul_ps(_mm_shuffle_ps(p0, p0, _MM_SHUFFLE(3, 3, 1, 1)), cy)), ct);
+		__m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(p1, p1, _MM_SHUFFLE(2, 2, 0, 0)), cx),
+			_mm_mul_ps(_mm_shuffle_ps(p1, p1, _MM_SHUFFLE(3, 3, 1, 1)), cy)), ct);
+
+		_mm_storeu_ps(&dst[i + 0].x, r0);
+		_mm_storeu_ps(&dst[i + 2].x, r1);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		float32x4x2_t p = vld2q_f32(&src[i].x);
+		float32x4x2_t r;
+
+		r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[12]), p.val[0], e[0]), p.val[1], e[4]);
+		r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[13]), p.val[0], e[1]), p.val[1], e[5]);
+
+		vst2q_f32(&dst[i].x, r);
+	}
+
+#endif
+
+	if (i < size)
+		transformXY<Vector2, Vector2>(dst + i, src + i, size - i);
+}
+
+void Matrix4::transformXY0(Vector3 *dst, const Vector2 *src, int size) const
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m128 p0 = _mm_loadu_ps(&src[i + 0].x);
+		__m128 p1 = _mm_loadu_ps(&src[i + 2].x);
+
+		__m128 x = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 y = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[0])), _mm_mul_ps(y, _mm_set1_ps(e[4]))), _mm_set1_ps(e[12]));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[1])), _mm_mul_ps(y, _mm_set1_ps(e[5]))), _mm_set1_ps(e[13]));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[2])), _mm_mul_ps(y, _mm_set1_ps(e[6]))), _mm_set1_ps(e[14]));
+
+		__m128 a, b, c;
+		interleaveXYZ(rx, ry, rz, a, b, c);
+
+		_mm_storeu_ps(&dst[i].x + 0, a);
+		_mm_storeu_ps(&dst[i].x + 4, b);
+		_mm_storeu_ps(&dst[i].x + 8, c);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		float32x4x2_t p = vld2q_f32(&src[i].x);
+		float32x4x3_t r;
+
+		r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[12]), p.val[0], e[0]), p.val[1], e[4]);
+		r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[13]), p.val[0], e[1]), p.val[1], e[5]);
+		r.val[2] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[14]), p.val[0], e[2]), p.val[1], e[6]);
+
+		vst3q_f32(&dst[i].x, r);
+	}
+
+#endif
+
+	if (i < size)
+		transformXY0<Vector3, Vector2>(dst + i, src + i, size - i);
+}
+
+void Matrix4::transformXYZ(Vector3 *dst, const Vector3 *src, int size) const
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m128 x, y, z;
+		deinterleaveXYZ(_mm_loadu_ps(&src[i].x + 0), _mm_loadu_ps(&src[i].x + 4), _mm_loadu_ps(&src[i].x + 8), x, y, z);
+
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[0])), _mm_mul_ps(y, _mm_set1_ps(e[4]))),
+			_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(e[8])), _mm_set1_ps(e[12])));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[1])), _mm_mul_ps(y, _mm_set1_ps(e[5]))),
+			_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(e[9])), _mm_set1_ps(e[13])));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(e[2])), _mm_mul_ps(y, _mm_set1_ps(e[6]))),
+			_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(e[10])), _mm_set1_ps(e[14])));
+
+		__m128 a, b, c;
+		interleaveXYZ(rx, ry, rz, a, b, c);
+
+		_mm_storeu_ps(&dst[i].x + 0, a);
+		_mm_storeu_ps(&dst[i].x + 4, b);
+		_mm_storeu_ps(&dst[i].x + 8, c);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		float32x4x3_t p = vld3q_f32(&src[i].x);
+		float32x4x3_t r;
+
+		r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[12]), p.val[0], e[0]), p.val[1], e[4]), p.val[2], e[8]);
+		r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[13]), p.val[0], e[1]), p.val[1], e[5]), p.val[2], e[9]);
+		r.val[2] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(e[14]), p.val[0], e[2]), p.val[1], e[6]), p.val[2], e[10]);
+
+		vst3q_f32(&dst[i].x, r);
+	}
+
+#endif
+
+	if (i < size)
+		transformXYZ<Vector3, Vector3>(dst + i, src + i, size - i);
+}
+
 bool Matrix4::isAffine2DTransform() const
 {
 	return fabsf(e[2] + e[3] + e[6] + e[7] + e[8] + e[9] + e[11] + e[14]) < 0.00001f
@@ -211,6 +211,14 @@ class Matrix4
 	template <typename Vdst, typename Vsrc>
 	void transformXYZ(Vdst *dst, const Vsrc *src, int size) const;
 
+	/**
+	 * Overloads of the above for tightly packed Vector2 and Vector3 arrays,
+	 * which use SIMD instructions when they're available.
+	 **/
+	void transformXY(Vector2 *dst, const Vector2 *src, int size) const;
+	void transformXY0(Vector3 *dst, const Vector2 *src, int size) const;
+	void transformXYZ(Vector3 *dst, const Vector3 *src, int size) const;
+
 	/**
 	 * Gets whether this matrix is an affine 2D transform (if the only non-
 	 * identity elements are the upper-left 2x2 and 2 translation values in the
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "Range.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace love
+{
+
+/**
+ * A small sorted set of disjoint ranges, used to track which parts of a
+ * buffer need to be uploaded. Ranges that are at most mergeDistance apart are
+ * coalesced, and once more than maxRanges ranges would be needed, the two
+ * closest neighbouring ranges are merged.
+ **/
+class RangeSet
+{
+public:
+
+	RangeSet(size_t maxRanges = 16, size_t mergeDistance = 0)
+		: maxRanges(std::max(maxRanges, (size_t) 1))
+		, mergeDistance(mergeDistance)
+	{
+		ranges.reserve(this->maxRanges + 1);
+	}
+
+	void setMergeDistance(size_t distance) { mergeDistance = distance; }
+
+	bool isEmpty() const { return ranges.empty(); }
+	void clear() { ranges.clear(); }
+
+	size_t getCount() const { return ranges.size(); }
+	const Range &operator [] (size_t i) const { return ranges[i]; }
+
+	std::vector<Range>::const_iterator begin() const { return ranges.begin(); }
+	std::vector<Range>::const_iterator end() const { return ranges.end(); }
+
+	Range getBounds() const
+	{
+		if (ranges.empty())
+			return Range();
+
+		Range bounds = ranges.front();
+		bounds.encapsulate(ranges.back());
+		return bounds;
+	}
+
+	size_t getTotalSize() const
+	{
+		size_t total = 0;
+		for (const Range &r : ranges)
+			total += r.getSize();
+		return total;
+	}
+
+	void add(size_t index) { add(Range(index, 1)); }
+	void add(size_t offset, size_t size) { add(Range(offset, size)); }
+
+	void add(const Range &r)
+	{
+		if (!r.isValid())
+			return;
+
+		// Fast path for the common case of writes that move forward.
+		if (!ranges.empty() && r.first >= ranges.back().first)
+		{
+			Range &back = ranges.back();
+			if (r.first <= back.last || r.first - back.last <= mergeDistance + 1)
+			{
+				back.encapsulate(r);
+				return;
+			}
+
+			ranges.push_back(r);
+			limitCount();
+			return;
+		}
+
+		// Find the first range which ends close enough to r to be merged with
+		// it, or which comes after it.
+		auto it = std::lower_bound(ranges.begin(), ranges.end(), r, [this](const Range &a, const Range &b)
+		{
+			return a.last + mergeDistance + 1 < b.first;
+		});
+
+		if (it == ranges.end() || !isNear(*it, r))
+		{
+			ranges.insert(it, r);
+			limitCount();
+			return;
+		}
+
+		it->encapsulate(r);
+
+		// The grown range may now reach the ones after it.
+		auto last = it + 1;
+		while (last != ranges.end() && isNear(*it, *last))
+		{
+			it->encapsulate(*last);
+			++last;
+		}
+
+		ranges.erase(it + 1, last);
+	}
+
+private:
+
+	bool isNear(const Range &a, const Range &b) const
+	{
+		if (a.first > b.first)
+			return isNear(b, a);
+
+		return b.first <= a.last || b.first - a.last <= mergeDistance + 1;
+	}
+
+	void limitCount()
+	{
+		while (ranges.size() > maxRanges)
+		{
+			size_t best = 0;
+			size_t bestgap = std::numeric_limits<size_t>::max();
+
+			for (size_t i = 0; i + 1 < ranges.size(); i++)
+			{
+				size_t gap = ranges[i + 1].first - ranges[i].last;
+				if (gap < bestgap)
+				{
+					best = i;
+					bestgap = gap;
+				}
+			}
+
+			ranges[best].encapsulate(ranges[best + 1]);
+			ranges.erase(ranges.begin() + best + 1);
+		}
+	}
+
+	std::vector<Range> ranges;
+	size_t maxRanges;
+	size_t mergeDistance;
+
+}; // RangeSet
+
+} // love
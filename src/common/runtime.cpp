@@ -22,6 +22,7 @@
 #include "runtime.h"
 
 // LOVE
+#include "Data.h"
 #include "Module.h"
 #include "Object.h"
 #include "Reference.h"
@@ -979,6 +980,24 @@ int luax_c_insistglobal(lua_State *L, const char *k)
 	return luax_insistglobal(L, k);
 }
 
+void *luax_retaindata(lua_State *L, int idx, void **bytes, size_t *size)
+{
+	Data *data = luax_totype<Data>(L, idx);
+	if (data == nullptr)
+		return nullptr;
+
+	data->retain();
+
+	*bytes = data->getData();
+	*size = data->getSize();
+	return data;
+}
+
+void luax_releasedata(void *data)
+{
+	((Data *) data)->release();
+}
+
 int luax_insistlove(lua_State *L, const char *k)
 {
 	luax_insistglobal(L, "love");
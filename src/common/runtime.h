@@ -549,6 +549,16 @@ extern "C" { // Called by enet and luasocket
 	int luax_c_insistglobal(lua_State *L, const char *k);
 }
 
+extern "C" { // Called by enet
+	/**
+	 * Retains the Data object at idx and gets its memory, without copying it.
+	 * Returns null if the value isn't a Data. A non-null result must be passed
+	 * to luax_releasedata once the memory is no longer used.
+	 **/
+	void *luax_retaindata(lua_State *L, int idx, void **bytes, size_t *size);
+	void luax_releasedata(void *data);
+}
+
 /**
  * Like luax_totype, but causes an error if the value at idx is not Proxy,
  * or is not the specified type.
@@ -33,6 +33,14 @@
 #include <cstdio>
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 #define LUA_COMPAT_ALL
@@ -42,12 +50,175 @@ extern "C" {
 #include <enet/enet.h>
 }
 
+extern "C" {
+	void luax_register(lua_State *L, const char *name, const luaL_Reg *l);
+
+	// Zero-copy interop with love Data objects.
+	void *luax_retaindata(lua_State *L, int idx, void **bytes, size_t *size);
+	void luax_releasedata(void *data);
+	void luax_pushexternalbytedata(lua_State *L, void *bytes, size_t size, void (*deleter)(void *, void *), void *context);
+}
+
 #define check_host(l, idx)\
 	*(ENetHost**)luaL_checkudata(l, idx, "enet_host")
 
 #define check_peer(l, idx)\
 	*(ENetPeer**)luaL_checkudata(l, idx, "enet_peer")
 
+/**
+ * An event received by a service thread, along with the ENet time (in
+ * milliseconds) at which it was received.
+ */
+struct TimedEvent {
+	ENetEvent event;
+	enet_uint32 time;
+};
+
+/**
+ * Services a host on a native thread, so sending and receiving doesn't
+ * depend on how often Lua gets around to calling host:service. While the
+ * thread exists, every access to the host or its peers must hold the mutex.
+ */
+struct ServiceThread {
+	ENetHost *host;
+	std::thread thread;
+	std::mutex mutex;
+	std::atomic<bool> running;
+	enet_uint32 interval;
+
+	// Events waiting to be picked up by Lua.
+	std::mutex event_mutex;
+	std::condition_variable event_cond;
+	std::deque<TimedEvent> events;
+	bool failed;
+};
+
+static std::mutex service_threads_mutex;
+static std::unordered_map<ENetHost *, ServiceThread *> service_threads;
+
+static ServiceThread *find_service_thread(ENetHost *host) {
+	std::lock_guard<std::mutex> lock(service_threads_mutex);
+	auto it = service_threads.find(host);
+	return it != service_threads.end() ? it->second : NULL;
+}
+
+/**
+ * Keeps the host's service thread (if any) away from the host and its peers
+ * for as long as the lock is in scope. Nothing that can raise a Lua error
+ * may be called while holding it.
+ */
+class HostLock {
+public:
+	HostLock(ENetHost *host) : thread(find_service_thread(host)) {
+		if (thread != NULL)
+			thread->mutex.lock();
+	}
+
+	~HostLock() {
+		if (thread != NULL)
+			thread->mutex.unlock();
+	}
+
+private:
+	ServiceThread *thread;
+};
+
+static void service_thread_main(ServiceThread *thread) {
+	ENetHost *host = thread->host;
+
+	while (thread->running) {
+		{
+			std::lock_guard<std::mutex> lock(thread->mutex);
+			TimedEvent event;
+			int out;
+
+			// Never block while holding the host, Lua may want to send.
+			while ((out = enet_host_service(host, &event.event, 0)) > 0) {
+				event.time = enet_time_get();
+
+				std::lock_guard<std::mutex> event_lock(thread->event_mutex);
+				thread->events.push_back(event);
+				thread->event_cond.notify_all();
+			}
+
+			if (out < 0) {
+				std::lock_guard<std::mutex> event_lock(thread->event_mutex);
+				thread->failed = true;
+				thread->event_cond.notify_all();
+			}
+		}
+
+		// Sleep until something arrives, or until it's time to send whatever
+		// Lua queued up in the meantime.
+		enet_uint32 condition = ENET_SOCKET_WAIT_RECEIVE | ENET_SOCKET_WAIT_INTERRUPT;
+		enet_socket_wait(host->socket, &condition, thread->interval);
+	}
+}
+
+static void stop_service_thread(ServiceThread *thread) {
+	thread->running = false;
+	if (thread->thread.joinable())
+		thread->thread.join();
+
+	// Wake up anything still waiting for events.
+	std::lock_guard<std::mutex> event_lock(thread->event_mutex);
+	thread->event_cond.notify_all();
+}
+
+/**
+ * Stop and remove the host's service thread, dropping any events Lua hasn't
+ * picked up yet.
+ */
+static void destroy_service_thread(ENetHost *host) {
+	ServiceThread *thread = NULL;
+	{
+		std::lock_guard<std::mutex> lock(service_threads_mutex);
+		auto it = service_threads.find(host);
+		if (it == service_threads.end())
+			return;
+		thread = it->second;
+		service_threads.erase(it);
+	}
+
+	stop_service_thread(thread);
+
+	for (const TimedEvent &event : thread->events) {
+		if (event.event.type == ENET_EVENT_TYPE_RECEIVE)
+			enet_packet_destroy(event.event.packet);
+	}
+
+	delete thread;
+}
+
+/**
+ * Pop an event received by a service thread, waiting up to timeout
+ * milliseconds for one to arrive.
+ * Returns 1 if an event was popped, 0 if there was none, and -1 if the
+ * thread failed to service the host.
+ */
+static int pop_thread_event(ServiceThread *thread, int timeout, TimedEvent *event) {
+	std::unique_lock<std::mutex> lock(thread->event_mutex);
+
+	if (thread->events.empty() && !thread->failed && timeout > 0 && thread->running) {
+		thread->event_cond.wait_for(lock, std::chrono::milliseconds(timeout), [thread]() {
+			return !thread->events.empty() || thread->failed || !thread->running;
+		});
+	}
+
+	if (!thread->events.empty()) {
+		*event = thread->events.front();
+		thread->events.pop_front();
+		return 1;
+	}
+
+	if (thread->failed) {
+		thread->failed = false;
+		return -1;
+	}
+
+	return 0;
+}
+
 /**
  * Parse address string, eg:
  *	*:5959
@@ -203,9 +374,49 @@ static void push_peer(lua_State *l, ENetPeer *peer) {
 	lua_remove(l, -2); // remove enet_peers
 }
 
-static void push_event(lua_State *l, ENetEvent *event) {
+static void destroy_packet_data(void * /*data*/, void *packet) {
+	enet_packet_destroy((ENetPacket *) packet);
+}
+
+/**
+ * Read an optional receive mode off the stack. "string" (the default) copies
+ * received packets into Lua strings, "data" wraps them in a love ByteData
+ * without copying.
+ */
+static bool read_receive_mode(lua_State *l, int idx) {
+	if (lua_isnoneornil(l, idx))
+		return false;
+
+	const char *mode_str = luaL_checkstring(l, idx);
+	if (strcmp("data", mode_str) == 0) {
+		return true;
+	} else if (strcmp("string", mode_str) != 0) {
+		luaL_error(l, "Unknown receive mode: %s", mode_str);
+	}
+
+	return false;
+}
+
+/**
+ * Push the contents of a received packet, and take ownership of the packet
+ */
+static void push_packet(lua_State *l, ENetPacket *packet, bool as_data) {
+	if (as_data) {
+		// The ByteData destroys the packet once it's garbage collected, or
+		// right away if it can't be created.
+		luax_pushexternalbytedata(l, packet->data, packet->dataLength, destroy_packet_data, packet);
+	} else {
+		lua_pushlstring(l, (const char *)packet->data, packet->dataLength);
+		enet_packet_destroy(packet);
+	}
+}
+
+static void push_event(lua_State *l, ENetEvent *event, enet_uint32 time, bool as_data) {
 	lua_newtable(l); // event table
 
+	lua_pushinteger(l, time);
+	lua_setfield(l, -2, "time");
+
 	if (event->peer) {
 		push_peer(l, event->peer);
 		lua_setfield(l, -2, "peer");
@@ -225,15 +436,13 @@ static void push_event(lua_State *l, ENetEvent *event) {
 			lua_pushstring(l, "disconnect");
 			break;
 		case ENET_EVENT_TYPE_RECEIVE:
-			lua_pushlstring(l, (const char *)event->packet->data, event->packet->dataLength);
+			push_packet(l, event->packet, as_data);
 			lua_setfield(l, -2, "data");
 
 			lua_pushinteger(l, event->channelID);
 			lua_setfield(l, -2, "channel");
 
 			lua_pushstring(l, "receive");
-
-			enet_packet_destroy(event->packet);
 			break;
 		case ENET_EVENT_TYPE_NONE:
 			lua_pushstring(l, "none");
@@ -243,20 +452,30 @@ static void push_event(lua_State *l, ENetEvent *event) {
 	lua_setfield(l, -2, "type");
 }
 
+static void release_packet_data(ENetPacket *packet) {
+	luax_releasedata(packet->userData);
+}
+
 /**
  * Read a packet off the stack as a string
- * idx is position of string or lightuserdata
+ * idx is position of string, love Data, or lightuserdata
  */
 static ENetPacket *read_packet(lua_State *l, int idx, enet_uint8 *channel_id) {
-	size_t size;
+	size_t size = 0;
 	int argc = lua_gettop(l);
-	const void* data;
+	const void* data = NULL;
+	int data_idx = 0;
 
 	if (lua_islightuserdata(l, idx)) {
 		data = lua_touserdata(l, idx);
 		size = (size_t) luaL_checknumber(l, idx + 1);
 		idx++;
 	}
+	else if (lua_type(l, idx) == LUA_TUSERDATA) {
+		// love Data is retained after parsing the other arguments, since
+		// errors would leak the reference.
+		data_idx = idx;
+	}
 	else {
 		data = luaL_checklstring(l, idx, &size);
 	}
@@ -282,6 +501,26 @@ static ENetPacket *read_packet(lua_State *l, int idx, enet_uint8 *channel_id) {
 		*channel_id = (int) luaL_checknumber(l, idx+1);
 	}
 
+	if (data_idx != 0) {
+		// Send straight from the Data's memory. The packet keeps the Data
+		// alive until ENet is done with it.
+		void *bytes = NULL;
+		void *object = luax_retaindata(l, data_idx, &bytes, &size);
+		if (object == NULL) {
+			luaL_typerror(l, data_idx, "string or Data");
+		}
+
+		packet = enet_packet_create(bytes, size, flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+		if (packet == NULL) {
+			luax_releasedata(object);
+			luaL_error(l, "Failed to create packet");
+		}
+
+		packet->freeCallback = release_packet_data;
+		packet->userData = object;
+		return packet;
+	}
+
 	packet = enet_packet_create(data, size, flags);
 	if (packet == NULL) {
 		luaL_error(l, "Failed to create packet");
@@ -290,6 +529,21 @@ static ENetPacket *read_packet(lua_State *l, int idx, enet_uint8 *channel_id) {
 	return packet;
 }
 
+/**
+ * Get the peer at idx, or NULL if the value isn't a peer
+ */
+static ENetPeer *test_peer(lua_State *l, int idx) {
+	ENetPeer **peer = (ENetPeer **) lua_touserdata(l, idx);
+	if (peer == NULL || !lua_getmetatable(l, idx))
+		return NULL;
+
+	luaL_getmetatable(l, "enet_peer");
+	bool is_peer = lua_rawequal(l, -1, -2) != 0;
+	lua_pop(l, 2);
+
+	return is_peer ? *peer : NULL;
+}
+
 /**
  * Create a new host
  * Args:
@@ -342,6 +596,14 @@ static int host_create(lua_State *l) {
 	return 1;
 }
 
+/**
+ * The current ENet time in milliseconds, as used for event timestamps
+ */
+static int get_time(lua_State *l) {
+	lua_pushinteger(l, enet_time_get());
+	return 1;
+}
+
 static int linked_version(lua_State *l) {
 	lua_pushfstring(l, "%d.%d.%d",
 			ENET_VERSION_GET_MAJOR(enet_linked_version()),
@@ -354,6 +616,7 @@ static int linked_version(lua_State *l) {
  * Serice a host
  * Args:
  *	timeout
+ *	[receive_mode = "string"]
  *
  * Return
  *	nil on no event
@@ -367,19 +630,39 @@ static int host_service(lua_State *l) {
 	ENetEvent event;
 	int timeout = 0, out;
 
-	if (lua_gettop(l) > 1)
+	if (!lua_isnoneornil(l, 2))
 		timeout = (int) luaL_checknumber(l, 2);
 
+	bool as_data = read_receive_mode(l, 3);
+
+	ServiceThread *thread = find_service_thread(host);
+	if (thread != NULL) {
+		TimedEvent timed_event;
+		out = pop_thread_event(thread, timeout, &timed_event);
+		if (out > 0) {
+			push_event(l, &timed_event.event, timed_event.time, as_data);
+			return 1;
+		}
+		if (out < 0) return luaL_error(l, "Error during service");
+		if (thread->running) return 0;
+
+		// The thread was stopped and all of its events have been handed out,
+		// so go back to servicing the host from Lua.
+		destroy_service_thread(host);
+	}
+
 	out = enet_host_service(host, &event, timeout);
 	if (out == 0) return 0;
 	if (out < 0) return luaL_error(l, "Error during service");
 
-	push_event(l, &event);
+	push_event(l, &event, enet_time_get(), as_data);
 	return 1;
 }
 
 /**
  * Dispatch a single event if available
+ * Args:
+ *	[receive_mode = "string"]
  */
 static int host_check_events(lua_State *l) {
 	ENetHost *host = check_host(l, 1);
@@ -387,11 +670,116 @@ static int host_check_events(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 	ENetEvent event;
+	bool as_data = read_receive_mode(l, 2);
+
+	ServiceThread *thread = find_service_thread(host);
+	if (thread != NULL) {
+		TimedEvent timed_event;
+		int out = pop_thread_event(thread, 0, &timed_event);
+		if (out == 0) return 0;
+		if (out < 0) return luaL_error(l, "Error checking event");
+
+		push_event(l, &timed_event.event, timed_event.time, as_data);
+		return 1;
+	}
+
 	int out = enet_host_check_events(host, &event);
 	if (out == 0) return 0;
 	if (out < 0) return luaL_error(l, "Error checking event");
 
-	push_event(l, &event);
+	push_event(l, &event, enet_time_get(), as_data);
+	return 1;
+}
+
+/**
+ * Start servicing the host on a dedicated thread. Events are timestamped as
+ * they arrive and queued until host:service or host:check_events picks them
+ * up, and peer:receive no longer returns anything. Packets queued from Lua are
+ * sent on the next pass of the thread, or right away with host:flush.
+ * Args:
+ *	[interval = 1], longest time in milliseconds between two passes
+ *
+ * Return
+ *	true if the thread was started, false if it was already running
+ */
+static int host_start_service_thread(lua_State *l) {
+	ENetHost *host = check_host(l, 1);
+	if (!host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+
+	enet_uint32 interval = 1;
+	if (!lua_isnoneornil(l, 2))
+		interval = (enet_uint32) std::max(1, (int) luaL_checknumber(l, 2));
+
+	ServiceThread *thread = find_service_thread(host);
+	if (thread != NULL && thread->running) {
+		lua_pushboolean(l, 0);
+		return 1;
+	}
+
+	bool created = thread == NULL;
+	const char *error = NULL;
+
+	try {
+		if (created) {
+			thread = new ServiceThread();
+			thread->host = host;
+			thread->failed = false;
+		}
+
+		thread->interval = interval;
+		thread->running = true;
+		thread->thread = std::thread(service_thread_main, thread);
+	}
+	catch (std::exception &e) {
+		error = e.what();
+	}
+
+	if (error != NULL) {
+		if (created) {
+			delete thread;
+		} else {
+			thread->running = false;
+		}
+		return luaL_error(l, "Failed to start service thread: %s", error);
+	}
+
+	if (created) {
+		std::lock_guard<std::mutex> lock(service_threads_mutex);
+		service_threads[host] = thread;
+	}
+
+	lua_pushboolean(l, 1);
+	return 1;
+}
+
+/**
+ * Stop the host's service thread. Events it already received are still
+ * returned by host:service and host:check_events before the host is serviced
+ * from Lua again.
+ */
+static int host_stop_service_thread(lua_State *l) {
+	ENetHost *host = check_host(l, 1);
+	if (!host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+
+	ServiceThread *thread = find_service_thread(host);
+	if (thread != NULL)
+		stop_service_thread(thread);
+
+	return 0;
+}
+
+static int host_service_thread_running(lua_State *l) {
+	ENetHost *host = check_host(l, 1);
+	if (!host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+
+	ServiceThread *thread = find_service_thread(host);
+	lua_pushboolean(l, thread != NULL && thread->running);
 	return 1;
 }
 
@@ -405,7 +793,11 @@ static int host_compress_with_range_coder(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	int result = enet_host_compress_with_range_coder (host);
+	int result;
+	{
+		HostLock lock(host);
+		result = enet_host_compress_with_range_coder (host);
+	}
 	if (result == 0) {
 		lua_pushboolean (l, 1);
 	} else {
@@ -443,7 +835,10 @@ static int host_connect(lua_State *l) {
 	}
 
 	// printf("host connect, channels=%d, data=%d\n", channel_count, data);
-	peer = enet_host_connect(host, &address, channel_count, data);
+	{
+		HostLock lock(host);
+		peer = enet_host_connect(host, &address, channel_count, data);
+	}
 
 	if (peer == NULL) {
 		return luaL_error(l, "Failed to create peer");
@@ -459,6 +854,7 @@ static int host_flush(lua_State *l) {
 	if (!host) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
+	HostLock lock(host);
 	enet_host_flush(host);
 	return 0;
 }
@@ -471,10 +867,73 @@ static int host_broadcast(lua_State *l) {
 
 	enet_uint8 channel_id;
 	ENetPacket *packet = read_packet(l, 2, &channel_id);
+
+	HostLock lock(host);
 	enet_host_broadcast(host, channel_id, packet);
 	return 0;
 }
 
+/**
+ * Send one packet to several peers. Unlike calling peer:send for each peer,
+ * the data is only copied (or wrapped) once.
+ * Args:
+ *	peers, table
+ *	packet data, string or Data
+ *	channel id
+ *	flags ["reliable", nil]
+ *
+ * Return
+ *	the number of peers the packet was queued for
+ */
+static int host_multicast(lua_State *l) {
+	ENetHost *host = check_host(l, 1);
+	if (!host) {
+		return luaL_error(l, "Tried to index a nil host!");
+	}
+
+	luaL_checktype(l, 2, LUA_TTABLE);
+	int peer_count = (int) lua_objlen(l, 2);
+
+	std::vector<ENetPeer *> peers;
+	peers.reserve(peer_count);
+
+	for (int i = 1; i <= peer_count; i++) {
+		lua_rawgeti(l, 2, i);
+		ENetPeer *peer = test_peer(l, -1);
+		if (peer == NULL) {
+			return luaL_error(l, "Expected a peer at index %d of the peer table", i);
+		}
+		if (peer->host != host) {
+			return luaL_error(l, "The peer at index %d of the peer table belongs to another host", i);
+		}
+		lua_pop(l, 1);
+		peers.push_back(peer);
+	}
+
+	enet_uint8 channel_id;
+	ENetPacket *packet = read_packet(l, 3, &channel_id);
+	int sent = 0;
+
+	{
+		// Held for the whole loop, so the service thread can't send and free
+		// the packet before it has been queued for every peer.
+		HostLock lock(host);
+
+		for (ENetPeer *peer : peers) {
+			if (enet_peer_send(peer, channel_id, packet) == 0) {
+				sent++;
+			}
+		}
+
+		if (sent == 0) {
+			enet_packet_destroy(packet);
+		}
+	}
+
+	lua_pushinteger(l, sent);
+	return 1;
+}
+
 // Args: limit:number
 static int host_channel_limit(lua_State *l) {
 	ENetHost *host = check_host(l, 1);
@@ -482,6 +941,7 @@ static int host_channel_limit(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 	int limit = (int) luaL_checknumber(l, 2);
+	HostLock lock(host);
 	enet_host_channel_limit(host, limit);
 	return 0;
 }
@@ -493,6 +953,7 @@ static int host_bandwidth_limit(lua_State *l) {
 	}
 	enet_uint32 in_bandwidth = (int) luaL_checknumber(l, 2);
 	enet_uint32 out_bandwidth = (int) luaL_checknumber(l, 2);
+	HostLock lock(host);
 	enet_host_bandwidth_limit(host, in_bandwidth, out_bandwidth);
 	return 0;
 }
@@ -519,7 +980,13 @@ static int host_total_sent_data(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->totalSentData);
+	enet_uint32 value;
+	{
+		HostLock lock(host);
+		value = host->totalSentData;
+	}
+
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -530,7 +997,13 @@ static int host_total_received_data(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->totalReceivedData);
+	enet_uint32 value;
+	{
+		HostLock lock(host);
+		value = host->totalReceivedData;
+	}
+
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -540,7 +1013,13 @@ static int host_service_time(lua_State *l) {
 		return luaL_error(l, "Tried to index a nil host!");
 	}
 
-	lua_pushinteger (l, host->serviceTime);
+	enet_uint32 value;
+	{
+		HostLock lock(host);
+		value = host->serviceTime;
+	}
+
+	lua_pushinteger (l, value);
 
 	return 1;
 }
@@ -579,6 +1058,7 @@ static int host_gc(lua_State *l) {
 	ENetHost** host = (ENetHost**)luaL_checkudata(l, 1, "enet_host");
 	// We don't want to crash by destroying a non-existant host.
 	if (*host) {
+		destroy_service_thread(*host);
 		enet_host_destroy(*host);
 	}
 	*host = NULL;
@@ -588,17 +1068,23 @@ static int host_gc(lua_State *l) {
 static int peer_tostring(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 	char host_str[128];
-	enet_address_get_host_ip(&peer->address, host_str, 128);
+	ENetAddress address;
+	{
+		HostLock lock(peer->host);
+		address = peer->address;
+	}
+	enet_address_get_host_ip(&address, host_str, 128);
 
 	lua_pushstring(l, host_str);
 	lua_pushstring(l, ":");
-	lua_pushinteger(l, peer->address.port);
+	lua_pushinteger(l, address.port);
 	lua_concat(l, 3);
 	return 1;
 }
 
 static int peer_ping(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	HostLock lock(peer->host);
 	enet_peer_ping(peer);
 	return 0;
 }
@@ -610,6 +1096,7 @@ static int peer_throttle_configure(lua_State *l) {
 	enet_uint32 acceleration = (int) luaL_checknumber(l, 3);
 	enet_uint32 deceleration = (int) luaL_checknumber(l, 4);
 
+	HostLock lock(peer->host);
 	enet_peer_throttle_configure(peer, interval, acceleration, deceleration);
 	return 0;
 }
@@ -617,12 +1104,16 @@ static int peer_throttle_configure(lua_State *l) {
 static int peer_round_trip_time(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 round_trip_time = (int) luaL_checknumber(l, 2);
-		peer->roundTripTime = round_trip_time;
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 round_trip_time = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		HostLock lock(peer->host);
+		if (set)
+			peer->roundTripTime = round_trip_time;
+		round_trip_time = peer->roundTripTime;
 	}
 
-	lua_pushinteger (l, peer->roundTripTime);
+	lua_pushinteger (l, round_trip_time);
 
 	return 1;
 }
@@ -630,11 +1121,16 @@ static int peer_round_trip_time(lua_State *l) {
 static int peer_last_round_trip_time(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 round_trip_time = (int) luaL_checknumber(l, 2);
-		peer->lastRoundTripTime = round_trip_time;
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 round_trip_time = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		HostLock lock(peer->host);
+		if (set)
+			peer->lastRoundTripTime = round_trip_time;
+		round_trip_time = peer->lastRoundTripTime;
 	}
-	lua_pushinteger (l, peer->lastRoundTripTime);
+
+	lua_pushinteger (l, round_trip_time);
 
 	return 1;
 }
@@ -642,12 +1138,16 @@ static int peer_last_round_trip_time(lua_State *l) {
 static int peer_ping_interval(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	if (lua_gettop(l) > 1) {
-		enet_uint32 interval = (int) luaL_checknumber(l, 2);
-		enet_peer_ping_interval (peer, interval);
+	bool set = lua_gettop(l) > 1;
+	enet_uint32 interval = set ? (int) luaL_checknumber(l, 2) : 0;
+	{
+		HostLock lock(peer->host);
+		if (set)
+			enet_peer_ping_interval (peer, interval);
+		interval = peer->pingInterval;
 	}
 
-	lua_pushinteger (l, peer->pingInterval);
+	lua_pushinteger (l, interval);
 
 	return 1;
 }
@@ -668,11 +1168,18 @@ static int peer_timeout(lua_State *l) {
 			if (!lua_isnil(l, 2)) timeout_limit = (int) luaL_checknumber(l, 2);
 	}
 
-	enet_peer_timeout (peer, timeout_limit, timeout_minimum, timeout_maximum);
+	{
+		HostLock lock(peer->host);
+		enet_peer_timeout (peer, timeout_limit, timeout_minimum, timeout_maximum);
 
-	lua_pushinteger (l, peer->timeoutLimit);
-	lua_pushinteger (l, peer->timeoutMinimum);
-	lua_pushinteger (l, peer->timeoutMaximum);
+		timeout_limit = peer->timeoutLimit;
+		timeout_minimum = peer->timeoutMinimum;
+		timeout_maximum = peer->timeoutMaximum;
+	}
+
+	lua_pushinteger (l, timeout_limit);
+	lua_pushinteger (l, timeout_minimum);
+	lua_pushinteger (l, timeout_maximum);
 
 	return 3;
 }
@@ -681,6 +1188,7 @@ static int peer_disconnect(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	HostLock lock(peer->host);
 	enet_peer_disconnect(peer, data);
 	return 0;
 }
@@ -689,6 +1197,7 @@ static int peer_disconnect_now(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	HostLock lock(peer->host);
 	enet_peer_disconnect_now(peer, data);
 	return 0;
 }
@@ -697,6 +1206,7 @@ static int peer_disconnect_later(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
 	enet_uint32 data = lua_gettop(l) > 1 ? (int) luaL_checknumber(l, 2) : 0;
+	HostLock lock(peer->host);
 	enet_peer_disconnect_later(peer, data);
 	return 0;
 }
@@ -713,7 +1223,13 @@ static int peer_index(lua_State *l) {
 static int peer_state(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	switch (peer->state) {
+	ENetPeerState state;
+	{
+		HostLock lock(peer->host);
+		state = peer->state;
+	}
+
+	switch (state) {
 		case (ENET_PEER_STATE_DISCONNECTED):
 			lua_pushstring (l, "disconnected");
 			break;
@@ -754,7 +1270,13 @@ static int peer_state(lua_State *l) {
 static int peer_connect_id(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
 
-	lua_pushinteger (l, peer->connectID);
+	enet_uint32 connect_id;
+	{
+		HostLock lock(peer->host);
+		connect_id = peer->connectID;
+	}
+
+	lua_pushinteger (l, connect_id);
 
 	return 1;
 }
@@ -762,6 +1284,7 @@ static int peer_connect_id(lua_State *l) {
 
 static int peer_reset(lua_State *l) {
 	ENetPeer *peer = check_peer(l, 1);
+	HostLock lock(peer->host);
 	enet_peer_reset(peer);
 	return 0;
 }
@@ -771,25 +1294,29 @@ static int peer_receive(lua_State *l) {
 	ENetPacket *packet;
 	enet_uint8 channel_id = 0;
 
-	if (lua_gettop(l) > 1) {
+	if (!lua_isnoneornil(l, 2)) {
 		channel_id = (int) luaL_checknumber(l, 2);
 	}
 
-	packet = enet_peer_receive(peer, &channel_id);
+	bool as_data = read_receive_mode(l, 3);
+
+	{
+		HostLock lock(peer->host);
+		packet = enet_peer_receive(peer, &channel_id);
+	}
 	if (packet == NULL) return 0;
 
-	lua_pushlstring(l, (const char *)packet->data, packet->dataLength);
+	push_packet(l, packet, as_data);
 	lua_pushinteger(l, channel_id);
 
-	enet_packet_destroy(packet);
 	return 2;
 }
 
 
 /**
- * Send a lua string to a peer
+ * Send a lua string or love Data to a peer
  * Args:
- *	packet data, string
+ *	packet data, string or Data
  *	channel id
  *	flags ["reliable", nil]
  *
@@ -801,7 +1328,11 @@ static int peer_send(lua_State *l) {
 	ENetPacket *packet = read_packet(l, 2, &channel_id);
 
 	// printf("sending, channel_id=%d\n", channel_id);
-	int ret = enet_peer_send(peer, channel_id, packet);
+	int ret;
+	{
+		HostLock lock(peer->host);
+		ret = enet_peer_send(peer, channel_id, packet);
+	}
 	if (ret < 0) {
 		enet_packet_destroy(packet);
 	}
@@ -814,6 +1345,7 @@ static int peer_send(lua_State *l) {
 static const struct luaL_Reg enet_funcs [] = {
 	{"host_create", host_create},
 	{"linked_version", linked_version},
+	{"time", get_time},
 	{NULL, NULL}
 };
 
@@ -824,6 +1356,9 @@ static const struct luaL_Reg enet_host_funcs [] = {
 	{"connect", host_connect},
 	{"flush", host_flush},
 	{"broadcast", host_broadcast},
+	{"multicast", host_multicast},
+	{"start_service_thread", host_start_service_thread},
+	{"stop_service_thread", host_stop_service_thread},
 	{"channel_limit", host_channel_limit},
 	{"bandwidth_limit", host_bandwidth_limit},
 	// Since ENetSocket isn't part of enet-lua, we should try to keep
@@ -836,6 +1371,7 @@ static const struct luaL_Reg enet_host_funcs [] = {
 	{"total_sent_data", host_total_sent_data},
 	{"total_received_data", host_total_received_data},
 	{"service_time", host_service_time},
+	{"service_thread_running", host_service_thread_running},
 	{"peer_count", host_peer_count},
 	{"get_peer", host_get_peer},
 	{NULL, NULL}
@@ -862,10 +1398,6 @@ static const struct luaL_Reg enet_peer_funcs [] = {
 	{NULL, NULL}
 };
 
-extern "C" {
-	void luax_register(lua_State *L, const char *name, const luaL_Reg *l);
-}
-
 int luaopen_enet(lua_State *l) {
 	enet_initialize();
 	atexit(enet_deinitialize);
@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "BlockCompressor.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "thread/ThreadPool.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/lz4/lz4hc.h"
+
+#include <zlib.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace love
+{
+namespace data
+{
+
+// The compressed data starts with this header, followed by the block offsets
+// (one uint64 per block plus one for the end of the last block), followed by
+// the compressed blocks. All values are little-endian.
+struct BlockHeader
+{
+	char magic[4];
+	uint8 version;
+	uint8 blockFormat;
+	uint16 reserved;
+	uint32 blockSize;
+	uint32 blockCount;
+	uint64 rawSize;
+};
+
+static_assert(sizeof(BlockHeader) == 24, "BlockHeader must be tightly packed.");
+
+static const char BLOCK_MAGIC[4] = {'L', 'O', 'V', 'B'};
+static const uint8 BLOCK_VERSION = 1;
+
+enum BlockFormat
+{
+	BLOCKFORMAT_LZ4 = 0,
+	BLOCKFORMAT_ZLIB = 1,
+};
+
+static inline uint32 toLE32(uint32 v)
+{
+#ifdef LOVE_BIG_ENDIAN
+	return swapuint32(v);
+#else
+	return v;
+#endif
+}
+
+static inline uint64 toLE64(uint64 v)
+{
+#ifdef LOVE_BIG_ENDIAN
+	return swapuint64(v);
+#else
+	return v;
+#endif
+}
+
+static Compressor::Format getBlockFormat(Compressor::Format format)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_LZ4_BLOCKS:
+		return Compressor::FORMAT_LZ4;
+	case Compressor::FORMAT_ZLIB_BLOCKS:
+		return Compressor::FORMAT_ZLIB;
+	default:
+		throw love::Exception("Invalid format (expecting a block format)");
+	}
+}
+
+static size_t getCompressBound(Compressor::Format blockformat, size_t size)
+{
+	if (blockformat == Compressor::FORMAT_LZ4)
+		return (size_t) LZ4_compressBound((int) size);
+	else
+		return (size_t) compressBound((uLong) size);
+}
+
+static size_t compressBlock(Compressor::Format blockformat, int level, const char *src, size_t srcsize, char *dst, size_t dstcapacity)
+{
+	if (blockformat == Compressor::FORMAT_LZ4)
+	{
+		// Use LZ4-HC for compression level 9 and higher.
+		int csize = 0;
+		if (level > 8)
+			csize = LZ4_compress_HC(src, dst, (int) srcsize, (int) dstcapacity, LZ4HC_CLEVEL_DEFAULT);
+		else
+			csize = LZ4_compress_default(src, dst, (int) srcsize, (int) dstcapacity);
+
+		if (csize <= 0)
+			throw love::Exception("Could not LZ4-compress data.");
+
+		return (size_t) csize;
+	}
+	else
+	{
+		if (level < 0)
+			level = Z_DEFAULT_COMPRESSION;
+		else if (level > 9)
+			level = 9;
+
+		uLongf csize = (uLongf) dstcapacity;
+		int err = compress2((Bytef *) dst, &csize, (const Bytef *) src, (uLong) srcsize, level);
+
+		if (err != Z_OK)
+			throw love::Exception("Could not zlib-compress data (error code: %d).", err);
+
+		return (size_t) csize;
+	}
+}
+
+static void decompressBlockInto(Compressor::Format blockformat, const char *src, size_t srcsize, char *dst, size_t rawsize)
+{
+	if (blockformat == Compressor::FORMAT_LZ4)
+	{
+		int result = LZ4_decompress_safe(src, dst, (int) srcsize, (int) rawsize);
+		if (result < 0 || (size_t) result != rawsize)
+			throw love::Exception("Could not decompress LZ4-compressed data.");
+	}
+	else
+	{
+		uLongf destlen = (uLongf) rawsize;
+		int err = uncompress((Bytef *) dst, &destlen, (const Bytef *) src, (uLong) srcsize);
+
+		if (err != Z_OK || (size_t) destlen != rawsize)
+			throw love::Exception("Could not decompress zlib-compressed data (error code: %d).", err);
+	}
+}
+
+size_t BlockCompressor::BlockIndex::getRawBlockSize(size_t block) const
+{
+	uint64 start = (uint64) block * blockSize;
+	return (size_t) std::min<uint64>(blockSize, rawSize - start);
+}
+
+char *BlockCompressor::compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize)
+{
+	Format blockformat = getBlockFormat(format);
+
+	size_t blockcount = (dataSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	if (blockcount > std::numeric_limits<uint32>::max())
+		throw love::Exception("Data is too large for the block compressor.");
+
+	std::vector<std::vector<char>> blocks(blockcount);
+
+	thread::ThreadPool::getShared().parallelFor(blockcount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t offset = i * BLOCK_SIZE;
+			size_t size = std::min(BLOCK_SIZE, dataSize - offset);
+
+			std::vector<char> &block = blocks[i];
+			block.resize(getCompressBound(blockformat, size));
+
+			size_t csize = compressBlock(blockformat, level, data + offset, size, block.data(), block.size());
+			block.resize(csize);
+		}
+	});
+
+	size_t indexsize = sizeof(uint64) * (blockcount + 1);
+	size_t datastart = sizeof(BlockHeader) + indexsize;
+
+	std::vector<uint64> offsets(blockcount + 1);
+	offsets[0] = 0;
+	for (size_t i = 0; i < blockcount; i++)
+		offsets[i + 1] = offsets[i] + blocks[i].size();
+
+	size_t totalsize = datastart + (size_t) offsets[blockcount];
+	char *compressedbytes = nullptr;
+
+	try
+	{
+		compressedbytes = new char[totalsize];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	BlockHeader header = {};
+	memcpy(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+	header.version = BLOCK_VERSION;
+	header.blockFormat = blockformat == FORMAT_LZ4 ? BLOCKFORMAT_LZ4 : BLOCKFORMAT_ZLIB;
+	header.blockSize = toLE32((uint32) BLOCK_SIZE);
+	header.blockCount = toLE32((uint32) blockcount);
+	header.rawSize = toLE64((uint64) dataSize);
+
+	memcpy(compressedbytes, &header, sizeof(BlockHeader));
+
+	uint64 *index = (uint64 *) (compressedbytes + sizeof(BlockHeader));
+	for (size_t i = 0; i <= blockcount; i++)
+		index[i] = toLE64(offsets[i]);
+
+	thread::ThreadPool::getShared().parallelFor(blockcount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			if (!blocks[i].empty())
+				memcpy(compressedbytes + datastart + offsets[i], blocks[i].data(), blocks[i].size());
+		}
+	});
+
+	compressedSize = totalsize;
+	return compressedbytes;
+}
+
+char *BlockCompressor::decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize)
+{
+	BlockIndex index;
+	readIndex(format, data, dataSize, index);
+
+	size_t datastart = sizeof(BlockHeader) + sizeof(uint64) * index.offsets.size();
+	size_t rawsize = (size_t) index.rawSize;
+	char *rawbytes = nullptr;
+
+	try
+	{
+		rawbytes = new char[std::max<size_t>(rawsize, 1)];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	try
+	{
+		thread::ThreadPool::getShared().parallelFor(index.getBlockCount(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const char *src = data + datastart + index.offsets[i];
+				size_t srcsize = (size_t) (index.offsets[i + 1] - index.offsets[i]);
+
+				decompressBlockInto(index.blockFormat, src, srcsize, rawbytes + i * index.blockSize, index.getRawBlockSize(i));
+			}
+		});
+	}
+	catch (love::Exception &)
+	{
+		delete[] rawbytes;
+		throw;
+	}
+
+	decompressedSize = rawsize;
+	return rawbytes;
+}
+
+bool BlockCompressor::isSupported(Format format) const
+{
+	return isBlockFormat(format);
+}
+
+bool BlockCompressor::isBlockFormat(Format format)
+{
+	return format == FORMAT_LZ4_BLOCKS || format == FORMAT_ZLIB_BLOCKS;
+}
+
+void BlockCompressor::readIndex(Format format, const char *data, size_t dataSize, BlockIndex &index)
+{
+	Format blockformat = getBlockFormat(format);
+
+	if (dataSize < sizeof(BlockHeader))
+		throw love::Exception("Invalid block-compressed data size.");
+
+	BlockHeader header;
+	memcpy(&header, data, sizeof(BlockHeader));
+
+	if (memcmp(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 || header.version != BLOCK_VERSION)
+		throw love::Exception("Invalid block-compressed data.");
+
+	uint8 expectedformat = blockformat == FORMAT_LZ4 ? BLOCKFORMAT_LZ4 : BLOCKFORMAT_ZLIB;
+	if (header.blockFormat != expectedformat)
+		throw love::Exception("Block-compressed data does not match the given format.");
+
+	uint64 blocksize = toLE32(header.blockSize);
+	uint64 blockcount = toLE32(header.blockCount);
+	uint64 rawsize = toLE64(header.rawSize);
+
+	if (blocksize == 0 || blocksize > (uint64) LZ4_MAX_INPUT_SIZE || blockcount != (rawsize + blocksize - 1) / blocksize)
+		throw love::Exception("Invalid block-compressed data.");
+
+	if (rawsize > (uint64) std::numeric_limits<size_t>::max())
+		throw love::Exception("Block-compressed data is too large.");
+
+	uint64 datastart = sizeof(BlockHeader) + sizeof(uint64) * (blockcount + 1);
+	if (datastart > dataSize)
+		throw love::Exception("Invalid block-compressed data size.");
+
+	index.blockFormat = blockformat;
+	index.blockSize = (size_t) blocksize;
+	index.rawSize = rawsize;
+	index.offsets.resize((size_t) blockcount + 1);
+
+	const char *indexdata = data + sizeof(BlockHeader);
+	for (size_t i = 0; i < index.offsets.size(); i++)
+	{
+		uint64 offset = 0;
+		memcpy(&offset, indexdata + i * sizeof(uint64), sizeof(uint64));
+		offset = toLE64(offset);
+
+		if ((i == 0 && offset != 0) || (i > 0 && offset < index.offsets[i - 1]))
+			throw love::Exception("Invalid block-compressed data.");
+
+		index.offsets[i] = offset;
+	}
+
+	if (index.offsets.back() != dataSize - datastart)
+		throw love::Exception("Invalid block-compressed data size.");
+}
+
+char *BlockCompressor::decompressBlock(Format format, const char *data, size_t dataSize, size_t block, size_t &decompressedSize)
+{
+	BlockIndex index;
+	readIndex(format, data, dataSize, index);
+
+	if (block >= index.getBlockCount())
+		throw love::Exception("Invalid block index.");
+
+	size_t datastart = sizeof(BlockHeader) + sizeof(uint64) * index.offsets.size();
+	size_t rawsize = index.getRawBlockSize(block);
+	char *rawbytes = nullptr;
+
+	try
+	{
+		rawbytes = new char[rawsize];
+	}
+	catch (std::bad_alloc &)
+	{
+		throw love::Exception("Out of memory.");
+	}
+
+	try
+	{
+		const char *src = data + datastart + index.offsets[block];
+		size_t srcsize = (size_t) (index.offsets[block + 1] - index.offsets[block]);
+
+		decompressBlockInto(index.blockFormat, src, srcsize, rawbytes, rawsize);
+	}
+	catch (love::Exception &)
+	{
+		delete[] rawbytes;
+		throw;
+	}
+
+	decompressedSize = rawsize;
+	return rawbytes;
+}
+
+} // data
+} // love
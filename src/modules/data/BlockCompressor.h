@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Compresses large buffers as independent fixed-size blocks, using LZ4 or zlib
+ * for each block. Blocks are compressed and decompressed in parallel, and the
+ * output starts with an index of block offsets so single blocks can be
+ * decompressed without touching the rest of the data.
+ **/
+class BlockCompressor : public Compressor
+{
+public:
+
+	// The uncompressed size of every block except the last.
+	static const size_t BLOCK_SIZE = 1024 * 1024;
+
+	struct BlockIndex
+	{
+		Format blockFormat;
+		size_t blockSize;
+		uint64 rawSize;
+
+		// Offset of each block (plus the end of the last block) in the
+		// compressed data.
+		std::vector<uint64> offsets;
+
+		size_t getBlockCount() const { return offsets.size() - 1; }
+		size_t getRawBlockSize(size_t block) const;
+	};
+
+	BlockCompressor() {}
+	virtual ~BlockCompressor() {}
+
+	char *compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize) override;
+	char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) override;
+	bool isSupported(Format format) const override;
+
+	static bool isBlockFormat(Format format);
+
+	/**
+	 * Reads the block index at the start of data compressed with a block
+	 * format. Throws an exception if the data is not valid.
+	 **/
+	static void readIndex(Format format, const char *data, size_t dataSize, BlockIndex &index);
+
+	/**
+	 * Decompresses a single block of data compressed with a block format.
+	 *
+	 * @param[in] block The zero-based index of the block to decompress.
+	 * @param[out] decompressedSize The size in bytes of the decompressed block.
+	 *
+	 * @return The decompressed block (allocated with new[]).
+	 **/
+	static char *decompressBlock(Format format, const char *data, size_t dataSize, size_t block, size_t &decompressedSize);
+
+}; // BlockCompressor
+
+} // data
+} // love
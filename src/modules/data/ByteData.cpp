@@ -33,6 +33,8 @@ love::Type ByteData::type("ByteData", &Data::type);
 
 ByteData::ByteData(size_t size, bool clear)
 	: size(size)
+	, deleter(nullptr)
+	, deleterContext(nullptr)
 {
 	create();
 	if (clear)
@@ -41,6 +43,8 @@ ByteData::ByteData(size_t size, bool clear)
 
 ByteData::ByteData(const void *d, size_t size)
 	: size(size)
+	, deleter(nullptr)
+	, deleterContext(nullptr)
 {
 	create();
 	if (d != nullptr)
@@ -49,6 +53,8 @@ ByteData::ByteData(const void *d, size_t size)
 
 ByteData::ByteData(void *d, size_t size, bool own)
 	: size(size)
+	, deleter(nullptr)
+	, deleterContext(nullptr)
 {
 	if (own)
 		data = (char *) d;
@@ -60,8 +66,18 @@ ByteData::ByteData(void *d, size_t size, bool own)
 	}
 }
 
+ByteData::ByteData(void *d, size_t size, Deleter deleter, void *context)
+	: data((char *) d)
+	, size(size)
+	, deleter(deleter)
+	, deleterContext(context)
+{
+}
+
 ByteData::ByteData(const ByteData &d)
 	: size(d.size)
+	, deleter(nullptr)
+	, deleterContext(nullptr)
 {
 	create();
 	memcpy(data, d.data, size);
@@ -69,7 +85,10 @@ ByteData::ByteData(const ByteData &d)
 
 ByteData::~ByteData()
 {
-	delete[] data;
+	if (deleter != nullptr)
+		deleter(data, deleterContext);
+	else
+		delete[] data;
 }
 
 void ByteData::create()
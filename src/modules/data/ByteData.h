@@ -35,9 +35,18 @@ class ByteData : public love::Data
 
 	static love::Type type;
 
+	typedef void (*Deleter)(void *data, void *context);
+
 	ByteData(size_t size, bool clear = true);
 	ByteData(const void *d, size_t size);
 	ByteData(void *d, size_t size, bool own);
+
+	/**
+	 * Uses memory owned by something else, without copying it. The deleter is
+	 * called with the memory and the given context when the ByteData is
+	 * destroyed.
+	 **/
+	ByteData(void *d, size_t size, Deleter deleter, void *context);
 	ByteData(const ByteData &d);
 	virtual ~ByteData();
 
@@ -53,6 +62,9 @@ class ByteData : public love::Data
 	char *data;
 	size_t size;
 
+	Deleter deleter;
+	void *deleterContext;
+
 }; // ByteData
 
 } // data
@@ -0,0 +1,695 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "CompressionStream.h"
+#include "common/Exception.h"
+
+#include "libraries/lz4/lz4.h"
+#include "libraries/lz4/lz4hc.h"
+#include "libraries/xxHash/xxhash.h"
+
+#include <zlib.h>
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace data
+{
+
+// Output is produced in pieces of this size.
+static const size_t OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+static void appendLE32(std::vector<char> &output, uint32 v)
+{
+	char bytes[4] = {(char) (v & 0xFF), (char) ((v >> 8) & 0xFF), (char) ((v >> 16) & 0xFF), (char) ((v >> 24) & 0xFF)};
+	output.insert(output.end(), bytes, bytes + 4);
+}
+
+static uint32 readLE32(const uint8 *p)
+{
+	return (uint32) p[0] | ((uint32) p[1] << 8) | ((uint32) p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+static uint64 readLE64(const uint8 *p)
+{
+	return (uint64) readLE32(p) | ((uint64) readLE32(p + 4) << 32);
+}
+
+class zlibCompressionStream final : public CompressionStream
+{
+public:
+
+	zlibCompressionStream(Compressor::Format format, Mode mode, int level)
+		: CompressionStream(format, mode)
+		, stream()
+	{
+		int err = Z_OK;
+
+		if (mode == MODE_COMPRESS)
+		{
+			if (level < 0)
+				level = Z_DEFAULT_COMPRESSION;
+			else if (level > 9)
+				level = 9;
+
+			int windowbits = 15;
+			if (format == Compressor::FORMAT_GZIP)
+				windowbits += 16; // This tells zlib to use a gzip header.
+			else if (format == Compressor::FORMAT_DEFLATE)
+				windowbits = -windowbits;
+
+			err = deflateInit2(&stream, level, Z_DEFLATED, windowbits, 8, Z_DEFAULT_STRATEGY);
+		}
+		else
+		{
+			// 15 is the default. Adding 32 makes zlib auto-detect the header type.
+			int windowbits = 15 + 32;
+			if (format == Compressor::FORMAT_DEFLATE)
+				windowbits = -15;
+
+			err = inflateInit2(&stream, windowbits);
+		}
+
+		if (err != Z_OK)
+			throw love::Exception("Could not create zlib stream (error code: %d).", err);
+	}
+
+	virtual ~zlibCompressionStream()
+	{
+		if (mode == MODE_COMPRESS)
+			deflateEnd(&stream);
+		else
+			inflateEnd(&stream);
+	}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (finished)
+		{
+			if (size > 0)
+				throw love::Exception("Cannot process more data after the end of the stream.");
+			return;
+		}
+
+		size_t outstart = output.size();
+
+		// zlib's sizes are 32 bits, so large chunks are fed in pieces.
+		const size_t maxpiece = 1 << 30;
+
+		do
+		{
+			size_t piece = std::min(size, maxpiece);
+
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = (uInt) piece;
+
+			bool last = finish && piece == size;
+
+			if (mode == MODE_COMPRESS)
+				deflatePiece(last, output);
+			else
+				inflatePiece(output);
+
+			data += piece;
+			size -= piece;
+			totalIn += (int64) piece;
+		}
+		while (size > 0);
+
+		totalOut += (int64) (output.size() - outstart);
+
+		if (finish && !finished)
+			throw love::Exception("Compressed data is incomplete.");
+	}
+
+private:
+
+	void deflatePiece(bool last, std::vector<char> &output)
+	{
+		int flush = last ? Z_FINISH : Z_NO_FLUSH;
+
+		while (true)
+		{
+			size_t offset = output.size();
+			output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+			stream.next_out = (Bytef *) output.data() + offset;
+			stream.avail_out = (uInt) OUTPUT_CHUNK_SIZE;
+
+			int err = deflate(&stream, flush);
+
+			output.resize(output.size() - stream.avail_out);
+
+			if (err == Z_STREAM_END)
+			{
+				finished = true;
+				break;
+			}
+			else if (err != Z_OK && err != Z_BUF_ERROR)
+				throw love::Exception("Could not zlib/gzip-compress data (error code: %d).", err);
+
+			if (flush != Z_FINISH && stream.avail_in == 0 && stream.avail_out > 0)
+				break;
+		}
+	}
+
+	void inflatePiece(std::vector<char> &output)
+	{
+		while (true)
+		{
+			size_t offset = output.size();
+			output.resize(offset + OUTPUT_CHUNK_SIZE);
+
+			stream.next_out = (Bytef *) output.data() + offset;
+			stream.avail_out = (uInt) OUTPUT_CHUNK_SIZE;
+
+			int err = inflate(&stream, Z_NO_FLUSH);
+
+			output.resize(output.size() - stream.avail_out);
+
+			if (err == Z_STREAM_END)
+			{
+				finished = true;
+				break;
+			}
+			else if (err == Z_BUF_ERROR)
+			{
+				// No progress is possible until more input arrives.
+				break;
+			}
+			else if (err != Z_OK)
+				throw love::Exception("Could not decompress zlib/gzip-compressed data (error code: %d).", err);
+
+			if (stream.avail_in == 0 && stream.avail_out > 0)
+				break;
+		}
+
+		if (finished && stream.avail_in > 0)
+			throw love::Exception("Unexpected data after the end of the compressed stream.");
+	}
+
+	z_stream stream;
+
+}; // zlibCompressionStream
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md
+static const uint32 LZ4_FRAME_MAGIC = 0x184D2204;
+static const uint32 LZ4_SKIPPABLE_MAGIC = 0x184D2A50;
+static const uint32 LZ4_BLOCK_UNCOMPRESSED_BIT = 0x80000000;
+
+enum LZ4FrameFlags
+{
+	LZ4FRAME_FLAG_DICTIONARY_ID = 1 << 0,
+	LZ4FRAME_FLAG_CONTENT_CHECKSUM = 1 << 2,
+	LZ4FRAME_FLAG_CONTENT_SIZE = 1 << 3,
+	LZ4FRAME_FLAG_BLOCK_CHECKSUM = 1 << 4,
+	LZ4FRAME_FLAG_BLOCK_INDEPENDENT = 1 << 5,
+	LZ4FRAME_FLAG_VERSION = 1 << 6,
+};
+
+class LZ4FrameCompressionStream final : public CompressionStream
+{
+public:
+
+	// Block maximum size ID 4, the smallest.
+	static const size_t BLOCK_SIZE = 64 * 1024;
+	static const uint8 BLOCK_SIZE_ID = 4;
+
+	LZ4FrameCompressionStream(int level)
+		: CompressionStream(Compressor::FORMAT_LZ4_FRAME, MODE_COMPRESS)
+		, level(level)
+		, headerWritten(false)
+		, checksum(XXH32_createState())
+	{
+		if (checksum == nullptr)
+			throw love::Exception("Out of memory.");
+
+		XXH32_reset(checksum, 0);
+
+		block.reserve(BLOCK_SIZE);
+		compressedBlock.resize(LZ4_compressBound((int) BLOCK_SIZE));
+	}
+
+	virtual ~LZ4FrameCompressionStream()
+	{
+		XXH32_freeState(checksum);
+	}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (finished)
+		{
+			if (size > 0)
+				throw love::Exception("Cannot process more data after the end of the stream.");
+			return;
+		}
+
+		size_t outstart = output.size();
+
+		if (!headerWritten)
+			writeHeader(output);
+
+		XXH32_update(checksum, data, size);
+		totalIn += (int64) size;
+
+		while (size > 0)
+		{
+			size_t piece = std::min(size, BLOCK_SIZE - block.size());
+			block.insert(block.end(), data, data + piece);
+
+			data += piece;
+			size -= piece;
+
+			if (block.size() == BLOCK_SIZE)
+				writeBlock(output);
+		}
+
+		if (finish)
+		{
+			if (!block.empty())
+				writeBlock(output);
+
+			// End mark, followed by the content checksum.
+			appendLE32(output, 0);
+			appendLE32(output, XXH32_digest(checksum));
+
+			finished = true;
+		}
+
+		totalOut += (int64) (output.size() - outstart);
+	}
+
+private:
+
+	void writeHeader(std::vector<char> &output)
+	{
+		appendLE32(output, LZ4_FRAME_MAGIC);
+
+		uint8 descriptor[2] = {
+			LZ4FRAME_FLAG_VERSION | LZ4FRAME_FLAG_BLOCK_INDEPENDENT | LZ4FRAME_FLAG_CONTENT_CHECKSUM,
+			(uint8) (BLOCK_SIZE_ID << 4),
+		};
+
+		uint8 headerchecksum = (uint8) ((XXH32(descriptor, sizeof(descriptor), 0) >> 8) & 0xFF);
+
+		output.push_back((char) descriptor[0]);
+		output.push_back((char) descriptor[1]);
+		output.push_back((char) headerchecksum);
+
+		headerWritten = true;
+	}
+
+	void writeBlock(std::vector<char> &output)
+	{
+		int srcsize = (int) block.size();
+		int dstcapacity = (int) compressedBlock.size();
+
+		// Use LZ4-HC for compression level 9 and higher, like love.data.compress.
+		int csize = 0;
+		if (level > 8)
+			csize = LZ4_compress_HC(block.data(), compressedBlock.data(), srcsize, dstcapacity, LZ4HC_CLEVEL_DEFAULT);
+		else
+			csize = LZ4_compress_default(block.data(), compressedBlock.data(), srcsize, dstcapacity);
+
+		// Blocks which don't shrink are stored as-is.
+		if (csize > 0 && csize < srcsize)
+		{
+			appendLE32(output, (uint32) csize);
+			output.insert(output.end(), compressedBlock.data(), compressedBlock.data() + csize);
+		}
+		else
+		{
+			appendLE32(output, (uint32) srcsize | LZ4_BLOCK_UNCOMPRESSED_BIT);
+			output.insert(output.end(), block.begin(), block.end());
+		}
+
+		block.clear();
+	}
+
+	int level;
+	bool headerWritten;
+
+	std::vector<char> block;
+	std::vector<char> compressedBlock;
+
+	XXH32_state_t *checksum;
+
+}; // LZ4FrameCompressionStream
+
+class LZ4FrameDecompressionStream final : public CompressionStream
+{
+public:
+
+	LZ4FrameDecompressionStream()
+		: CompressionStream(Compressor::FORMAT_LZ4_FRAME, MODE_DECOMPRESS)
+		, state(STATE_MAGIC)
+		, flags(0)
+		, blockMaxSize(0)
+		, blockSize(0)
+		, blockUncompressed(false)
+		, contentSize(0)
+		, frameSize(0)
+		, skipRemaining(0)
+		, checksum(XXH32_createState())
+	{
+		if (checksum == nullptr)
+			throw love::Exception("Out of memory.");
+	}
+
+	virtual ~LZ4FrameDecompressionStream()
+	{
+		XXH32_freeState(checksum);
+	}
+
+	void process(const char *data, size_t size, bool finish, std::vector<char> &output) override
+	{
+		if (finished)
+		{
+			if (size > 0)
+				throw love::Exception("Cannot process more data after the end of the stream.");
+			return;
+		}
+
+		size_t outstart = output.size();
+
+		pending.insert(pending.end(), data, data + size);
+		totalIn += (int64) size;
+
+		size_t offset = 0;
+		while (parse(offset, output))
+		{
+			if (finished)
+				break;
+		}
+
+		pending.erase(pending.begin(), pending.begin() + offset);
+
+		totalOut += (int64) (output.size() - outstart);
+
+		if (finished && !pending.empty())
+			throw love::Exception("Unexpected data after the end of the compressed stream.");
+
+		if (finish && !finished)
+			throw love::Exception("Compressed data is incomplete.");
+	}
+
+private:
+
+	enum State
+	{
+		STATE_MAGIC,
+		STATE_SKIP,
+		STATE_HEADER,
+		STATE_BLOCK_SIZE,
+		STATE_BLOCK,
+		STATE_CHECKSUM,
+	};
+
+	// Parses the next part of the frame from pending data. Returns false if
+	// more data is needed.
+	bool parse(size_t &offset, std::vector<char> &output)
+	{
+		size_t available = pending.size() - offset;
+		const uint8 *p = (const uint8 *) pending.data() + offset;
+
+		switch (state)
+		{
+		case STATE_MAGIC:
+		{
+			if (available < 8)
+				return false;
+
+			uint32 magic = readLE32(p);
+
+			if ((magic & 0xFFFFFFF0) == LZ4_SKIPPABLE_MAGIC)
+			{
+				skipRemaining = readLE32(p + 4);
+				offset += 8;
+				state = STATE_SKIP;
+			}
+			else if (magic == LZ4_FRAME_MAGIC)
+			{
+				offset += 4;
+				state = STATE_HEADER;
+			}
+			else
+				throw love::Exception("Invalid LZ4 frame data.");
+
+			return true;
+		}
+		case STATE_SKIP:
+		{
+			size_t skip = (size_t) std::min<uint64>(available, skipRemaining);
+			offset += skip;
+			skipRemaining -= skip;
+
+			if (skipRemaining > 0)
+				return false;
+
+			state = STATE_MAGIC;
+			return true;
+		}
+		case STATE_HEADER:
+		{
+			if (available < 2)
+				return false;
+
+			uint8 flg = p[0];
+			uint8 bd = p[1];
+
+			if ((flg >> 6) != 1)
+				throw love::Exception("Unsupported LZ4 frame version.");
+
+			if (flg & LZ4FRAME_FLAG_DICTIONARY_ID)
+				throw love::Exception("LZ4 frames with dictionaries are not supported.");
+
+			size_t headersize = 2 + ((flg & LZ4FRAME_FLAG_CONTENT_SIZE) ? 8 : 0) + 1;
+			if (available < headersize)
+				return false;
+
+			uint8 headerchecksum = (uint8) ((XXH32(p, headersize - 1, 0) >> 8) & 0xFF);
+			if (headerchecksum != p[headersize - 1])
+				throw love::Exception("Invalid LZ4 frame header checksum.");
+
+			switch ((bd >> 4) & 0x7)
+			{
+			case 4: blockMaxSize = 64 * 1024; break;
+			case 5: blockMaxSize = 256 * 1024; break;
+			case 6: blockMaxSize = 1024 * 1024; break;
+			case 7: blockMaxSize = 4 * 1024 * 1024; break;
+			default:
+				throw love::Exception("Invalid LZ4 frame block size.");
+			}
+
+			flags = flg;
+			contentSize = (flg & LZ4FRAME_FLAG_CONTENT_SIZE) ? readLE64(p + 2) : 0;
+			frameSize = 0;
+
+			XXH32_reset(checksum, 0);
+			history.clear();
+			decodedBlock.resize(blockMaxSize);
+
+			offset += headersize;
+			state = STATE_BLOCK_SIZE;
+			return true;
+		}
+		case STATE_BLOCK_SIZE:
+		{
+			if (available < 4)
+				return false;
+
+			uint32 v = readLE32(p);
+			offset += 4;
+
+			if (v == 0)
+			{
+				if (flags & LZ4FRAME_FLAG_CONTENT_CHECKSUM)
+					state = STATE_CHECKSUM;
+				else
+					endFrame();
+				return true;
+			}
+
+			blockSize = v & ~LZ4_BLOCK_UNCOMPRESSED_BIT;
+			blockUncompressed = (v & LZ4_BLOCK_UNCOMPRESSED_BIT) != 0;
+
+			if (blockSize > blockMaxSize)
+				throw love::Exception("Invalid LZ4 frame block size.");
+
+			state = STATE_BLOCK;
+			return true;
+		}
+		case STATE_BLOCK:
+		{
+			size_t checksumsize = (flags & LZ4FRAME_FLAG_BLOCK_CHECKSUM) ? 4 : 0;
+			if (available < blockSize + checksumsize)
+				return false;
+
+			if (checksumsize > 0 && XXH32(p, blockSize, 0) != readLE32(p + blockSize))
+				throw love::Exception("Invalid LZ4 frame block checksum.");
+
+			if (blockUncompressed)
+				emit((const char *) p, blockSize, output);
+			else
+			{
+				int result = 0;
+
+				// Linked blocks can refer to the previous 64 KB of output.
+				if ((flags & LZ4FRAME_FLAG_BLOCK_INDEPENDENT) || history.empty())
+					result = LZ4_decompress_safe((const char *) p, decodedBlock.data(), (int) blockSize, (int) blockMaxSize);
+				else
+					result = LZ4_decompress_safe_usingDict((const char *) p, decodedBlock.data(), (int) blockSize, (int) blockMaxSize, history.data(), (int) history.size());
+
+				if (result < 0)
+					throw love::Exception("Could not decompress LZ4-compressed data.");
+
+				emit(decodedBlock.data(), (size_t) result, output);
+			}
+
+			offset += blockSize + checksumsize;
+			state = STATE_BLOCK_SIZE;
+			return true;
+		}
+		case STATE_CHECKSUM:
+		{
+			if (available < 4)
+				return false;
+
+			if (XXH32_digest(checksum) != readLE32(p))
+				throw love::Exception("Invalid LZ4 frame content checksum.");
+
+			offset += 4;
+			endFrame();
+			return true;
+		}
+		}
+
+		return false;
+	}
+
+	void emit(const char *data, size_t size, std::vector<char> &output)
+	{
+		output.insert(output.end(), data, data + size);
+
+		XXH32_update(checksum, data, size);
+		frameSize += size;
+
+		if (!(flags & LZ4FRAME_FLAG_BLOCK_INDEPENDENT))
+		{
+			const size_t maxhistory = 64 * 1024;
+
+			if (size >= maxhistory)
+				history.assign(data + size - maxhistory, data + size);
+			else
+			{
+				history.insert(history.end(), data, data + size);
+				if (history.size() > maxhistory)
+					history.erase(history.begin(), history.begin() + (history.size() - maxhistory));
+			}
+		}
+	}
+
+	void endFrame()
+	{
+		if ((flags & LZ4FRAME_FLAG_CONTENT_SIZE) && frameSize != contentSize)
+			throw love::Exception("LZ4 frame content size doesn't match its header.");
+
+		state = STATE_MAGIC;
+		finished = true;
+	}
+
+	State state;
+
+	uint8 flags;
+	size_t blockMaxSize;
+	size_t blockSize;
+	bool blockUncompressed;
+
+	uint64 contentSize;
+	uint64 frameSize;
+	uint64 skipRemaining;
+
+	std::vector<char> pending;
+	std::vector<char> decodedBlock;
+	std::vector<char> history;
+
+	XXH32_state_t *checksum;
+
+}; // LZ4FrameDecompressionStream
+
+love::Type CompressionStream::type("CompressionStream", &Object::type);
+
+CompressionStream::CompressionStream(Compressor::Format format, Mode mode)
+	: format(format)
+	, mode(mode)
+	, finished(false)
+	, totalIn(0)
+	, totalOut(0)
+{
+}
+
+CompressionStream *CompressionStream::create(Compressor::Format format, Mode mode, int level)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+		return new zlibCompressionStream(format, mode, level);
+	case Compressor::FORMAT_LZ4_FRAME:
+		if (mode == MODE_COMPRESS)
+			return new LZ4FrameCompressionStream(level);
+		else
+			return new LZ4FrameDecompressionStream();
+	default:
+		break;
+	}
+
+	const char *name = "unknown";
+	Compressor::getConstant(format, name);
+	throw love::Exception("The %s compression format does not support streaming.", name);
+}
+
+bool CompressionStream::isFormatSupported(Compressor::Format format)
+{
+	switch (format)
+	{
+	case Compressor::FORMAT_ZLIB:
+	case Compressor::FORMAT_GZIP:
+	case Compressor::FORMAT_DEFLATE:
+	case Compressor::FORMAT_LZ4_FRAME:
+		return true;
+	default:
+		return false;
+	}
+}
+
+STRINGMAP_CLASS_BEGIN(CompressionStream, CompressionStream::Mode, CompressionStream::MODE_MAX_ENUM, mode)
+{
+	{ "compress",   CompressionStream::MODE_COMPRESS   },
+	{ "decompress", CompressionStream::MODE_DECOMPRESS },
+}
+STRINGMAP_CLASS_END(CompressionStream, CompressionStream::Mode, CompressionStream::MODE_MAX_ENUM, mode)
+
+} // data
+} // love
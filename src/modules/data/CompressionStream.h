@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/StringMap.h"
+#include "common/int.h"
+#include "Compressor.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace data
+{
+
+/**
+ * Incrementally compresses or decompresses data which arrives in chunks, so
+ * the whole input and output never need to be in memory at once.
+ **/
+class CompressionStream : public Object
+{
+public:
+
+	static love::Type type;
+
+	enum Mode
+	{
+		MODE_COMPRESS,
+		MODE_DECOMPRESS,
+		MODE_MAX_ENUM
+	};
+
+	/**
+	 * Creates a stream for the given format. Throws an exception if the format
+	 * can't be streamed.
+	 *
+	 * @param format The compression format to use.
+	 * @param mode Whether the stream compresses or decompresses its input.
+	 * @param level The amount of compression to apply (between 0 and 9.)
+	 *              A value of -1 indicates the default amount of compression.
+	 *              Ignored when decompressing.
+	 **/
+	static CompressionStream *create(Compressor::Format format, Mode mode, int level = -1);
+
+	static bool isFormatSupported(Compressor::Format format);
+
+	virtual ~CompressionStream() {}
+
+	/**
+	 * Processes a chunk of input, and appends any output it produced.
+	 *
+	 * @param[in] data The next chunk of input.
+	 * @param[in] size The size in bytes of the chunk.
+	 * @param[in] finish Whether this is the last chunk. Compressing streams
+	 *            flush all remaining output, and decompressing streams check
+	 *            that the compressed data is complete.
+	 * @param[out] output The vector the produced output is appended to.
+	 **/
+	virtual void process(const char *data, size_t size, bool finish, std::vector<char> &output) = 0;
+
+	/**
+	 * Gets whether the end of the stream has been reached. No more input can be
+	 * processed afterwards.
+	 **/
+	bool isFinished() const { return finished; }
+
+	Compressor::Format getFormat() const { return format; }
+	Mode getMode() const { return mode; }
+
+	int64 getTotalIn() const { return totalIn; }
+	int64 getTotalOut() const { return totalOut; }
+
+	STRINGMAP_CLASS_DECLARE(Mode);
+
+protected:
+
+	CompressionStream(Compressor::Format format, Mode mode);
+
+	Compressor::Format format;
+	Mode mode;
+
+	bool finished;
+
+	int64 totalIn;
+	int64 totalOut;
+
+}; // CompressionStream
+
+} // data
+} // love
@@ -20,6 +20,8 @@
 
 // LOVE
 #include "Compressor.h"
+#include "BlockCompressor.h"
+#include "CompressionStream.h"
 #include "common/config.h"
 #include "common/int.h"
 #include "common/Exception.h"
@@ -29,6 +31,10 @@
 
 #include <zlib.h>
 
+// C++
+#include <algorithm>
+#include <cstring>
+
 namespace love
 {
 namespace data
@@ -359,12 +365,76 @@ class zlibCompressor : public Compressor
 
 }; // zlibCompressor
 
+/**
+ * The standard LZ4 frame format, which unlike FORMAT_LZ4 can be read by other
+ * LZ4 tools and processed incrementally. One-shot compression goes through a
+ * CompressionStream.
+ **/
+class LZ4FrameCompressor : public Compressor
+{
+public:
+
+	char *compress(Format format, const char *data, size_t dataSize, int level, size_t &compressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		return process(format, CompressionStream::MODE_COMPRESS, data, dataSize, level, compressedSize);
+	}
+
+	char *decompress(Format format, const char *data, size_t dataSize, size_t &decompressedSize) override
+	{
+		if (format != FORMAT_LZ4_FRAME)
+			throw love::Exception("Invalid format (expecting LZ4 frame)");
+
+		return process(format, CompressionStream::MODE_DECOMPRESS, data, dataSize, -1, decompressedSize);
+	}
+
+	bool isSupported(Format format) const override
+	{
+		return format == FORMAT_LZ4_FRAME;
+	}
+
+private:
+
+	char *process(Format format, CompressionStream::Mode mode, const char *data, size_t dataSize, int level, size_t &outSize)
+	{
+		StrongRef<CompressionStream> stream(CompressionStream::create(format, mode, level), Acquire::NORETAIN);
+
+		std::vector<char> output;
+		if (mode == CompressionStream::MODE_DECOMPRESS && outSize > 0)
+			output.reserve(outSize);
+
+		stream->process(data, dataSize, true, output);
+
+		char *bytes = nullptr;
+
+		try
+		{
+			bytes = new char[std::max<size_t>(output.size(), 1)];
+		}
+		catch (std::bad_alloc &)
+		{
+			throw love::Exception("Out of memory.");
+		}
+
+		if (!output.empty())
+			memcpy(bytes, output.data(), output.size());
+
+		outSize = output.size();
+		return bytes;
+	}
+
+}; // LZ4FrameCompressor
+
 Compressor *Compressor::getCompressor(Format format)
 {
 	static LZ4Compressor lz4compressor;
 	static zlibCompressor zlibcompressor;
+	static LZ4FrameCompressor lz4framecompressor;
+	static BlockCompressor blockcompressor;
 
-	Compressor *compressors[] = {&lz4compressor, &zlibcompressor};
+	Compressor *compressors[] = {&lz4compressor, &zlibcompressor, &lz4framecompressor, &blockcompressor};
 
 	for (Compressor *c : compressors)
 	{
@@ -392,10 +462,13 @@ std::vector<std::string> Compressor::getConstants(Format)
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM>::Entry Compressor::formatEntries[] =
 {
-	{ "lz4",     FORMAT_LZ4     },
-	{ "zlib",    FORMAT_ZLIB    },
-	{ "gzip",    FORMAT_GZIP    },
-	{ "deflate", FORMAT_DEFLATE },
+	{ "lz4",        FORMAT_LZ4         },
+	{ "zlib",       FORMAT_ZLIB        },
+	{ "gzip",       FORMAT_GZIP        },
+	{ "deflate",    FORMAT_DEFLATE     },
+	{ "lz4frame",   FORMAT_LZ4_FRAME   },
+	{ "lz4blocks",  FORMAT_LZ4_BLOCKS  },
+	{ "zlibblocks", FORMAT_ZLIB_BLOCKS },
 };
 
 StringMap<Compressor::Format, Compressor::FORMAT_MAX_ENUM> Compressor::formatNames(Compressor::formatEntries, sizeof(Compressor::formatEntries));
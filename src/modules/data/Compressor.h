@@ -41,6 +41,9 @@ class Compressor
 		FORMAT_ZLIB,
 		FORMAT_GZIP,
 		FORMAT_DEFLATE,
+		FORMAT_LZ4_FRAME,
+		FORMAT_LZ4_BLOCKS,
+		FORMAT_ZLIB_BLOCKS,
 		FORMAT_MAX_ENUM
 	};
 
@@ -19,11 +19,29 @@
  **/
 
 #include "HashFunction.h"
+#include "common/config.h"
 #include "common/Exception.h"
 
-// FIXME: Probably trivial by having tole and tobe functions, which can be ifdeffed to being identity functions
-#ifdef LOVE_BIG_ENDIAN
-#	error Hashing not yet implemented for big endian
+#include "libraries/xxHash/xxhash.h"
+
+// C++
+#include <algorithm>
+#include <memory>
+
+// CRC32C has dedicated instructions on x86 with SSE 4.2 and on ARMv8. On x86
+// they're picked at runtime, so builds which don't target SSE 4.2 use them too.
+#if defined(LOVE_SIMD_SSE) && (defined(__GNUC__) || defined(_MSC_VER))
+#define LOVE_CRC32C_SSE42
+#include <nmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LOVE_CRC32C_SSE42_TARGET
+#else
+#define LOVE_CRC32C_SSE42_TARGET __attribute__((target("sse4.2")))
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#define LOVE_CRC32C_ARM
+#include <arm_acle.h>
 #endif
 
 namespace love
@@ -51,120 +69,228 @@ inline uint64 rightrot(uint64 x, uint8 amount)
 	return (x >> amount) | (x << (64 - amount));
 }
 
-// Extend the value of `a` to make it a multiple of `n`.
-inline uint64 extend_multiple(uint64 a, uint64 n)
+inline uint32 loadLE32(const uint8 *p)
+{
+	return (uint32) p[0] | ((uint32) p[1] << 8) | ((uint32) p[2] << 16) | ((uint32) p[3] << 24);
+}
+
+inline uint32 loadBE32(const uint8 *p)
+{
+	return ((uint32) p[0] << 24) | ((uint32) p[1] << 16) | ((uint32) p[2] << 8) | (uint32) p[3];
+}
+
+inline uint64 loadBE64(const uint8 *p)
+{
+	return ((uint64) loadBE32(p) << 32) | (uint64) loadBE32(p + 4);
+}
+
+inline void storeLE32(char *p, uint32 x)
+{
+	for (int i = 0; i < 4; i++)
+		p[i] = (x >> (i * 8)) & 0xFF;
+}
+
+inline void storeBE32(char *p, uint32 x)
+{
+	for (int i = 0; i < 4; i++)
+		p[i] = (x >> (24 - i * 8)) & 0xFF;
+}
+
+inline void storeBE64(char *p, uint64 x)
 {
-	uint64 r = a % n;
-	return r == 0 ? a : a + (n-r);
+	for (int i = 0; i < 8; i++)
+		p[i] = (x >> (56 - i * 8)) & 0xFF;
 }
 
 /**
- * The following implementation is based on the pseudocode provided by multiple
- * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
- * The pseudocode is licensed under the CC-BY-SA license, but no authorship
- * information is present. I believe this note, and the zlib license of this
- * project satisfy the conditions of the license.
+ * MD5 and the SHA family all process fixed-size blocks, and pad the final block
+ * with a 1 bit, zeroes, and the total length in bits. This buffers input until
+ * a full block is available, so the input never needs to be copied as a whole.
  **/
-class MD5 : public HashFunction
+template <size_t BLOCK_SIZE, bool BIG_ENDIAN_LENGTH>
+class BlockState : public HashFunction::State
 {
-private:
-	static const uint8 shifts[64];
-	static const uint32 constants[64];
-
 public:
-	bool isSupported(Function function) const override
+
+	BlockState()
+		: buffered(0)
+		, length(0)
 	{
-		return function == FUNCTION_MD5;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	void update(const char *input, uint64 size) override
 	{
-		if (function != FUNCTION_MD5)
-			throw love::Exception("Hash function not supported by MD5 implementation");
+		const uint8 *bytes = (const uint8 *) input;
+		length += size;
+
+		if (buffered > 0)
+		{
+			size_t count = (size_t) std::min<uint64>(size, BLOCK_SIZE - buffered);
+			memcpy(buffer + buffered, bytes, count);
+
+			buffered += count;
+			bytes += count;
+			size -= count;
+
+			if (buffered < BLOCK_SIZE)
+				return;
 
-		uint32 a0 = 0x67452301;
-		uint32 b0 = 0xefcdab89;
-		uint32 c0 = 0x98badcfe;
-		uint32 d0 = 0x10325476;
+			processBlock(buffer);
+			buffered = 0;
+		}
+
+		for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE, bytes += BLOCK_SIZE)
+			processBlock(bytes);
+
+		if (size > 0)
+		{
+			memcpy(buffer, bytes, (size_t) size);
+			buffered = (size_t) size;
+		}
+	}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+	void finish(HashFunction::Value &output) override
+	{
+		// The length takes up 8 bytes of 64 byte blocks, and 16 bytes of 128
+		// byte blocks. We only ever write the low 8 bytes.
+		const size_t lengthsize = BLOCK_SIZE / 8;
+		uint64 bitlength = length * 8;
+
+		buffer[buffered++] = 0x80; // append bit
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
+		if (buffered > BLOCK_SIZE - lengthsize)
+		{
+			memset(buffer + buffered, 0, BLOCK_SIZE - buffered);
+			processBlock(buffer);
+			buffered = 0;
+		}
 
-		// Append length in bits
-		uint64 bit_length = length * 8;
-		memcpy(((uint8*)padded) + paddedLength - 8, &bit_length, 8);
+		memset(buffer + buffered, 0, BLOCK_SIZE - buffered);
 
-		// Process chunks
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		for (int i = 0; i < 8; i++)
 		{
-			uint32 *chunk = &padded[i];
+			uint8 b = (bitlength >> (i * 8)) & 0xFF;
+			if (BIG_ENDIAN_LENGTH)
+				buffer[BLOCK_SIZE - 1 - i] = b;
+			else
+				buffer[BLOCK_SIZE - lengthsize + i] = b;
+		}
 
-			uint32 A = a0;
-			uint32 B = b0;
-			uint32 C = c0;
-			uint32 D = d0;
-			uint32 F;
-			uint32 g;
+		processBlock(buffer);
+		buffered = 0;
 
-			for (int j = 0; j < 64; j++)
+		writeDigest(output);
+	}
+
+protected:
+
+	virtual void processBlock(const uint8 *block) = 0;
+	virtual void writeDigest(HashFunction::Value &output) const = 0;
+
+private:
+
+	uint8 buffer[BLOCK_SIZE];
+	size_t buffered;
+	uint64 length;
+
+}; // BlockState
+
+/**
+ * The following implementation is based on the pseudocode provided by multiple
+ * authors on wikipedia: https://en.wikipedia.org/wiki/MD5
+ * The pseudocode is licensed under the CC-BY-SA license, but no authorship
+ * information is present. I believe this note, and the zlib license of this
+ * project satisfy the conditions of the license.
+ **/
+class MD5State : public BlockState<64, false>
+{
+public:
+
+	MD5State()
+		: a0(0x67452301)
+		, b0(0xefcdab89)
+		, c0(0x98badcfe)
+		, d0(0x10325476)
+	{
+	}
+
+protected:
+
+	void processBlock(const uint8 *block) override
+	{
+		uint32 chunk[16];
+		for (int i = 0; i < 16; i++)
+			chunk[i] = loadLE32(block + i * 4);
+
+		uint32 A = a0;
+		uint32 B = b0;
+		uint32 C = c0;
+		uint32 D = d0;
+		uint32 F;
+		uint32 g;
+
+		for (int j = 0; j < 64; j++)
+		{
+			if (j < 16)
 			{
-				if (j < 16)
-				{
-					F = (B & C) | (~B & D);
-					g = j;
-				}
-				else if (j < 32)
-				{
-					F = (D & B) | (~D & C);
-					g = (5*j + 1) % 16;
-				}
-				else if (j < 48)
-				{
-					F = B ^ C ^ D;
-					g = (3*j + 5) % 16;
-				}
-				else
-				{
-					F = C ^ (B | ~D);
-					g = (7*j) % 16;
-				}
-
-				uint32 temp = D;
-				D = C;
-				C = B;
-				B += leftrot(A + F + constants[j] + chunk[g], shifts[j]);
-				A = temp;
+				F = (B & C) | (~B & D);
+				g = j;
+			}
+			else if (j < 32)
+			{
+				F = (D & B) | (~D & C);
+				g = (5*j + 1) % 16;
+			}
+			else if (j < 48)
+			{
+				F = B ^ C ^ D;
+				g = (3*j + 5) % 16;
+			}
+			else
+			{
+				F = C ^ (B | ~D);
+				g = (7*j) % 16;
 			}
 
-			a0 += A;
-			b0 += B;
-			c0 += C;
-			d0 += D;
+			uint32 temp = D;
+			D = C;
+			C = B;
+			B += leftrot(A + F + constants[j] + chunk[g], shifts[j]);
+			A = temp;
 		}
 
-		delete[] padded;
+		a0 += A;
+		b0 += B;
+		c0 += C;
+		d0 += D;
+	}
 
-		memcpy(&output.data[ 0], &a0, 4);
-		memcpy(&output.data[ 4], &b0, 4);
-		memcpy(&output.data[ 8], &c0, 4);
-		memcpy(&output.data[12], &d0, 4);
+	void writeDigest(HashFunction::Value &output) const override
+	{
+		storeLE32(&output.data[ 0], a0);
+		storeLE32(&output.data[ 4], b0);
+		storeLE32(&output.data[ 8], c0);
+		storeLE32(&output.data[12], d0);
 		output.size = 16;
 	}
-} md5;
 
-const uint8 MD5::shifts[64] = {
+private:
+
+	static const uint8 shifts[64];
+	static const uint32 constants[64];
+
+	uint32 a0, b0, c0, d0;
+
+}; // MD5State
+
+const uint8 MD5State::shifts[64] = {
 	7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
 	5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
 	4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
 	6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
 };
 
-const uint32 MD5::constants[64] = {
+const uint32 MD5State::constants[64] = {
 	0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
 	0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
 	0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
@@ -183,233 +309,215 @@ const uint32 MD5::constants[64] = {
 	0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
 };
 
-/**
- * The following implementation was based on the text, not the code listings,
- * in RFC3174. I believe this means no copyright other than that of the L�VE
- * Development Team applies.
- **/
-class SHA1 : public HashFunction
+class MD5 : public HashFunction
 {
 public:
 	bool isSupported(Function function) const override
 	{
-		return function == FUNCTION_SHA1;
+		return function == FUNCTION_MD5;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	State *newState(Function function) const override
 	{
-		if (function != FUNCTION_SHA1)
-			throw love::Exception("Hash function not supported by SHA1 implementation");
+		if (function != FUNCTION_MD5)
+			throw love::Exception("Hash function not supported by MD5 implementation");
 
-		uint32 intermediate[5] = {
-			0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
-		};
+		return new MD5State();
+	}
+} md5;
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+/**
+ * The following implementation was based on the text, not the code listings,
+ * in RFC3174. I believe this means no copyright other than that of the L�VE
+ * Development Team applies.
+ **/
+class SHA1State : public BlockState<64, true>
+{
+public:
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
+	SHA1State()
+		: intermediate{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}
+	{
+	}
 
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
+protected:
 
+	void processBlock(const uint8 *block) override
+	{
 		// Allocate our extended words
 		uint32 words[80];
 
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
-		{
-			uint32 *chunk = &padded[i];
-			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
-			for (int j = 16; j < 80; j++)
-				words[j] = leftrot(words[j-3] ^ words[j-8] ^ words[j-14] ^ words[j-16], 1);
+		for (int j = 0; j < 16; j++)
+			words[j] = loadBE32(block + j * 4);
+		for (int j = 16; j < 80; j++)
+			words[j] = leftrot(words[j-3] ^ words[j-8] ^ words[j-14] ^ words[j-16], 1);
 
-			uint32 A = intermediate[0];
-			uint32 B = intermediate[1];
-			uint32 C = intermediate[2];
-			uint32 D = intermediate[3];
-			uint32 E = intermediate[4];
-
-			for (int j = 0; j < 80; j++)
-			{
-				uint32 temp = leftrot(A, 5) + E + words[j];
-
-				if (j < 20)
-					temp += 0x5A827999 + ((B & C) | (~B & D));
-				else if (j < 40)
-					temp += 0x6ED9EBA1 + (B ^ C ^ D);
-				else if (j < 60)
-					temp += 0x8F1BBCDC + ((B & C) | (B & D) | (C & D));
-				else
-					temp += 0xCA62C1D6 + (B ^ C ^ D);
-
-				E = D;
-				D = C;
-				C = leftrot(B, 30);
-				B = A;
-				A = temp;
-			}
+		uint32 A = intermediate[0];
+		uint32 B = intermediate[1];
+		uint32 C = intermediate[2];
+		uint32 D = intermediate[3];
+		uint32 E = intermediate[4];
 
-			intermediate[0] += A;
-			intermediate[1] += B;
-			intermediate[2] += C;
-			intermediate[3] += D;
-			intermediate[4] += E;
+		for (int j = 0; j < 80; j++)
+		{
+			uint32 temp = leftrot(A, 5) + E + words[j];
+
+			if (j < 20)
+				temp += 0x5A827999 + ((B & C) | (~B & D));
+			else if (j < 40)
+				temp += 0x6ED9EBA1 + (B ^ C ^ D);
+			else if (j < 60)
+				temp += 0x8F1BBCDC + ((B & C) | (B & D) | (C & D));
+			else
+				temp += 0xCA62C1D6 + (B ^ C ^ D);
+
+			E = D;
+			D = C;
+			C = leftrot(B, 30);
+			B = A;
+			A = temp;
 		}
 
-		delete[] padded;
+		intermediate[0] += A;
+		intermediate[1] += B;
+		intermediate[2] += C;
+		intermediate[3] += D;
+		intermediate[4] += E;
+	}
 
+	void writeDigest(HashFunction::Value &output) const override
+	{
 		for (int i = 0; i < 20; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+			storeBE32(&output.data[i], intermediate[i/4]);
 
 		output.size = 20;
 	}
-} sha1;
 
-/**
- * This implementation was based on the description in RFC-6234.
- **/
-// SHA-2: SHA-224 and SHA-256
-class SHA256 : public HashFunction
-{
 private:
-	static const uint32 initial224[8];
-	static const uint32 initial256[8];
-	static const uint32 constants[64];
 
+	uint32 intermediate[5];
+
+}; // SHA1State
+
+class SHA1 : public HashFunction
+{
 public:
 	bool isSupported(Function function) const override
 	{
-		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
+		return function == FUNCTION_SHA1;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	State *newState(Function function) const override
 	{
-		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
-
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 8, 64);
+		if (function != FUNCTION_SHA1)
+			throw love::Exception("Hash function not supported by SHA1 implementation");
 
-		uint32 *padded = new uint32[paddedLength / 4];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
+		return new SHA1State();
+	}
+} sha1;
 
-		// Append length in bits (big endian)
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
+/**
+ * This implementation was based on the description in RFC-6234.
+ **/
+// SHA-2: SHA-224 and SHA-256
+class SHA256State : public BlockState<64, true>
+{
+public:
 
-		uint32 intermediate[8];
-		if (function == FUNCTION_SHA224)
+	SHA256State(bool is224)
+		: is224(is224)
+	{
+		if (is224)
 			memcpy(intermediate, initial224, sizeof(intermediate));
 		else
 			memcpy(intermediate, initial256, sizeof(intermediate));
+	}
+
+protected:
 
+	void processBlock(const uint8 *block) override
+	{
 		// Allocate our extended words
 		uint32 words[64];
 
-		for (uint64 i = 0; i < paddedLength/4; i += 16)
+		for (int j = 0; j < 16; j++)
+			words[j] = loadBE32(block + j * 4);
+		for (int j = 16; j < 64; j++)
 		{
-			uint32 *chunk = &padded[i];
-			for (int j = 0; j < 16; j++)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 24) & 0xFF;
-				c[1] = (chunk[j] >> 16) & 0xFF;
-				c[2] = (chunk[j] >>  8) & 0xFF;
-				c[3] = (chunk[j] >>  0) & 0xFF;
-			}
-			for (int j = 16; j < 64; j++)
-			{
-				words[j] = rightrot(words[j-2], 17) ^ rightrot(words[j-2], 19) ^ (words[j-2] >> 10);
-				words[j] += rightrot(words[j-15], 7) ^ rightrot(words[j-15], 18) ^ (words[j-15] >> 3);
-				words[j] += words[j-7] + words[j-16];
-			}
-
-			uint32 A = intermediate[0];
-			uint32 B = intermediate[1];
-			uint32 C = intermediate[2];
-			uint32 D = intermediate[3];
-			uint32 E = intermediate[4];
-			uint32 F = intermediate[5];
-			uint32 G = intermediate[6];
-			uint32 H = intermediate[7];
+			words[j] = rightrot(words[j-2], 17) ^ rightrot(words[j-2], 19) ^ (words[j-2] >> 10);
+			words[j] += rightrot(words[j-15], 7) ^ rightrot(words[j-15], 18) ^ (words[j-15] >> 3);
+			words[j] += words[j-7] + words[j-16];
+		}
 
-			for (int j = 0; j < 64; j++)
-			{
-				uint32 temp1 = H + constants[j] + words[j];
-				temp1 += rightrot(E, 6) ^ rightrot(E, 11) ^ rightrot(E, 25);
-				temp1 += (E & F) ^ (~E & G);
-				uint32 temp2 = rightrot(A, 2) ^ rightrot(A, 13) ^ rightrot(A, 22);
-				temp2 += (A & B) ^ (A & C) ^ (B & C);
-
-				H = G;
-				G = F;
-				F = E;
-				E = D + temp1;
-				D = C;
-				C = B;
-				B = A;
-				A = temp1 + temp2;
-			}
+		uint32 A = intermediate[0];
+		uint32 B = intermediate[1];
+		uint32 C = intermediate[2];
+		uint32 D = intermediate[3];
+		uint32 E = intermediate[4];
+		uint32 F = intermediate[5];
+		uint32 G = intermediate[6];
+		uint32 H = intermediate[7];
 
-			intermediate[0] += A;
-			intermediate[1] += B;
-			intermediate[2] += C;
-			intermediate[3] += D;
-			intermediate[4] += E;
-			intermediate[5] += F;
-			intermediate[6] += G;
-			intermediate[7] += H;
+		for (int j = 0; j < 64; j++)
+		{
+			uint32 temp1 = H + constants[j] + words[j];
+			temp1 += rightrot(E, 6) ^ rightrot(E, 11) ^ rightrot(E, 25);
+			temp1 += (E & F) ^ (~E & G);
+			uint32 temp2 = rightrot(A, 2) ^ rightrot(A, 13) ^ rightrot(A, 22);
+			temp2 += (A & B) ^ (A & C) ^ (B & C);
+
+			H = G;
+			G = F;
+			F = E;
+			E = D + temp1;
+			D = C;
+			C = B;
+			B = A;
+			A = temp1 + temp2;
 		}
 
-		delete[] padded;
+		intermediate[0] += A;
+		intermediate[1] += B;
+		intermediate[2] += C;
+		intermediate[3] += D;
+		intermediate[4] += E;
+		intermediate[5] += F;
+		intermediate[6] += G;
+		intermediate[7] += H;
+	}
 
-		int hashlength = 32;
-		if (function == FUNCTION_SHA224)
-			hashlength = 28;
+	void writeDigest(HashFunction::Value &output) const override
+	{
+		int hashlength = is224 ? 28 : 32;
 
 		for (int i = 0; i < hashlength; i += 4)
-		{
-			output.data[i+0] = (intermediate[i/4] >> 24) & 0xFF;
-			output.data[i+1] = (intermediate[i/4] >> 16) & 0xFF;
-			output.data[i+2] = (intermediate[i/4] >>  8) & 0xFF;
-			output.data[i+3] = (intermediate[i/4] >>  0) & 0xFF;
-		}
+			storeBE32(&output.data[i], intermediate[i/4]);
 
 		output.size = hashlength;
 	}
-} sha256;
 
-const uint32 SHA256::initial224[8] = {
+private:
+
+	static const uint32 initial224[8];
+	static const uint32 initial256[8];
+	static const uint32 constants[64];
+
+	bool is224;
+	uint32 intermediate[8];
+
+}; // SHA256State
+
+const uint32 SHA256State::initial224[8] = {
 	0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
 	0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4,
 };
 
-const uint32 SHA256::initial256[8] = {
+const uint32 SHA256State::initial256[8] = {
 	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
 	0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
 };
 
-const uint32 SHA256::constants[64] = {
+const uint32 SHA256State::constants[64] = {
 	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
 	0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
 	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
@@ -428,142 +536,124 @@ const uint32 SHA256::constants[64] = {
 	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
-/**
- * This implementation was based on the description in RFC-6234.
- **/
-// SHA-2: SHA-384 and SHA-512
-class SHA512 : public HashFunction
+class SHA256 : public HashFunction
 {
-private:
-	static const uint64 initial384[8];
-	static const uint64 initial512[8];
-	static const uint64 constants[80];
-
 public:
 	bool isSupported(Function function) const override
 	{
-		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
+		return function == FUNCTION_SHA224 || function == FUNCTION_SHA256;
 	}
 
-	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	State *newState(Function function) const override
 	{
 		if (!isSupported(function))
-			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+			throw love::Exception("Hash function not supported by SHA-224/SHA-256 implementation");
+
+		return new SHA256State(function == FUNCTION_SHA224);
+	}
+} sha256;
+
+/**
+ * This implementation was based on the description in RFC-6234.
+ **/
+// SHA-2: SHA-384 and SHA-512
+class SHA512State : public BlockState<128, true>
+{
+public:
 
-		uint64 intermediates[8];
-		if (function == FUNCTION_SHA384)
+	SHA512State(bool is384)
+		: is384(is384)
+	{
+		if (is384)
 			memcpy(intermediates, initial384, sizeof(intermediates));
 		else
 			memcpy(intermediates, initial512, sizeof(intermediates));
+	}
 
-		// Compute final padded length, accounting for the appended bit (byte) and size
-		uint64 paddedLength = extend_multiple(length + 1 + 16, 128);
-
-		uint64 *padded = new uint64[paddedLength / 8];
-		memcpy(padded, input, length);
-		memset(((uint8*)padded) + length, 0, paddedLength - length);
-		*(((uint8*)padded) + length) = 0x80; // append bit
-
-		// Append length in bits (big endian), note we only write a 64-bit int, so
-		// we have filled the first 8 bytes with zeroes
-		uint64 bit_length = length * 8;
-		for (int i = 0; i < 8; ++i)
-			*(((uint8*)padded) + (paddedLength - 8 + i)) = (bit_length >> (56 - i * 8)) & 0xFF;
+protected:
 
+	void processBlock(const uint8 *block) override
+	{
 		// Allocate our extended words
 		uint64 words[80];
 
-		for (uint64 i = 0; i < paddedLength/8; i += 16)
+		for (int j = 0; j < 16; ++j)
+			words[j] = loadBE64(block + j * 8);
+		for (int j = 16; j < 80; ++j)
 		{
-			uint64 *chunk = &padded[i];
-			for (int j = 0; j < 16; ++j)
-			{
-				char *c = (char*) &words[j];
-				c[0] = (chunk[j] >> 56) & 0xFF;
-				c[1] = (chunk[j] >> 48) & 0xFF;
-				c[2] = (chunk[j] >> 40) & 0xFF;
-				c[3] = (chunk[j] >> 32) & 0xFF;
-				c[4] = (chunk[j] >> 24) & 0xFF;
-				c[5] = (chunk[j] >> 16) & 0xFF;
-				c[6] = (chunk[j] >>  8) & 0xFF;
-				c[7] = (chunk[j] >>  0) & 0xFF;
-			}
-			for (int j = 16; j < 80; ++j)
-			{
-				words[j] = words[j-7] + words[j-16];
-				words[j] += rightrot(words[j-2], 19) ^ rightrot(words[j-2], 61) ^ (words[j-2] >> 6);
-				words[j] += rightrot(words[j-15], 1) ^ rightrot(words[j-15], 8) ^ (words[j-15] >> 7);
-			}
-
-			uint64 A = intermediates[0];
-			uint64 B = intermediates[1];
-			uint64 C = intermediates[2];
-			uint64 D = intermediates[3];
-			uint64 E = intermediates[4];
-			uint64 F = intermediates[5];
-			uint64 G = intermediates[6];
-			uint64 H = intermediates[7];
+			words[j] = words[j-7] + words[j-16];
+			words[j] += rightrot(words[j-2], 19) ^ rightrot(words[j-2], 61) ^ (words[j-2] >> 6);
+			words[j] += rightrot(words[j-15], 1) ^ rightrot(words[j-15], 8) ^ (words[j-15] >> 7);
+		}
 
-			for (int j = 0; j < 80; ++j)
-			{
-				uint64 temp1 = H + constants[j] + words[j];
-				temp1 += rightrot(E, 14) ^ rightrot(E, 18) ^ rightrot(E, 41);
-				temp1 += (E & F) ^ (~E & G);
-				uint64 temp2 = rightrot(A, 28) ^ rightrot(A, 34) ^ rightrot(A, 39);
-				temp2 += (A & B) ^ (A & C) ^ (B & C);
-				H = G;
-				G = F;
-				F = E;
-				E = D + temp1;
-				D = C;
-				C = B;
-				B = A;
-				A = temp1 + temp2;
-			}
+		uint64 A = intermediates[0];
+		uint64 B = intermediates[1];
+		uint64 C = intermediates[2];
+		uint64 D = intermediates[3];
+		uint64 E = intermediates[4];
+		uint64 F = intermediates[5];
+		uint64 G = intermediates[6];
+		uint64 H = intermediates[7];
 
-			intermediates[0] += A;
-			intermediates[1] += B;
-			intermediates[2] += C;
-			intermediates[3] += D;
-			intermediates[4] += E;
-			intermediates[5] += F;
-			intermediates[6] += G;
-			intermediates[7] += H;
+		for (int j = 0; j < 80; ++j)
+		{
+			uint64 temp1 = H + constants[j] + words[j];
+			temp1 += rightrot(E, 14) ^ rightrot(E, 18) ^ rightrot(E, 41);
+			temp1 += (E & F) ^ (~E & G);
+			uint64 temp2 = rightrot(A, 28) ^ rightrot(A, 34) ^ rightrot(A, 39);
+			temp2 += (A & B) ^ (A & C) ^ (B & C);
+			H = G;
+			G = F;
+			F = E;
+			E = D + temp1;
+			D = C;
+			C = B;
+			B = A;
+			A = temp1 + temp2;
 		}
 
-		delete[] padded;
+		intermediates[0] += A;
+		intermediates[1] += B;
+		intermediates[2] += C;
+		intermediates[3] += D;
+		intermediates[4] += E;
+		intermediates[5] += F;
+		intermediates[6] += G;
+		intermediates[7] += H;
+	}
 
-		int hashlength = 64;
-		if (function == FUNCTION_SHA384)
-			hashlength = 48;
+	void writeDigest(HashFunction::Value &output) const override
+	{
+		int hashlength = is384 ? 48 : 64;
 
 		for (int i = 0; i < hashlength; i += 8)
-		{
-			output.data[i+0] = (intermediates[i/8] >> 56) & 0xFF;
-			output.data[i+1] = (intermediates[i/8] >> 48) & 0xFF;
-			output.data[i+2] = (intermediates[i/8] >> 40) & 0xFF;
-			output.data[i+3] = (intermediates[i/8] >> 32) & 0xFF;
-			output.data[i+4] = (intermediates[i/8] >> 24) & 0xFF;
-			output.data[i+5] = (intermediates[i/8] >> 16) & 0xFF;
-			output.data[i+6] = (intermediates[i/8] >>  8) & 0xFF;
-			output.data[i+7] = (intermediates[i/8] >>  0) & 0xFF;
-		}
+			storeBE64(&output.data[i], intermediates[i/8]);
 
 		output.size = hashlength;
 	}
-} sha512;
 
-const uint64 SHA512::initial384[8] = {
+private:
+
+	static const uint64 initial384[8];
+	static const uint64 initial512[8];
+	static const uint64 constants[80];
+
+	bool is384;
+	uint64 intermediates[8];
+
+}; // SHA512State
+
+const uint64 SHA512State::initial384[8] = {
 	0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17, 0x152fecd8f70e5939,
 	0x67332667ffc00b31, 0x8eb44a8768581511, 0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4,
 };
 
-const uint64 SHA512::initial512[8] = {
+const uint64 SHA512State::initial512[8] = {
 	0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
 	0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
 };
 
-const uint64 SHA512::constants[80] = {
+const uint64 SHA512State::constants[80] = {
 	0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
 	0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
 	0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
@@ -586,6 +676,277 @@ const uint64 SHA512::constants[80] = {
 	0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
 };
 
+class SHA512 : public HashFunction
+{
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_SHA384 || function == FUNCTION_SHA512;
+	}
+
+	State *newState(Function function) const override
+	{
+		if (!isSupported(function))
+			throw love::Exception("Hash function not supported by SHA-384/SHA-512 implementation");
+
+		return new SHA512State(function == FUNCTION_SHA384);
+	}
+} sha512;
+
+// xxHash results use its canonical (big endian) representation, which matches
+// the hexadecimal output of the xxhsum tool.
+class XXH32State : public HashFunction::State
+{
+public:
+
+	XXH32State()
+		: state(XXH32_createState())
+	{
+		if (state == nullptr)
+			throw love::Exception("Out of memory.");
+
+		XXH32_reset(state, 0);
+	}
+
+	virtual ~XXH32State()
+	{
+		XXH32_freeState(state);
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		XXH32_update(state, input, (size_t) length);
+	}
+
+	void finish(HashFunction::Value &output) override
+	{
+		storeBE32(output.data, XXH32_digest(state));
+		output.size = 4;
+	}
+
+private:
+
+	XXH32_state_t *state;
+
+}; // XXH32State
+
+class XXH64State : public HashFunction::State
+{
+public:
+
+	XXH64State()
+		: state(XXH64_createState())
+	{
+		if (state == nullptr)
+			throw love::Exception("Out of memory.");
+
+		XXH64_reset(state, 0);
+	}
+
+	virtual ~XXH64State()
+	{
+		XXH64_freeState(state);
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		XXH64_update(state, input, (size_t) length);
+	}
+
+	void finish(HashFunction::Value &output) override
+	{
+		storeBE64(output.data, XXH64_digest(state));
+		output.size = 8;
+	}
+
+private:
+
+	XXH64_state_t *state;
+
+}; // XXH64State
+
+class XXHash : public HashFunction
+{
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_XXH32 || function == FUNCTION_XXH64;
+	}
+
+	void hash(Function function, const char *input, uint64 length, Value &output) const override
+	{
+		if (function == FUNCTION_XXH32)
+		{
+			storeBE32(output.data, XXH32(input, (size_t) length, 0));
+			output.size = 4;
+		}
+		else if (function == FUNCTION_XXH64)
+		{
+			storeBE64(output.data, XXH64(input, (size_t) length, 0));
+			output.size = 8;
+		}
+		else
+			throw love::Exception("Hash function not supported by xxHash implementation");
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function == FUNCTION_XXH32)
+			return new XXH32State();
+		else if (function == FUNCTION_XXH64)
+			return new XXH64State();
+		else
+			throw love::Exception("Hash function not supported by xxHash implementation");
+	}
+} xxhash;
+
+#if defined(LOVE_CRC32C_SSE42)
+
+LOVE_CRC32C_SSE42_TARGET uint32 crc32cSSE42(uint32 crc, const uint8 *p, uint64 length)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	for (; length >= 8; length -= 8, p += 8)
+	{
+		uint64 v;
+		memcpy(&v, p, sizeof(v));
+		crc = (uint32) _mm_crc32_u64(crc, v);
+	}
+#endif
+	for (; length >= 4; length -= 4, p += 4)
+	{
+		uint32 v;
+		memcpy(&v, p, sizeof(v));
+		crc = _mm_crc32_u32(crc, v);
+	}
+	for (; length > 0; length--, p++)
+		crc = _mm_crc32_u8(crc, *p);
+
+	return crc;
+}
+
+bool hasSSE42()
+{
+#if defined(__SSE4_2__)
+	return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 20)) != 0;
+#else
+	return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+#endif // LOVE_CRC32C_SSE42
+
+/**
+ * CRC-32C (Castagnoli), as used by iSCSI, ext4 and SSE 4.2's crc32 instruction.
+ * Without hardware support, this uses the slicing-by-8 table method.
+ **/
+class CRC32CState : public HashFunction::State
+{
+public:
+
+	CRC32CState()
+		: crc(0xFFFFFFFF)
+	{
+	}
+
+	void update(const char *input, uint64 length) override
+	{
+		crc = process(crc, (const uint8 *) input, length);
+	}
+
+	void finish(HashFunction::Value &output) override
+	{
+		storeBE32(output.data, ~crc);
+		output.size = 4;
+	}
+
+	static uint32 process(uint32 crc, const uint8 *p, uint64 length)
+	{
+#if defined(LOVE_CRC32C_SSE42)
+		static const bool sse42 = hasSSE42();
+		if (sse42)
+			return crc32cSSE42(crc, p, length);
+#elif defined(LOVE_CRC32C_ARM)
+		for (; length >= 8; length -= 8, p += 8)
+		{
+			uint64 v;
+			memcpy(&v, p, sizeof(v));
+			crc = __crc32cd(crc, v);
+		}
+		for (; length > 0; length--, p++)
+			crc = __crc32cb(crc, *p);
+		return crc;
+#endif
+
+		static const Tables tables;
+		const uint32 (&t)[8][256] = tables.t;
+
+		for (; length >= 8; length -= 8, p += 8)
+		{
+			uint32 lo = crc ^ loadLE32(p);
+			uint32 hi = loadLE32(p + 4);
+
+			crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+			    ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+		}
+
+		for (; length > 0; length--, p++)
+			crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+
+		return crc;
+	}
+
+private:
+
+	struct Tables
+	{
+		uint32 t[8][256];
+
+		Tables()
+		{
+			// Reversed Castagnoli polynomial.
+			const uint32 poly = 0x82F63B78;
+
+			for (uint32 i = 0; i < 256; i++)
+			{
+				uint32 c = i;
+				for (int k = 0; k < 8; k++)
+					c = (c & 1) ? (c >> 1) ^ poly : (c >> 1);
+				t[0][i] = c;
+			}
+
+			for (uint32 i = 0; i < 256; i++)
+			{
+				for (int s = 1; s < 8; s++)
+					t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+			}
+		}
+	};
+
+	uint32 crc;
+
+}; // CRC32CState
+
+class CRC32C : public HashFunction
+{
+public:
+	bool isSupported(Function function) const override
+	{
+		return function == FUNCTION_CRC32C;
+	}
+
+	State *newState(Function function) const override
+	{
+		if (function != FUNCTION_CRC32C)
+			throw love::Exception("Hash function not supported by CRC32C implementation");
+
+		return new CRC32CState();
+	}
+} crc32c;
+
 } // impl
 }
 
@@ -603,6 +964,11 @@ HashFunction *HashFunction::getHashFunction(Function function)
 	case FUNCTION_SHA384:
 	case FUNCTION_SHA512:
 		return &impl::sha512;
+	case FUNCTION_XXH32:
+	case FUNCTION_XXH64:
+		return &impl::xxhash;
+	case FUNCTION_CRC32C:
+		return &impl::crc32c;
 	case FUNCTION_MAX_ENUM:
 		return nullptr;
 	// No default for compiler warnings
@@ -610,6 +976,13 @@ HashFunction *HashFunction::getHashFunction(Function function)
     return nullptr;
 }
 
+void HashFunction::hash(Function function, const char *input, uint64 length, Value &output) const
+{
+	std::unique_ptr<State> state(newState(function));
+	state->update(input, length);
+	state->finish(output);
+}
+
 bool HashFunction::getConstant(const char *in, Function &out)
 {
 	return functionNames.find(in, out);
@@ -632,6 +1005,9 @@ StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM>::Entry HashFu
 	{"sha256", FUNCTION_SHA256},
 	{"sha384", FUNCTION_SHA384},
 	{"sha512", FUNCTION_SHA512},
+	{"xxh32", FUNCTION_XXH32},
+	{"xxh64", FUNCTION_XXH64},
+	{"crc32c", FUNCTION_CRC32C},
 };
 
 StringMap<HashFunction::Function, HashFunction::FUNCTION_MAX_ENUM> HashFunction::functionNames(HashFunction::functionEntries, sizeof(HashFunction::functionEntries));
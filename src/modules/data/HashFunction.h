@@ -42,6 +42,9 @@ class HashFunction
 		FUNCTION_SHA256,
 		FUNCTION_SHA384,
 		FUNCTION_SHA512,
+		FUNCTION_XXH32,
+		FUNCTION_XXH64,
+		FUNCTION_CRC32C,
 		FUNCTION_MAX_ENUM
 	};
 
@@ -51,6 +54,29 @@ class HashFunction
 		size_t size;
 	};
 
+	/**
+	 * The intermediate state of an incremental hash. Input can be given in
+	 * pieces of any size, and produces the same result as hashing it at once.
+	 **/
+	class State
+	{
+	public:
+
+		virtual ~State() {}
+
+		/**
+		 * Hash the next piece of input.
+		 **/
+		virtual void update(const char *input, uint64 length) = 0;
+
+		/**
+		 * Produce the result of the hash function. The state can't be updated
+		 * afterwards.
+		 **/
+		virtual void finish(Value &output) = 0;
+
+	}; // State
+
 	/**
 	 * Get a HashFunction instance for the given function.
 	 *
@@ -70,7 +96,15 @@ class HashFunction
 	 * @param[in] length The length of the input data.
 	 * @param[out] output The result of the hash function.
 	 **/
-	virtual void hash(Function function, const char *input, uint64 length, Value &output) const = 0;
+	virtual void hash(Function function, const char *input, uint64 length, Value &output) const;
+
+	/**
+	 * Create a new incremental hash state.
+	 *
+	 * @param[in] function The selected hash function.
+	 * @return A new State (allocated with new) for the given function.
+	 **/
+	virtual State *newState(Function function) const = 0;
 
 	/**
 	 * @param[in] function The requested hash function.
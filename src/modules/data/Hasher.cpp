@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Hasher.h"
+#include "common/Exception.h"
+
+namespace love
+{
+namespace data
+{
+
+love::Type Hasher::type("Hasher", &Object::type);
+
+Hasher::Hasher(HashFunction::Function function)
+	: function(function)
+	, finished(false)
+{
+	HashFunction *hashfunction = HashFunction::getHashFunction(function);
+	if (hashfunction == nullptr)
+		throw love::Exception("Invalid hash function.");
+
+	state.reset(hashfunction->newState(function));
+}
+
+Hasher::~Hasher()
+{
+}
+
+void Hasher::update(const char *input, uint64 length)
+{
+	if (finished)
+		throw love::Exception("Cannot update a Hasher after it has finished.");
+
+	state->update(input, length);
+}
+
+void Hasher::finish(HashFunction::Value &output)
+{
+	if (finished)
+		throw love::Exception("Hasher has already finished.");
+
+	state->finish(output);
+	finished = true;
+}
+
+} // data
+} // love
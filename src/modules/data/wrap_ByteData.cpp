@@ -150,6 +150,26 @@ static const luaL_Reg w_ByteData_functions[] =
 	{ 0, 0 }
 };
 
+void luax_pushexternalbytedata(lua_State *L, void *bytes, size_t size, ByteData::Deleter deleter, void *context)
+{
+	StrongRef<ByteData> data;
+
+	luax_catchexcept(L, [&]() {
+		try
+		{
+			data.set(new ByteData(bytes, size, deleter, context), Acquire::NORETAIN);
+		}
+		catch (...)
+		{
+			// Nothing else owns the memory yet.
+			deleter(bytes, context);
+			throw;
+		}
+	});
+
+	luax_pushtype(L, data);
+}
+
 int luaopen_bytedata(lua_State *L)
 {
 	luax_register_type(L, &ByteData::type, w_Data_functions, w_ByteData_functions, nullptr);
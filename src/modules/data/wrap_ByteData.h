@@ -32,5 +32,14 @@ namespace data
 ByteData *luax_checkbytedata(lua_State *L, int idx);
 int luaopen_bytedata(lua_State *L);
 
+extern "C" { // Called by enet
+	/**
+	 * Pushes a ByteData which uses existing memory without copying it. The
+	 * deleter is called with the memory and context once it's destroyed, or
+	 * right away if the ByteData can't be created.
+	 **/
+	void luax_pushexternalbytedata(lua_State *L, void *bytes, size_t size, ByteData::Deleter deleter, void *context);
+}
+
 } // data
 } // love
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "wrap_CompressionStream.h"
+#include "wrap_DataModule.h"
+
+namespace love
+{
+namespace data
+{
+
+#define instance() (Module::getInstance<DataModule>(Module::M_DATA))
+
+CompressionStream *luax_checkcompressionstream(lua_State *L, int idx)
+{
+	return luax_checktype<CompressionStream>(L, idx);
+}
+
+static int processStream(lua_State *L, bool finish)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+	ContainerType ctype = luax_checkcontainertype(L, 2);
+
+	size_t size = 0;
+	const char *bytes = nullptr;
+
+	if (luax_istype(L, 3, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, 3);
+		bytes = (const char *) data->getData();
+		size = data->getSize();
+	}
+	else if (finish && lua_isnoneornil(L, 3))
+		bytes = "";
+	else
+		bytes = luaL_checklstring(L, 3, &size);
+
+	std::vector<char> output;
+	luax_catchexcept(L, [&](){ stream->process(bytes, size, finish, output); });
+
+	if (ctype == CONTAINER_DATA)
+	{
+		ByteData *data = nullptr;
+		luax_catchexcept(L, [&]() { data = instance()->newByteData(output.data(), output.size()); });
+		luax_pushtype(L, Data::type, data);
+		data->release();
+	}
+	else
+		lua_pushlstring(L, output.data(), output.size());
+
+	return 1;
+}
+
+int w_CompressionStream_process(lua_State *L)
+{
+	return processStream(L, false);
+}
+
+int w_CompressionStream_finish(lua_State *L)
+{
+	return processStream(L, true);
+}
+
+int w_CompressionStream_isFinished(lua_State *L)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+	luax_pushboolean(L, stream->isFinished());
+	return 1;
+}
+
+int w_CompressionStream_getFormat(lua_State *L)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+
+	const char *fname = nullptr;
+	if (!Compressor::getConstant(stream->getFormat(), fname))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(Compressor::FORMAT_MAX_ENUM), fname);
+
+	lua_pushstring(L, fname);
+	return 1;
+}
+
+int w_CompressionStream_getMode(lua_State *L)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+
+	const char *mname = nullptr;
+	if (!CompressionStream::getConstant(stream->getMode(), mname))
+		return luax_enumerror(L, "compression stream mode", CompressionStream::getConstants(CompressionStream::MODE_MAX_ENUM), mname);
+
+	lua_pushstring(L, mname);
+	return 1;
+}
+
+int w_CompressionStream_getTotalIn(lua_State *L)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+	lua_pushnumber(L, (lua_Number) stream->getTotalIn());
+	return 1;
+}
+
+int w_CompressionStream_getTotalOut(lua_State *L)
+{
+	CompressionStream *stream = luax_checkcompressionstream(L, 1);
+	lua_pushnumber(L, (lua_Number) stream->getTotalOut());
+	return 1;
+}
+
+static const luaL_Reg w_CompressionStream_functions[] =
+{
+	{ "process", w_CompressionStream_process },
+	{ "finish", w_CompressionStream_finish },
+	{ "isFinished", w_CompressionStream_isFinished },
+	{ "getFormat", w_CompressionStream_getFormat },
+	{ "getMode", w_CompressionStream_getMode },
+	{ "getTotalIn", w_CompressionStream_getTotalIn },
+	{ "getTotalOut", w_CompressionStream_getTotalOut },
+	{ 0, 0 },
+};
+
+extern "C" int luaopen_compressionstream(lua_State *L)
+{
+	return luax_register_type(L, &CompressionStream::type, w_CompressionStream_functions, nullptr);
+}
+
+} // data
+} // love
@@ -24,7 +24,10 @@
 #include "wrap_ByteData.h"
 #include "wrap_DataView.h"
 #include "wrap_CompressedData.h"
+#include "wrap_CompressionStream.h"
+#include "wrap_Hasher.h"
 #include "DataModule.h"
+#include "BlockCompressor.h"
 #include "common/b64.h"
 
 // Lua 5.3
@@ -155,23 +158,27 @@ int w_decompress(lua_State *L)
 	char *rawbytes = nullptr;
 	size_t rawsize = 0;
 
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+	size_t compressedsize = 0;
+	const char *cbytes = nullptr;
+	CompressedData *cdata = nullptr;
+	int blockidx = 0;
+
 	if (luax_istype(L, 2, CompressedData::type))
 	{
-		CompressedData *data = luax_checkcompresseddata(L, 2);
-		rawsize = data->getDecompressedSize();
-		luax_catchexcept(L, [&](){ rawbytes = decompress(data, rawsize); });
+		cdata = luax_checkcompresseddata(L, 2);
+		format = cdata->getFormat();
+		cbytes = (const char *) cdata->getData();
+		compressedsize = cdata->getSize();
+		blockidx = 3;
 	}
 	else
 	{
-		Compressor::Format format = Compressor::FORMAT_LZ4;
 		const char *fstr = luaL_checkstring(L, 2);
 
 		if (!Compressor::getConstant(fstr, format))
 			return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
 
-		size_t compressedsize = 0;
-		const char *cbytes = nullptr;
-
 		if (luax_istype(L, 3, Data::type))
 		{
 			Data *data = luax_checktype<Data>(L, 3);
@@ -181,7 +188,34 @@ int w_decompress(lua_State *L)
 		else
 			cbytes = luaL_checklstring(L, 3, &compressedsize);
 
-		luax_catchexcept(L, [&](){ rawbytes = decompress(format, cbytes, compressedsize, rawsize); });
+		blockidx = 4;
+	}
+
+	if (lua_isnoneornil(L, blockidx))
+	{
+		if (cdata != nullptr)
+		{
+			rawsize = cdata->getDecompressedSize();
+			luax_catchexcept(L, [&](){ rawbytes = decompress(cdata, rawsize); });
+		}
+		else
+			luax_catchexcept(L, [&](){ rawbytes = decompress(format, cbytes, compressedsize, rawsize); });
+	}
+	else
+	{
+		// Decompress a single block of a block format.
+		if (!BlockCompressor::isBlockFormat(format))
+			return luaL_argerror(L, blockidx, "block index can only be used with a block compression format");
+
+		lua_Integer block = luaL_checkinteger(L, blockidx) - 1;
+
+		BlockCompressor::BlockIndex index;
+		luax_catchexcept(L, [&](){ BlockCompressor::readIndex(format, cbytes, compressedsize, index); });
+
+		if (block < 0 || block >= (lua_Integer) index.getBlockCount())
+			return luaL_error(L, "Invalid block index: %d", (int) block + 1);
+
+		luax_catchexcept(L, [&](){ rawbytes = BlockCompressor::decompressBlock(format, cbytes, compressedsize, (size_t) block, rawsize); });
 	}
 
 	if (ctype == CONTAINER_DATA)
@@ -200,6 +234,77 @@ int w_decompress(lua_State *L)
 	return 1;
 }
 
+int w_getBlockCount(lua_State *L)
+{
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+	size_t compressedsize = 0;
+	const char *cbytes = nullptr;
+
+	if (luax_istype(L, 1, CompressedData::type))
+	{
+		CompressedData *data = luax_checkcompresseddata(L, 1);
+		format = data->getFormat();
+		cbytes = (const char *) data->getData();
+		compressedsize = data->getSize();
+	}
+	else
+	{
+		const char *fstr = luaL_checkstring(L, 1);
+
+		if (!Compressor::getConstant(fstr, format))
+			return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+		if (luax_istype(L, 2, Data::type))
+		{
+			Data *data = luax_checktype<Data>(L, 2);
+			cbytes = (const char *) data->getData();
+			compressedsize = data->getSize();
+		}
+		else
+			cbytes = luaL_checklstring(L, 2, &compressedsize);
+	}
+
+	if (!BlockCompressor::isBlockFormat(format))
+	{
+		const char *fname = "unknown";
+		Compressor::getConstant(format, fname);
+		return luaL_error(L, "The %s compression format does not use blocks.", fname);
+	}
+
+	BlockCompressor::BlockIndex index;
+	luax_catchexcept(L, [&](){ BlockCompressor::readIndex(format, cbytes, compressedsize, index); });
+
+	lua_pushinteger(L, (lua_Integer) index.getBlockCount());
+	lua_pushinteger(L, (lua_Integer) index.blockSize);
+	return 2;
+}
+
+int w_newCompressionStream(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	Compressor::Format format = Compressor::FORMAT_LZ4;
+
+	if (!Compressor::getConstant(fstr, format))
+		return luax_enumerror(L, "compressed data format", Compressor::getConstants(format), fstr);
+
+	CompressionStream::Mode mode = CompressionStream::MODE_COMPRESS;
+	if (!lua_isnoneornil(L, 2))
+	{
+		const char *mstr = luaL_checkstring(L, 2);
+		if (!CompressionStream::getConstant(mstr, mode))
+			return luax_enumerror(L, "compression stream mode", CompressionStream::getConstants(mode), mstr);
+	}
+
+	int level = (int) luaL_optinteger(L, 3, -1);
+
+	CompressionStream *stream = nullptr;
+	luax_catchexcept(L, [&](){ stream = CompressionStream::create(format, mode, level); });
+
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
 int w_encode(lua_State *L)
 {
 	ContainerType ctype = luax_checkcontainertype(L, 1);
@@ -351,6 +456,22 @@ int w_hash(lua_State *L)
 	return 1;
 }
 
+int w_newHasher(lua_State *L)
+{
+	const char *fstr = luaL_checkstring(L, 1);
+	HashFunction::Function function = HashFunction::FUNCTION_MD5;
+
+	if (!HashFunction::getConstant(fstr, function))
+		return luax_enumerror(L, "hash function", HashFunction::getConstants(function), fstr);
+
+	Hasher *hasher = nullptr;
+	luax_catchexcept(L, [&](){ hasher = new Hasher(function); });
+
+	luax_pushtype(L, hasher);
+	hasher->release();
+	return 1;
+}
+
 int w_pack(lua_State *L)
 {
 	if (luax_istype(L, 1, ByteData::type))
@@ -422,9 +543,12 @@ static const luaL_Reg functions[] =
 	{ "newByteData", w_newByteData },
 	{ "compress", w_compress },
 	{ "decompress", w_decompress },
+	{ "getBlockCount", w_getBlockCount },
+	{ "newCompressionStream", w_newCompressionStream },
 	{ "encode", w_encode },
 	{ "decode", w_decode },
 	{ "hash", w_hash },
+	{ "newHasher", w_newHasher },
 
 	{ "pack", w_pack },
 	{ "unpack", w_unpack },
@@ -439,6 +563,8 @@ static const lua_CFunction types[] =
 	luaopen_bytedata,
 	luaopen_dataview,
 	luaopen_compresseddata,
+	luaopen_compressionstream,
+	luaopen_hasher,
 	nullptr
 };
 
@@ -54,6 +54,89 @@ Event::~Event()
 		defaultModalDrawData.cleanup(defaultModalDrawData.context);
 }
 
+static bool isEqual(const Variant &a, const Variant &b)
+{
+	if (a.getType() != b.getType())
+		return false;
+
+	const Variant::Data &da = a.getData();
+	const Variant::Data &db = b.getData();
+
+	switch (a.getType())
+	{
+	case Variant::BOOLEAN:
+		return da.boolean == db.boolean;
+	case Variant::NUMBER:
+		return da.number == db.number;
+	case Variant::STRING:
+		return da.string->len == db.string->len && memcmp(da.string->str, db.string->str, da.string->len) == 0;
+	case Variant::SMALLSTRING:
+		return da.smallstring.len == db.smallstring.len && memcmp(da.smallstring.str, db.smallstring.str, da.smallstring.len) == 0;
+	case Variant::LUSERDATA:
+		return da.userdata == db.userdata;
+	case Variant::LOVEOBJECT:
+		return da.objectproxy.object == db.objectproxy.object;
+	case Variant::NIL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Returns the message which takes the place of prev at the back of the queue
+ * when next is pushed, or null if both should be kept. Relative mouse motion
+ * is accumulated into a new message. The caller owns a reference to the
+ * returned message.
+ **/
+static Message *coalesce(const Message *prev, Message *next)
+{
+	if (prev->name != next->name || prev->args.size() != next->args.size())
+		return nullptr;
+
+	const std::vector<Variant> &a = prev->args;
+	const std::vector<Variant> &b = next->args;
+
+	// Number of leading arguments identifying the device (and axis / sensor).
+	size_t keys = 0;
+
+	if (next->name == "mousemoved")
+	{
+		// x, y, dx, dy, istouch
+		if (b.size() != 5 || !isEqual(a[4], b[4]))
+			return nullptr;
+
+		for (size_t i = 2; i <= 3; i++)
+		{
+			if (a[i].getType() != Variant::NUMBER || b[i].getType() != Variant::NUMBER)
+				return nullptr;
+		}
+
+		std::vector<Variant> args = b;
+		args[2] = Variant(a[2].getData().number + b[2].getData().number);
+		args[3] = Variant(a[3].getData().number + b[3].getData().number);
+		return new Message(next->name, args);
+	}
+	else if (next->name == "joystickaxis" || next->name == "gamepadaxis" || next->name == "joysticksensorupdated")
+		keys = 2;
+	else if (next->name == "sensorupdated")
+		keys = 1;
+	else
+		return nullptr;
+
+	if (b.size() < keys)
+		return nullptr;
+
+	for (size_t i = 0; i < keys; i++)
+	{
+		if (!isEqual(a[i], b[i]))
+			return nullptr;
+	}
+
+	next->retain();
+	return next;
+}
+
 void Event::push(Message *msg)
 {
 	push(msg, false);
@@ -62,6 +145,18 @@ void Event::push(Message *msg)
 void Event::push(Message *msg, bool pushFront)
 {
 	Lock lock(mutex);
+
+	Message *merged = nullptr;
+	if (!pushFront && coalescing && !queue.empty())
+		merged = coalesce(queue.back(), msg);
+
+	if (merged != nullptr)
+	{
+		queue.back()->release();
+		queue.back() = merged;
+		return;
+	}
+
 	msg->retain();
 	if (pushFront)
 		queue.push_front(msg);
@@ -79,6 +174,15 @@ bool Event::poll(Message *&msg)
 	return true;
 }
 
+void Event::pollAll(std::vector<StrongRef<Message>> &messages)
+{
+	Lock lock(mutex);
+	messages.reserve(messages.size() + queue.size());
+	for (Message *m : queue)
+		messages.emplace_back(m, Acquire::NORETAIN);
+	queue.clear();
+}
+
 void Event::clear()
 {
 	Lock lock(mutex);
@@ -89,6 +193,18 @@ void Event::clear()
 	}
 }
 
+void Event::setCoalescingEnabled(bool enable)
+{
+	Lock lock(mutex);
+	coalescing = enable;
+}
+
+bool Event::isCoalescingEnabled() const
+{
+	Lock lock(mutex);
+	return coalescing;
+}
+
 void Event::setModalDrawData(const ModalDrawData &data)
 {
 	if (modalDrawData.cleanup != nullptr)
@@ -69,8 +69,18 @@ class Event : public Module
 
 	void push(Message *msg);
 	bool poll(Message *&msg);
+	void pollAll(std::vector<StrongRef<Message>> &messages);
 	virtual void clear();
 
+	/**
+	 * When enabled, a pushed mousemoved, joystickaxis, gamepadaxis,
+	 * sensorupdated or joysticksensorupdated event replaces the event at the
+	 * back of the queue if both come from the same device (and axis or
+	 * sensor). Relative mouse motion is accumulated.
+	 **/
+	void setCoalescingEnabled(bool enable);
+	bool isCoalescingEnabled() const;
+
 	virtual void pump(float waitTimeout = 0.0f) = 0;
 	virtual Message *wait() = 0;
 
@@ -95,6 +105,8 @@ class Event : public Module
 	love::thread::MutexRef mutex;
 	std::deque<Message *> queue;
 
+	bool coalescing = false;
+
 }; // Event
 
 } // event
@@ -64,6 +64,62 @@ static int w_poll_i(lua_State *L)
 	return 0;
 }
 
+int w_pollAll(lua_State *L)
+{
+	// Reuse the given table, to avoid creating garbage every frame.
+	if (lua_isnoneornil(L, 1))
+	{
+		lua_settop(L, 0);
+		lua_createtable(L, 0, 0);
+	}
+	else
+	{
+		luaL_checktype(L, 1, LUA_TTABLE);
+		lua_settop(L, 1);
+	}
+
+	// Events with nil arguments leave holes, so the number of entries the
+	// previous call wrote is kept in the table's n field.
+	lua_pushstring(L, "n");
+	lua_rawget(L, 1);
+	int oldlength = lua_isnumber(L, -1) ? (int) lua_tointeger(L, -1) : (int) luax_objlen(L, 1);
+	lua_pop(L, 1);
+
+	std::vector<StrongRef<Message>> messages;
+	instance()->pollAll(messages);
+
+	// Each event is stored as its name, its argument count, then its arguments.
+	int index = 0;
+	for (const StrongRef<Message> &m : messages)
+	{
+		luax_pushstring(L, m->name);
+		lua_rawseti(L, 1, ++index);
+
+		lua_pushinteger(L, (lua_Integer) m->args.size());
+		lua_rawseti(L, 1, ++index);
+
+		for (const Variant &v : m->args)
+		{
+			luax_pushvariant(L, v);
+			lua_rawseti(L, 1, ++index);
+		}
+	}
+
+	// Let go of anything left over from the table's previous use.
+	for (int i = index + 1; i <= oldlength; i++)
+	{
+		lua_pushnil(L);
+		lua_rawseti(L, 1, i);
+	}
+
+	lua_pushstring(L, "n");
+	lua_pushinteger(L, index);
+	lua_rawset(L, 1);
+
+	lua_pushinteger(L, (lua_Integer) messages.size());
+	return 2;
+}
+
 int w_pump(lua_State *L)
 {
 	float waitTimeout = (float)luaL_optnumber(L, 1, 0.0f);
@@ -120,6 +176,18 @@ int w_clear(lua_State *L)
 	return 0;
 }
 
+int w_setCoalescingEnabled(lua_State *L)
+{
+	instance()->setCoalescingEnabled(luax_checkboolean(L, 1));
+	return 0;
+}
+
+int w_isCoalescingEnabled(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isCoalescingEnabled());
+	return 1;
+}
+
 int w_quit(lua_State *L)
 {
 	luax_catchexcept(L, [&]() {
@@ -247,9 +315,12 @@ static const luaL_Reg functions[] =
 {
 	{ "pump", w_pump },
 	{ "poll_i", w_poll_i },
+	{ "pollAll", w_pollAll },
 	{ "wait", w_wait },
 	{ "push", w_push },
 	{ "clear", w_clear },
+	{ "setCoalescingEnabled", w_setCoalescingEnabled },
+	{ "isCoalescingEnabled", w_isCoalescingEnabled },
 	{ "quit", w_quit },
 	{ "restart", w_restart },
 	{ "setModalDrawCallback", w_setModalDrawCallback },
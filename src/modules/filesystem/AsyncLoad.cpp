@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "AsyncLoad.h"
+#include "Filesystem.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "data/DataStream.h"
+#include "thread/ThreadPool.h"
+#include "timer/Timer.h"
+
+#if defined(LOVE_ENABLE_FONT)
+#include "font/Font.h"
+#endif
+#if defined(LOVE_ENABLE_IMAGE)
+#include "image/Image.h"
+#endif
+#if defined(LOVE_ENABLE_SOUND)
+#include "sound/Sound.h"
+#endif
+
+namespace love
+{
+namespace filesystem
+{
+
+love::Type AsyncLoad::type("AsyncLoad", &Object::type);
+
+AsyncLoad::AsyncLoad(Filesystem *filesystem, const std::string &filename, Kind kind, int priority)
+	: filesystem(filesystem)
+	, filename(filename)
+	, kind(kind)
+	, priority(priority)
+	, status(STATUS_PENDING)
+	, resultType(nullptr)
+{
+}
+
+AsyncLoad::~AsyncLoad()
+{
+}
+
+void AsyncLoad::start()
+{
+	StrongRef<AsyncLoad> self(this);
+	thread::ThreadPool::getShared().submit([self]() { self->run(); }, priority);
+}
+
+void AsyncLoad::run()
+{
+	{
+		thread::Lock lock(mutex);
+		if (status != STATUS_PENDING)
+			return;
+		status = STATUS_LOADING;
+	}
+
+	StrongRef<Object> object;
+	love::Type *type = nullptr;
+	std::string err;
+
+	try
+	{
+		// Decoders can read straight from a memory mapping, since they don't
+		// keep the FileData around.
+		FileData *filedata = nullptr;
+		if (kind == KIND_FILEDATA || kind == KIND_RASTERIZER)
+			filedata = filesystem->read(filename.c_str());
+		else
+			filedata = filesystem->readMapped(filename.c_str());
+
+		StrongRef<FileData> data(filedata, Acquire::NORETAIN);
+		object.set(decode(data, type), Acquire::NORETAIN);
+	}
+	catch (std::exception &e)
+	{
+		err = e.what();
+	}
+
+	thread::Lock lock(mutex);
+
+	if (object)
+	{
+		result = object;
+		resultType = type;
+		status = STATUS_COMPLETE;
+	}
+	else
+	{
+		error = err;
+		status = STATUS_FAILED;
+	}
+
+	cond->broadcast();
+}
+
+Object *AsyncLoad::decode(FileData *data, love::Type *&type)
+{
+	switch (kind)
+	{
+	case KIND_FILEDATA:
+		type = &FileData::type;
+		data->retain();
+		return data;
+	case KIND_IMAGEDATA:
+	case KIND_COMPRESSEDIMAGEDATA:
+#if defined(LOVE_ENABLE_IMAGE)
+	{
+		auto imagemodule = Module::getInstance<image::Image>(Module::M_IMAGE);
+		if (imagemodule == nullptr)
+			throw love::Exception("The love.image module must be loaded to load ImageData asynchronously.");
+
+		if (kind == KIND_COMPRESSEDIMAGEDATA)
+		{
+			type = &image::CompressedImageData::type;
+			return imagemodule->newCompressedData(data);
+		}
+
+		type = &image::ImageData::type;
+		return imagemodule->newImageData(data);
+	}
+#else
+		throw love::Exception("love.image is disabled in this build, ImageData can't be loaded asynchronously.");
+#endif // defined(LOVE_ENABLE_IMAGE)
+	case KIND_SOUNDDATA:
+#if defined(LOVE_ENABLE_SOUND)
+	{
+		auto soundmodule = Module::getInstance<sound::Sound>(Module::M_SOUND);
+		if (soundmodule == nullptr)
+			throw love::Exception("The love.sound module must be loaded to load SoundData asynchronously.");
+
+		StrongRef<Stream> stream(new data::DataStream(data), Acquire::NORETAIN);
+		StrongRef<sound::Decoder> decoder(soundmodule->newDecoder(stream, sound::Decoder::DEFAULT_BUFFER_SIZE), Acquire::NORETAIN);
+
+		type = &sound::SoundData::type;
+		return soundmodule->newSoundData(decoder);
+	}
+#else
+		throw love::Exception("love.sound is disabled in this build, SoundData can't be loaded asynchronously.");
+#endif // defined(LOVE_ENABLE_SOUND)
+	case KIND_RASTERIZER:
+#if defined(LOVE_ENABLE_FONT)
+	{
+		auto fontmodule = Module::getInstance<font::Font>(Module::M_FONT);
+		if (fontmodule == nullptr)
+			throw love::Exception("The love.font module must be loaded to load a Rasterizer asynchronously.");
+
+		// The font backend serializes its own library access.
+		type = &font::Rasterizer::type;
+		return fontmodule->newRasterizer(data);
+	}
+#else
+		throw love::Exception("love.font is disabled in this build, a Rasterizer can't be loaded asynchronously.");
+#endif // defined(LOVE_ENABLE_FONT)
+	case KIND_MAX_ENUM:
+		break;
+	}
+
+	throw love::Exception("Invalid asynchronous load kind.");
+}
+
+bool AsyncLoad::cancel()
+{
+	thread::Lock lock(mutex);
+
+	if (status != STATUS_PENDING)
+		return false;
+
+	status = STATUS_CANCELLED;
+	error = "The load was cancelled.";
+	cond->broadcast();
+	return true;
+}
+
+bool AsyncLoad::wait(double timeout)
+{
+	double end = love::timer::Timer::getTime() + timeout;
+
+	thread::Lock lock(mutex);
+
+	while (status == STATUS_PENDING || status == STATUS_LOADING)
+	{
+		if (timeout < 0.0)
+			cond->wait(mutex);
+		else
+		{
+			double remaining = end - love::timer::Timer::getTime();
+			if (remaining <= 0.0)
+				return false;
+			cond->wait(mutex, (int) (remaining * 1000.0) + 1);
+		}
+	}
+
+	return true;
+}
+
+AsyncLoad::Status AsyncLoad::getStatus() const
+{
+	thread::Lock lock(mutex);
+	return status;
+}
+
+bool AsyncLoad::isDone() const
+{
+	Status s = getStatus();
+	return s != STATUS_PENDING && s != STATUS_LOADING;
+}
+
+Object *AsyncLoad::getResult(love::Type *&type) const
+{
+	thread::Lock lock(mutex);
+	type = resultType;
+	return status == STATUS_COMPLETE ? result.get() : nullptr;
+}
+
+std::string AsyncLoad::getError() const
+{
+	thread::Lock lock(mutex);
+	return error;
+}
+
+STRINGMAP_CLASS_BEGIN(AsyncLoad, AsyncLoad::Kind, AsyncLoad::KIND_MAX_ENUM, kind)
+{
+	{ "filedata",            AsyncLoad::KIND_FILEDATA            },
+	{ "imagedata",           AsyncLoad::KIND_IMAGEDATA           },
+	{ "compressedimagedata", AsyncLoad::KIND_COMPRESSEDIMAGEDATA },
+	{ "sounddata",           AsyncLoad::KIND_SOUNDDATA           },
+	{ "rasterizer",          AsyncLoad::KIND_RASTERIZER          },
+}
+STRINGMAP_CLASS_END(AsyncLoad, AsyncLoad::Kind, AsyncLoad::KIND_MAX_ENUM, kind)
+
+STRINGMAP_CLASS_BEGIN(AsyncLoad, AsyncLoad::Status, AsyncLoad::STATUS_MAX_ENUM, status)
+{
+	{ "pending",   AsyncLoad::STATUS_PENDING   },
+	{ "loading",   AsyncLoad::STATUS_LOADING   },
+	{ "complete",  AsyncLoad::STATUS_COMPLETE  },
+	{ "failed",    AsyncLoad::STATUS_FAILED    },
+	{ "cancelled", AsyncLoad::STATUS_CANCELLED },
+}
+STRINGMAP_CLASS_END(AsyncLoad, AsyncLoad::Status, AsyncLoad::STATUS_MAX_ENUM, status)
+
+} // filesystem
+} // love
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "common/StringMap.h"
+#include "thread/threads.h"
+
+// C++
+#include <string>
+
+namespace love
+{
+namespace filesystem
+{
+
+class Filesystem;
+class FileData;
+
+/**
+ * A file which is read and decoded on a worker thread. The result can be
+ * polled or waited on from any thread.
+ **/
+class AsyncLoad : public Object
+{
+public:
+
+	static love::Type type;
+
+	// The kind of object the file is decoded into.
+	enum Kind
+	{
+		KIND_FILEDATA,
+		KIND_IMAGEDATA,
+		KIND_COMPRESSEDIMAGEDATA,
+		KIND_SOUNDDATA,
+		KIND_RASTERIZER,
+		KIND_MAX_ENUM
+	};
+
+	enum Status
+	{
+		STATUS_PENDING,
+		STATUS_LOADING,
+		STATUS_COMPLETE,
+		STATUS_FAILED,
+		STATUS_CANCELLED,
+		STATUS_MAX_ENUM
+	};
+
+	AsyncLoad(Filesystem *filesystem, const std::string &filename, Kind kind, int priority);
+	virtual ~AsyncLoad();
+
+	/**
+	 * Queues the load on the shared worker pool. Loads with a higher priority
+	 * are started first.
+	 **/
+	void start();
+
+	/**
+	 * Cancels the load if it hasn't been started by a worker yet. Returns
+	 * false if it's already loading or done.
+	 **/
+	bool cancel();
+
+	/**
+	 * Blocks until the load is done or the timeout (in seconds) expires. A
+	 * negative timeout waits indefinitely. Returns whether the load is done.
+	 **/
+	bool wait(double timeout = -1.0);
+
+	Status getStatus() const;
+	bool isDone() const;
+
+	/**
+	 * Gets the decoded object, or null if the load hasn't completed.
+	 **/
+	Object *getResult(love::Type *&type) const;
+	std::string getError() const;
+
+	const std::string &getFilename() const { return filename; }
+	Kind getKind() const { return kind; }
+	int getPriority() const { return priority; }
+
+	STRINGMAP_CLASS_DECLARE(Kind);
+	STRINGMAP_CLASS_DECLARE(Status);
+
+private:
+
+	void run();
+	Object *decode(FileData *data, love::Type *&type);
+
+	StrongRef<Filesystem> filesystem;
+
+	std::string filename;
+	Kind kind;
+	int priority;
+
+	thread::MutexRef mutex;
+	thread::ConditionalRef cond;
+
+	Status status;
+	StrongRef<Object> result;
+	love::Type *resultType;
+	std::string error;
+
+}; // AsyncLoad
+
+} // filesystem
+} // love
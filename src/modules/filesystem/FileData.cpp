@@ -19,11 +19,21 @@
  **/
 
 #include "FileData.h"
+#include "common/utf8.h"
 
 // C++
 #include <iostream>
 #include <limits>
 
+#ifdef LOVE_WINDOWS
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
 namespace love
 {
 namespace filesystem
@@ -33,8 +43,9 @@ love::Type FileData::type("FileData", &Data::type);
 
 FileData::FileData(uint64 size, const std::string &filename)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size((size_t) size)
-	, filename(filename)
 {
 	try
 	{
@@ -45,6 +56,93 @@ FileData::FileData(uint64 size, const std::string &filename)
 		throw love::Exception("Out of memory.");
 	}
 
+	setFilename(filename);
+}
+
+FileData::FileData(const std::string &filename)
+	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
+	, size(0)
+{
+	setFilename(filename);
+}
+
+FileData *FileData::map(const std::string &nativepath, uint64 offset, uint64 size, const std::string &filename)
+{
+	if (size == 0 || size > std::numeric_limits<size_t>::max())
+		return nullptr;
+
+	void *mapping = nullptr;
+	uint64 mapoffset = 0;
+
+#ifdef LOVE_WINDOWS
+
+	SYSTEM_INFO sysinfo = {};
+	GetSystemInfo(&sysinfo);
+	mapoffset = offset - (offset % sysinfo.dwAllocationGranularity);
+
+	HANDLE file = CreateFileW(to_widestr(nativepath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER filesize = {};
+	if (!GetFileSizeEx(file, &filesize) || offset + size > (uint64) filesize.QuadPart)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE filemapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (filemapping == nullptr)
+		return nullptr;
+
+	mapping = MapViewOfFile(filemapping, FILE_MAP_COPY, (DWORD) (mapoffset >> 32), (DWORD) (mapoffset & 0xFFFFFFFF), (SIZE_T) (offset - mapoffset + size));
+	CloseHandle(filemapping);
+
+	if (mapping == nullptr)
+		return nullptr;
+
+#else
+
+	long pagesize = sysconf(_SC_PAGESIZE);
+	mapoffset = offset - (offset % (uint64) (pagesize > 0 ? pagesize : 4096));
+
+	int fd = open(nativepath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	off_t filesize = lseek(fd, 0, SEEK_END);
+	if (filesize < 0 || offset + size > (uint64) filesize)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	// A private mapping means writes through getPointer() stay local to this
+	// FileData instead of faulting or modifying the file.
+	mapping = mmap(nullptr, (size_t) (offset - mapoffset + size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t) mapoffset);
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+#endif
+
+	FileData *filedata = new FileData(filename);
+	filedata->mapping = mapping;
+	filedata->mappingSize = (size_t) (offset - mapoffset + size);
+	filedata->data = (char *) mapping + (offset - mapoffset);
+	filedata->size = size;
+	return filedata;
+}
+
+void FileData::setFilename(const std::string &filename)
+{
+	this->filename = filename;
+
 	size_t dotpos = filename.rfind('.');
 
 	if (dotpos != std::string::npos)
@@ -58,6 +156,8 @@ FileData::FileData(uint64 size, const std::string &filename)
 
 FileData::FileData(const FileData &c)
 	: data(nullptr)
+	, mapping(nullptr)
+	, mappingSize(0)
 	, size(c.size)
 	, filename(c.filename)
 	, extension(c.extension)
@@ -76,7 +176,16 @@ FileData::FileData(const FileData &c)
 
 FileData::~FileData()
 {
-	delete [] data;
+	if (mapping != nullptr)
+	{
+#ifdef LOVE_WINDOWS
+		UnmapViewOfFile(mapping);
+#else
+		munmap(mapping, mappingSize);
+#endif
+	}
+	else
+		delete [] data;
 }
 
 FileData *FileData::clone() const
@@ -110,5 +219,10 @@ const std::string &FileData::getName() const
 	return name;
 }
 
+bool FileData::isMapped() const
+{
+	return mapping != nullptr;
+}
+
 } // filesystem
 } // love
@@ -43,6 +43,17 @@ class FileData : public Data
 
 	virtual ~FileData();
 
+	/**
+	 * Creates a FileData backed by a copy-on-write memory mapping of a region
+	 * of a file on disk, instead of an allocated copy. Returns null if the
+	 * region can't be mapped.
+	 * @param nativepath The full path to the file on disk (UTF-8).
+	 * @param offset The byte offset of the region within the file.
+	 * @param size The size in bytes of the region.
+	 * @param filename The filename used for file type identification.
+	 **/
+	static FileData *map(const std::string &nativepath, uint64 offset, uint64 size, const std::string &filename);
+
 	// Implements Data.
 	FileData *clone() const;
 	void *getData() const;
@@ -52,11 +63,24 @@ class FileData : public Data
 	const std::string &getExtension() const;
 	const std::string &getName() const;
 
+	/**
+	 * Gets whether the data is a memory mapping of a file, rather than a copy.
+	 **/
+	bool isMapped() const;
+
 private:
 
+	FileData(const std::string &filename);
+
+	void setFilename(const std::string &filename);
+
 	// The actual data.
 	char *data;
 
+	// The start and size of the memory mapping the data lives in, if any.
+	void *mapping;
+	size_t mappingSize;
+
 	// Size of the data.
 	uint64 size;
 
@@ -73,6 +73,13 @@ File *Filesystem::openNativeFile(const char *path, File::Mode mode) const
 	return new NativeFile(path, mode);
 }
 
+AsyncLoad *Filesystem::loadAsync(const char *filename, AsyncLoad::Kind kind, int priority)
+{
+	AsyncLoad *load = new AsyncLoad(this, filename, kind, priority);
+	load->start();
+	return load;
+}
+
 FileData *Filesystem::newFileData(const void *data, size_t size, const char *filename) const
 {
 	FileData *fd = new FileData(size, std::string(filename));
@@ -28,6 +28,7 @@
 #include "common/StringMap.h"
 #include "FileData.h"
 #include "File.h"
+#include "AsyncLoad.h"
 
 // C++
 #include <string>
@@ -106,6 +107,13 @@ class Filesystem : public Module
 		bool readonly;
 	};
 
+	struct ScanEntry
+	{
+		// Path relative to the scanned directory, using '/' separators.
+		std::string name;
+		Info info;
+	};
+
 	static love::Type type;
 
 	virtual ~Filesystem();
@@ -253,6 +261,22 @@ class Filesystem : public Module
 	virtual FileData *read(const char *filename, int64 size) const = 0;
 	virtual FileData *read(const char *filename) const = 0;
 
+	/**
+	 * Reads a file by memory-mapping it when it's stored uncompressed on
+	 * disk (in a directory, or a stored zip entry). Falls back to a regular
+	 * read otherwise.
+	 * @param filename The name of the file to read from.
+	 **/
+	virtual FileData *readMapped(const char *filename) const = 0;
+
+	/**
+	 * Starts reading and decoding a file on a worker thread.
+	 * @param filename The name of the file to load.
+	 * @param kind The kind of object to decode the file into.
+	 * @param priority Loads with a higher priority are started first.
+	 **/
+	AsyncLoad *loadAsync(const char *filename, AsyncLoad::Kind kind, int priority);
+
 	/**
 	 * Write data to a file.
 	 * @param filename The name of the file to write to.
@@ -275,6 +299,17 @@ class Filesystem : public Module
 	 **/
 	virtual bool getDirectoryItems(const char *dir, std::vector<std::string> &items) = 0;
 
+	/**
+	 * Gets the info of every item in a directory, sorted by name.
+	 * @param dir The directory to scan.
+	 * @param recursive Whether to include the contents of subdirectories.
+	 * @param cache Whether to reuse the entries from a previous scan of the
+	 *        same directory, if no directories have been modified since then.
+	 * @param entries Receives the entries.
+	 * @return False if the directory does not exist.
+	 **/
+	virtual bool scan(const char *dir, bool recursive, bool cache, std::vector<ScanEntry> &entries) = 0;
+
 	/**
 	 * Enable or disable symbolic link support in love.filesystem.
 	 **/
@@ -24,6 +24,8 @@
 
 #include "common/utf8.h"
 #include "common/b64.h"
+#include "thread/threads.h"
+#include "thread/ThreadPool.h"
 
 #include "Filesystem.h"
 #include "File.h"
@@ -44,6 +46,7 @@
 #	include <Knownfolders.h>
 #else
 #	include <sys/param.h>
+#	include <sys/stat.h>
 #	include <unistd.h>
 #endif
 
@@ -60,6 +63,8 @@
 #endif
 
 #include <string>
+#include <filesystem>
+#include <unordered_map>
 
 #ifdef LOVE_ANDROID
 #include <SDL3/SDL.h>
@@ -127,6 +132,537 @@ static bool isMounted(const std::string &path)
 	return mounted;
 }
 
+// A stored (uncompressed) entry in a zip archive.
+struct ZipEntry
+{
+	// Offset of the entry's local header, relative to the start of the file.
+	uint64 headerOffset;
+	uint64 size;
+};
+
+struct ZipIndex
+{
+	std::filesystem::file_time_type modtime;
+	std::unordered_map<std::string, ZipEntry> storedEntries;
+};
+
+static uint32 readLE(const uint8 *p, int bytes)
+{
+	uint32 v = 0;
+	for (int i = bytes - 1; i >= 0; i--)
+		v = (v << 8) | p[i];
+	return v;
+}
+
+static bool readNative(NativeFile &file, int64 offset, void *dst, int64 size)
+{
+	return file.seek(offset, File::SEEKORIGIN_BEGIN) && file.read(dst, size) == size;
+}
+
+// Reads the central directory of a zip archive and collects the entries that
+// can be used directly from disk. Zip64 archives aren't handled.
+static bool indexZipArchive(const std::string &path, ZipIndex &index)
+{
+	const int64 EOCD_SIZE = 22;
+	const int64 CENTRAL_HEADER_SIZE = 46;
+
+	try
+	{
+		NativeFile file(path, File::MODE_READ);
+
+		int64 filesize = file.getSize();
+		if (filesize < EOCD_SIZE)
+			return false;
+
+		// The end of central directory record is followed by a comment of up to
+		// 64KB, so search backwards for its signature.
+		int64 tailsize = std::min(filesize, EOCD_SIZE + 0xFFFF);
+		std::vector<uint8> tail((size_t) tailsize);
+		if (!readNative(file, filesize - tailsize, tail.data(), tailsize))
+			return false;
+
+		int64 eocd = -1;
+		for (int64 i = tailsize - EOCD_SIZE; i >= 0; i--)
+		{
+			if (readLE(&tail[(size_t) i], 4) == 0x06054b50)
+			{
+				eocd = i;
+				break;
+			}
+		}
+
+		if (eocd < 0)
+			return false;
+
+		const uint8 *record = &tail[(size_t) eocd];
+		uint32 entrycount = readLE(record + 10, 2);
+		uint32 cdsize = readLE(record + 12, 4);
+		uint32 cdoffset = readLE(record + 16, 4);
+
+		if (entrycount == 0xFFFF || cdsize == 0xFFFFFFFF || cdoffset == 0xFFFFFFFF)
+			return false;
+
+		// Archives appended to another file (such as a fused executable) have
+		// offsets relative to the start of the archive rather than the file.
+		int64 cdstart = filesize - tailsize + eocd - cdsize;
+		int64 bias = cdstart - cdoffset;
+		if (cdstart < 0 || bias < 0)
+			return false;
+
+		std::vector<uint8> cd(cdsize);
+		if (!readNative(file, cdstart, cd.data(), cdsize))
+			return false;
+
+		size_t pos = 0;
+		for (uint32 i = 0; i < entrycount; i++)
+		{
+			if (pos + CENTRAL_HEADER_SIZE > cd.size() || readLE(&cd[pos], 4) != 0x02014b50)
+				return false;
+
+			const uint8 *header = &cd[pos];
+			uint32 flags = readLE(header + 8, 2);
+			uint32 method = readLE(header + 10, 2);
+			uint32 compressedsize = readLE(header + 20, 4);
+			uint32 size = readLE(header + 24, 4);
+			uint32 namelen = readLE(header + 28, 2);
+			uint32 extralen = readLE(header + 30, 2);
+			uint32 commentlen = readLE(header + 32, 2);
+			uint32 headeroffset = readLE(header + 42, 4);
+
+			if (pos + CENTRAL_HEADER_SIZE + namelen > cd.size())
+				return false;
+
+			// Only unencrypted stored entries can be used as-is.
+			bool encrypted = (flags & 1) != 0;
+			if (method == 0 && !encrypted && compressedsize == size && headeroffset != 0xFFFFFFFF)
+			{
+				std::string name((const char *) header + CENTRAL_HEADER_SIZE, namelen);
+				index.storedEntries[name] = {(uint64) (headeroffset + bias), size};
+			}
+
+			pos += CENTRAL_HEADER_SIZE + namelen + extralen + commentlen;
+		}
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Finds the region of a file on disk which holds the contents of a stored zip
+// entry, using a cached index of the archive's central directory.
+static bool getZipEntryRegion(const std::string &archive, const std::string &name, uint64 &offset, uint64 &size)
+{
+	static love::thread::MutexRef mutex;
+	static std::unordered_map<std::string, ZipIndex> indices;
+
+	std::error_code ec;
+	auto modtime = std::filesystem::last_write_time(std::filesystem::u8path(archive), ec);
+	if (ec)
+		return false;
+
+	ZipEntry entry = {};
+
+	{
+		love::thread::Lock lock(mutex);
+
+		auto it = indices.find(archive);
+		if (it == indices.end() || it->second.modtime != modtime)
+		{
+			ZipIndex index;
+			index.modtime = modtime;
+			if (!indexZipArchive(archive, index))
+				index.storedEntries.clear();
+			it = indices.insert_or_assign(archive, std::move(index)).first;
+		}
+
+		auto entryit = it->second.storedEntries.find(name);
+		if (entryit == it->second.storedEntries.end())
+			return false;
+
+		entry = entryit->second;
+	}
+
+	// The local header's extra field can differ from the central directory's.
+	const int64 LOCAL_HEADER_SIZE = 30;
+	uint8 header[LOCAL_HEADER_SIZE];
+
+	try
+	{
+		NativeFile file(archive, File::MODE_READ);
+		if (!readNative(file, (int64) entry.headerOffset, header, LOCAL_HEADER_SIZE))
+			return false;
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	if (readLE(header, 4) != 0x04034b50)
+		return false;
+
+	offset = entry.headerOffset + LOCAL_HEADER_SIZE + readLE(header + 26, 2) + readLE(header + 28, 2);
+	size = entry.size;
+	return true;
+}
+
+// Creates a FileData which maps the file's contents directly from disk, if the
+// archive it's in allows that.
+static FileData *mapNativeFile(const char *filename)
+{
+	PHYSFS_Stat stat = {};
+	if (!PHYSFS_stat(filename, &stat) || stat.filetype != PHYSFS_FILETYPE_REGULAR || stat.filesize <= 0)
+		return nullptr;
+
+	const char *realdir = PHYSFS_getRealDir(filename);
+	const char *mountpoint = realdir != nullptr ? PHYSFS_getMountPoint(realdir) : nullptr;
+	if (realdir == nullptr || mountpoint == nullptr)
+		return nullptr;
+
+	// Get the path of the file relative to the root of its archive.
+	std::string path = filename;
+	while (!path.empty() && path[0] == '/')
+		path = path.substr(1);
+
+	std::string mount = mountpoint;
+	while (!mount.empty() && mount[0] == '/')
+		mount = mount.substr(1);
+
+	if (path.compare(0, mount.size(), mount) != 0)
+		return nullptr;
+
+	path = path.substr(mount.size());
+
+	std::error_code ec;
+	auto archivepath = std::filesystem::u8path(realdir);
+
+	if (std::filesystem::is_directory(archivepath, ec))
+	{
+		std::string nativepath = std::string(realdir) + LOVE_PATH_SEPARATOR + path;
+		return FileData::map(nativepath, 0, (uint64) stat.filesize, filename);
+	}
+	else if (std::filesystem::is_regular_file(archivepath, ec))
+	{
+		uint64 offset = 0;
+		uint64 size = 0;
+		if (getZipEntryRegion(realdir, path, offset, size) && size == (uint64) stat.filesize)
+			return FileData::map(realdir, offset, size, filename);
+	}
+
+	return nullptr;
+}
+
+// Gets the info of a file on disk, the same way PhysFS does for directories
+// in the search path. The stamp is the modification time at the highest
+// precision the platform offers, for detecting changes.
+static bool getNativeInfo(const std::string &path, Filesystem::Info &info, uint64 &stamp)
+{
+#ifdef LOVE_WINDOWS
+	WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+	if (!GetFileAttributesExW(to_widestr(path).c_str(), GetFileExInfoStandard, &attributes))
+		return false;
+
+	uint64 filetime = ((uint64) attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+
+	// FILETIMEs count 100 nanosecond intervals since 1601.
+	stamp = filetime;
+	info.modtime = (int64) (filetime / 10000000ULL) - 11644473600LL;
+	info.size = ((int64) attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+	info.readonly = (attributes.dwFileAttributes & FILE_ATTRIBUTE_READONLY) != 0;
+
+	if (attributes.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+		info.type = Filesystem::FILETYPE_SYMLINK;
+	else if (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		info.type = Filesystem::FILETYPE_DIRECTORY;
+	else
+		info.type = Filesystem::FILETYPE_FILE;
+#else
+	struct stat st = {};
+	if (lstat(path.c_str(), &st) != 0)
+		return false;
+
+#if defined(LOVE_MACOS) || defined(LOVE_IOS)
+	stamp = (uint64) st.st_mtimespec.tv_sec * 1000000000ULL + (uint64) st.st_mtimespec.tv_nsec;
+#elif defined(LOVE_LINUX) || defined(LOVE_ANDROID)
+	stamp = (uint64) st.st_mtim.tv_sec * 1000000000ULL + (uint64) st.st_mtim.tv_nsec;
+#else
+	stamp = (uint64) st.st_mtime;
+#endif
+
+	info.modtime = (int64) st.st_mtime;
+	info.size = (int64) st.st_size;
+	info.readonly = access(path.c_str(), W_OK) != 0;
+
+	if (S_ISREG(st.st_mode))
+		info.type = Filesystem::FILETYPE_FILE;
+	else if (S_ISDIR(st.st_mode))
+		info.type = Filesystem::FILETYPE_DIRECTORY;
+	else if (S_ISLNK(st.st_mode))
+		info.type = Filesystem::FILETYPE_SYMLINK;
+	else
+		info.type = Filesystem::FILETYPE_OTHER;
+#endif
+
+	if (info.type == Filesystem::FILETYPE_DIRECTORY)
+		info.size = 0;
+
+	return true;
+}
+
+// Gets the directories on disk which make up the given directory in the
+// search path, in search path order. Returns false if the search path has
+// anything other than plain directories in it which could affect the result,
+// such as archives or mount points inside the directory.
+static bool getNativeScanRoots(const std::string &dir, std::vector<std::string> &roots, std::string &signature)
+{
+	char **searchpath = PHYSFS_getSearchPath();
+	if (searchpath == nullptr)
+		return false;
+
+	bool native = true;
+
+	for (char **i = searchpath; *i != nullptr; i++)
+	{
+		const char *mountpoint = PHYSFS_getMountPoint(*i);
+		if (mountpoint == nullptr)
+		{
+			native = false;
+			break;
+		}
+
+		signature += std::string(*i) + "\n" + mountpoint + "\n";
+
+		std::string mount = mountpoint;
+		while (!mount.empty() && mount[0] == '/')
+			mount = mount.substr(1);
+		while (!mount.empty() && mount.back() == '/')
+			mount.pop_back();
+
+		std::string path;
+		if (mount.empty())
+			path = dir;
+		else if (dir == mount)
+			path.clear();
+		else if (dir.compare(0, mount.size() + 1, mount + "/") == 0)
+			path = dir.substr(mount.size() + 1);
+		else if (dir.empty() || mount.compare(0, dir.size() + 1, dir + "/") == 0)
+		{
+			// PhysFS creates virtual directories for these.
+			native = false;
+			break;
+		}
+		else
+			continue;
+
+		std::error_code ec;
+		if (!std::filesystem::is_directory(std::filesystem::u8path(*i), ec))
+		{
+			native = false;
+			break;
+		}
+
+		std::string nativepath = *i;
+		if (!path.empty())
+			nativepath += LOVE_PATH_SEPARATOR + path;
+
+		if (std::filesystem::is_directory(std::filesystem::u8path(nativepath), ec))
+			roots.push_back(nativepath);
+	}
+
+	PHYSFS_freeList(searchpath);
+	return native;
+}
+
+struct NativeScanEntry
+{
+	Filesystem::ScanEntry entry;
+	std::string nativePath;
+	size_t root;
+};
+
+struct NativeScanDirectory
+{
+	std::string nativePath;
+	std::string name;
+	size_t root;
+	uint64 stamp;
+};
+
+struct NativeScanCache
+{
+	std::string signature;
+	bool symlinks = false;
+	std::vector<NativeScanDirectory> directories;
+	std::vector<NativeScanEntry> entries;
+};
+
+// Lists the contents of one directory on disk.
+static void scanNativeDirectory(NativeScanDirectory &dir, bool symlinks, std::vector<NativeScanEntry> &entries)
+{
+	Filesystem::Info dirinfo = {};
+	if (!getNativeInfo(dir.nativePath, dirinfo, dir.stamp))
+		dir.stamp = 0;
+
+	std::error_code ec;
+	std::filesystem::directory_iterator it(std::filesystem::u8path(dir.nativePath), ec);
+
+	for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+	{
+		NativeScanEntry e;
+		std::string filename = it->path().filename().u8string();
+		e.nativePath = dir.nativePath + LOVE_PATH_SEPARATOR + filename;
+		e.entry.name = dir.name.empty() ? filename : dir.name + "/" + filename;
+		e.root = dir.root;
+
+		uint64 stamp = 0;
+		if (!getNativeInfo(e.nativePath, e.entry.info, stamp))
+			continue;
+
+		// PhysFS hides symlinks entirely when they aren't enabled.
+		if (!symlinks && e.entry.info.type == Filesystem::FILETYPE_SYMLINK)
+			continue;
+
+		entries.push_back(std::move(e));
+	}
+}
+
+// Walks directories on disk breadth-first, listing every directory in a level
+// of the hierarchy in parallel. Items found in earlier roots take precedence
+// over items with the same name in later roots, like the PhysFS search path.
+static void scanNativeRoots(const std::vector<std::string> &roots, bool recursive, bool symlinks, NativeScanCache &result)
+{
+	auto &pool = love::thread::ThreadPool::getShared();
+
+	std::vector<NativeScanDirectory> level;
+	for (size_t i = 0; i < roots.size(); i++)
+		level.push_back({roots[i], "", i, 0});
+
+	std::vector<NativeScanEntry> entries;
+
+	while (!level.empty())
+	{
+		std::vector<std::vector<NativeScanEntry>> found(level.size());
+
+		pool.parallelFor(level.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				scanNativeDirectory(level[i], symlinks, found[i]);
+		});
+
+		std::vector<NativeScanDirectory> next;
+
+		for (size_t i = 0; i < level.size(); i++)
+		{
+			for (NativeScanEntry &e : found[i])
+			{
+				if (recursive && e.entry.info.type == Filesystem::FILETYPE_DIRECTORY)
+					next.push_back({e.nativePath, e.entry.name, e.root, 0});
+				entries.push_back(std::move(e));
+			}
+
+			result.directories.push_back(std::move(level[i]));
+		}
+
+		level = std::move(next);
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), [](const NativeScanEntry &a, const NativeScanEntry &b)
+	{
+		if (a.entry.name != b.entry.name)
+			return a.entry.name < b.entry.name;
+		return a.root < b.root;
+	});
+
+	for (NativeScanEntry &e : entries)
+	{
+		if (result.entries.empty() || result.entries.back().entry.name != e.entry.name)
+			result.entries.push_back(std::move(e));
+	}
+}
+
+// Checks whether a previous scan is still accurate, and refreshes the info of
+// its entries if so. Adding, removing or renaming an item modifies its parent
+// directory, so only the entries themselves need to be checked again.
+static bool refreshNativeScan(NativeScanCache &cache)
+{
+	auto &pool = love::thread::ThreadPool::getShared();
+	std::vector<uint8> valid(cache.directories.size() + cache.entries.size(), 1);
+
+	pool.parallelFor(cache.directories.size(), 64, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			Filesystem::Info info = {};
+			uint64 stamp = 0;
+			if (!getNativeInfo(cache.directories[i].nativePath, info, stamp) || stamp != cache.directories[i].stamp)
+				valid[i] = 0;
+		}
+	});
+
+	if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+		return false;
+
+	size_t offset = cache.directories.size();
+
+	pool.parallelFor(cache.entries.size(), 64, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			Filesystem::Info &info = cache.entries[i].entry.info;
+			Filesystem::FileType type = info.type;
+			uint64 stamp = 0;
+			if (!getNativeInfo(cache.entries[i].nativePath, info, stamp) || info.type != type)
+				valid[offset + i] = 0;
+		}
+	});
+
+	return std::find(valid.begin(), valid.end(), 0) == valid.end();
+}
+
+// Walks a directory through PhysFS, for search paths with archives in them.
+static void scanPhysfsDirectory(const std::string &dir, const std::string &name, bool recursive, std::vector<Filesystem::ScanEntry> &entries)
+{
+	char **rc = PHYSFS_enumerateFiles(dir.c_str());
+	if (rc == nullptr)
+		return;
+
+	for (char **i = rc; *i != nullptr; i++)
+	{
+		Filesystem::ScanEntry e;
+		e.name = name.empty() ? *i : name + "/" + *i;
+
+		std::string path = dir.empty() ? *i : dir + "/" + *i;
+		PHYSFS_Stat stat = {};
+		if (!PHYSFS_stat(path.c_str(), &stat))
+			continue;
+
+		e.info.size = (int64) stat.filesize;
+		e.info.modtime = (int64) stat.modtime;
+		e.info.readonly = stat.readonly != 0;
+
+		if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
+			e.info.type = Filesystem::FILETYPE_FILE;
+		else if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
+			e.info.type = Filesystem::FILETYPE_DIRECTORY;
+		else if (stat.filetype == PHYSFS_FILETYPE_SYMLINK)
+			e.info.type = Filesystem::FILETYPE_SYMLINK;
+		else
+			e.info.type = Filesystem::FILETYPE_OTHER;
+
+		bool subdir = recursive && e.info.type == Filesystem::FILETYPE_DIRECTORY;
+		std::string subname = e.name;
+
+		entries.push_back(std::move(e));
+
+		if (subdir)
+			scanPhysfsDirectory(path, subname, recursive, entries);
+	}
+
+	PHYSFS_freeList(rc);
+}
+
 Filesystem::Filesystem()
 	: love::filesystem::Filesystem("love.filesystem.physfs")
 	, appendIdentityToPath(false)
@@ -448,7 +984,14 @@ bool Filesystem::mountFullPath(const char *archive, const char *mountpoint, Moun
 #endif
 
 	if (permissions == MOUNT_PERMISSIONS_READWRITE)
-		return PHYSFS_mountRW(canonarchive.c_str(), mountpoint, appendToPath) != 0;
+	{
+		love::thread::Lock lock(writableMountsMutex);
+		if (PHYSFS_mountRW(canonarchive.c_str(), mountpoint, appendToPath) == 0)
+			return false;
+
+		writableMounts.insert(canonarchive);
+		return true;
+	}
 
 	return PHYSFS_mount(canonarchive.c_str(), mountpoint, appendToPath) != 0;
 }
@@ -544,7 +1087,12 @@ bool Filesystem::unmountFullPath(const char *fullpath)
 
 	std::string canonpath = canonicalizeRealPath(fullpath);
 
-	return PHYSFS_unmount(canonpath.c_str()) != 0;
+	love::thread::Lock lock(writableMountsMutex);
+	if (PHYSFS_unmount(canonpath.c_str()) == 0)
+		return false;
+
+	writableMounts.erase(canonpath);
+	return true;
 }
 
 bool Filesystem::unmount(CommonPath path)
@@ -906,6 +1454,26 @@ FileData* Filesystem::read(const char* filename) const
 	return file.read();
 }
 
+FileData *Filesystem::readMapped(const char *filename) const
+{
+	if (!PHYSFS_isInit())
+		throw love::Exception("PhysFS is not initialized.");
+
+	{
+		love::thread::Lock lock(writableMountsMutex);
+
+		const char *realdir = PHYSFS_getRealDir(filename);
+		if (realdir == nullptr || writableMounts.count(realdir) != 0)
+			return read(filename);
+
+		FileData *data = mapNativeFile(filename);
+		if (data != nullptr)
+			return data;
+	}
+
+	return read(filename);
+}
+
 void Filesystem::write(const char *filename, const void *data, int64 size) const
 {
 	File file(filename, File::MODE_WRITE);
@@ -941,6 +1509,70 @@ bool Filesystem::getDirectoryItems(const char *dir, std::vector<std::string> &it
 	return true;
 }
 
+bool Filesystem::scan(const char *dir, bool recursive, bool cache, std::vector<ScanEntry> &entries)
+{
+	static love::thread::MutexRef mutex;
+	static std::unordered_map<std::string, NativeScanCache> caches;
+
+	if (!PHYSFS_isInit())
+		return false;
+
+	PHYSFS_Stat stat = {};
+	if (!PHYSFS_stat(dir, &stat) || stat.filetype != PHYSFS_FILETYPE_DIRECTORY)
+		return false;
+
+	std::string path = dir;
+	while (!path.empty() && path[0] == '/')
+		path = path.substr(1);
+	while (!path.empty() && path.back() == '/')
+		path.pop_back();
+
+	std::vector<std::string> roots;
+	std::string signature;
+	bool symlinks = areSymlinksEnabled();
+
+	if (!getNativeScanRoots(path, roots, signature))
+	{
+		scanPhysfsDirectory(path, "", recursive, entries);
+		std::sort(entries.begin(), entries.end(), [](const ScanEntry &a, const ScanEntry &b) { return a.name < b.name; });
+		return true;
+	}
+
+	std::string key = path + (recursive ? "\n1" : "\n0");
+	NativeScanCache result;
+
+	if (cache)
+	{
+		love::thread::Lock lock(mutex);
+		auto it = caches.find(key);
+		if (it != caches.end())
+		{
+			result = std::move(it->second);
+			caches.erase(it);
+		}
+	}
+
+	if (result.signature != signature || result.symlinks != symlinks || !refreshNativeScan(result))
+	{
+		result = NativeScanCache();
+		result.signature = signature;
+		result.symlinks = symlinks;
+		scanNativeRoots(roots, recursive, symlinks, result);
+	}
+
+	entries.reserve(entries.size() + result.entries.size());
+	for (const NativeScanEntry &e : result.entries)
+		entries.push_back(e.entry);
+
+	if (cache)
+	{
+		love::thread::Lock lock(mutex);
+		caches[key] = std::move(result);
+	}
+
+	return true;
+}
+
 void Filesystem::setSymlinksEnabled(bool enable)
 {
 	if (!PHYSFS_isInit())
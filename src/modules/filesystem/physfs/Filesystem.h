@@ -25,9 +25,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <set>
 
 // LOVE
 #include "filesystem/Filesystem.h"
+#include "thread/threads.h"
 
 namespace love
 {
@@ -88,10 +90,12 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	FileData *read(const char *filename, int64 size) const override;
 	FileData *read(const char *filename) const override;
+	FileData *readMapped(const char *filename) const override;
 	void write(const char *filename, const void *data, int64 size) const override;
 	void append(const char *filename, const void *data, int64 size) const override;
 
 	bool getDirectoryItems(const char *dir, std::vector<std::string> &items) override;
+	bool scan(const char *dir, bool recursive, bool cache, std::vector<ScanEntry> &entries) override;
 
 	void setSymlinksEnabled(bool enable) override;
 	bool areSymlinksEnabled() const override;
@@ -140,6 +144,11 @@ class Filesystem final : public love::filesystem::Filesystem
 
 	bool saveDirectoryNeedsMounting;
 
+	// Archives mounted with write access. Their files are never memory mapped,
+	// since a write could truncate a file out from under its mapping.
+	std::set<std::string> writableMounts;
+	mutable love::thread::MutexRef writableMountsMutex;
+
 }; // Filesystem
 
 } // physfs
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "wrap_AsyncLoad.h"
+
+namespace love
+{
+namespace filesystem
+{
+
+AsyncLoad *luax_checkasyncload(lua_State *L, int idx)
+{
+	return luax_checktype<AsyncLoad>(L, idx);
+}
+
+int w_AsyncLoad_getStatus(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	const char *str = nullptr;
+	if (!AsyncLoad::getConstant(load->getStatus(), str))
+		return luaL_error(L, "Unknown async load status.");
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_AsyncLoad_isDone(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	luax_pushboolean(L, load->isDone());
+	return 1;
+}
+
+int w_AsyncLoad_wait(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	double timeout = luaL_optnumber(L, 2, -1.0);
+	luax_pushboolean(L, load->wait(timeout));
+	return 1;
+}
+
+int w_AsyncLoad_cancel(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	luax_pushboolean(L, load->cancel());
+	return 1;
+}
+
+int w_AsyncLoad_getResult(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+
+	love::Type *type = nullptr;
+	Object *result = load->getResult(type);
+
+	if (result != nullptr)
+	{
+		luax_pushtype(L, *type, result);
+		return 1;
+	}
+
+	lua_pushnil(L);
+	if (!load->isDone())
+		return 1;
+
+	luax_pushstring(L, load->getError());
+	return 2;
+}
+
+int w_AsyncLoad_getFilename(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	luax_pushstring(L, load->getFilename());
+	return 1;
+}
+
+int w_AsyncLoad_getKind(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	const char *str = nullptr;
+	if (!AsyncLoad::getConstant(load->getKind(), str))
+		return luaL_error(L, "Unknown async load kind.");
+	lua_pushstring(L, str);
+	return 1;
+}
+
+int w_AsyncLoad_getPriority(lua_State *L)
+{
+	AsyncLoad *load = luax_checkasyncload(L, 1);
+	lua_pushinteger(L, load->getPriority());
+	return 1;
+}
+
+static const luaL_Reg w_AsyncLoad_functions[] =
+{
+	{ "getStatus", w_AsyncLoad_getStatus },
+	{ "isDone", w_AsyncLoad_isDone },
+	{ "wait", w_AsyncLoad_wait },
+	{ "cancel", w_AsyncLoad_cancel },
+	{ "getResult", w_AsyncLoad_getResult },
+	{ "getFilename", w_AsyncLoad_getFilename },
+	{ "getKind", w_AsyncLoad_getKind },
+	{ "getPriority", w_AsyncLoad_getPriority },
+	{ 0, 0 }
+};
+
+extern "C" int luaopen_asyncload(lua_State *L)
+{
+	return luax_register_type(L, &AsyncLoad::type, w_AsyncLoad_functions, nullptr);
+}
+
+} // filesystem
+} // love
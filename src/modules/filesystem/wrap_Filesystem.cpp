@@ -24,6 +24,7 @@
 #include "wrap_File.h"
 #include "wrap_NativeFile.h"
 #include "wrap_FileData.h"
+#include "wrap_AsyncLoad.h"
 #include "data/wrap_Data.h"
 #include "data/wrap_DataModule.h"
 
@@ -541,6 +542,35 @@ int w_exists(lua_State *L)
 	return 1;
 }
 
+// Sets the fields of the table at the top of the stack from a file's info.
+static void setInfoFields(lua_State *L, Filesystem::Info info)
+{
+	const char *typestr = nullptr;
+	if (!Filesystem::getConstant(info.type, typestr))
+		luaL_error(L, "Unknown file type.");
+
+	lua_pushstring(L, typestr);
+	lua_setfield(L, -2, "type");
+
+	luax_pushboolean(L, info.readonly);
+	lua_setfield(L, -2, "readonly");
+
+	// Lua numbers (doubles) can't fit the full range of 64 bit ints.
+	info.size = std::min<int64>(info.size, 0x20000000000000LL);
+	if (info.size >= 0)
+	{
+		lua_pushnumber(L, (lua_Number) info.size);
+		lua_setfield(L, -2, "size");
+	}
+
+	info.modtime = std::min<int64>(info.modtime, 0x20000000000000LL);
+	if (info.modtime >= 0)
+	{
+		lua_pushnumber(L, (lua_Number) info.modtime);
+		lua_setfield(L, -2, "modtime");
+	}
+}
+
 int w_getInfo(lua_State *L)
 {
 	const char *filepath = luaL_checkstring(L, 1);
@@ -565,35 +595,12 @@ int w_getInfo(lua_State *L)
 			return 1;
 		}
 
-		const char *typestr = nullptr;
-		if (!Filesystem::getConstant(info.type, typestr))
-			return luaL_error(L, "Unknown file type.");
-
 		if (lua_istable(L, startidx))
 			lua_pushvalue(L, startidx);
 		else
 			lua_createtable(L, 0, 3);
 
-		lua_pushstring(L, typestr);
-		lua_setfield(L, -2, "type");
-
-		luax_pushboolean(L, info.readonly);
-		lua_setfield(L, -2, "readonly");
-
-		// Lua numbers (doubles) can't fit the full range of 64 bit ints.
-		info.size = std::min<int64>(info.size, 0x20000000000000LL);
-		if (info.size >= 0)
-		{
-			lua_pushnumber(L, (lua_Number) info.size);
-			lua_setfield(L, -2, "size");
-		}
-
-		info.modtime = std::min<int64>(info.modtime, 0x20000000000000LL);
-		if (info.modtime >= 0)
-		{
-			lua_pushnumber(L, (lua_Number) info.modtime);
-			lua_setfield(L, -2, "modtime");
-		}
+		setInfoFields(L, info);
 	}
 	else
 		lua_pushnil(L);
@@ -658,6 +665,66 @@ int w_read(lua_State *L)
 	return 2;
 }
 
+int w_readMapped(lua_State *L)
+{
+	const char *filename = luaL_checkstring(L, 1);
+
+	FileData *data = nullptr;
+	try
+	{
+		data = instance()->readMapped(filename);
+	}
+	catch (love::Exception &e)
+	{
+		return luax_ioError(L, "%s", e.what());
+	}
+
+	luax_pushtype(L, data);
+	data->release();
+	return 1;
+}
+
+int w_loadAsync(lua_State *L)
+{
+	AsyncLoad::Kind kind = AsyncLoad::KIND_FILEDATA;
+	const char *kindstr = lua_isnoneornil(L, 2) ? nullptr : luaL_checkstring(L, 2);
+	if (kindstr != nullptr && !AsyncLoad::getConstant(kindstr, kind))
+		return luax_enumerror(L, "async load kind", AsyncLoad::getConstants(kind), kindstr);
+
+	int priority = (int) luaL_optinteger(L, 3, 0);
+
+	if (lua_istable(L, 1))
+	{
+		int count = (int) luax_objlen(L, 1);
+		lua_createtable(L, count, 0);
+
+		for (int i = 1; i <= count; i++)
+		{
+			lua_rawgeti(L, 1, i);
+			const char *filename = luaL_checkstring(L, -1);
+
+			AsyncLoad *load = nullptr;
+			luax_catchexcept(L, [&]() { load = instance()->loadAsync(filename, kind, priority); });
+			lua_pop(L, 1);
+
+			luax_pushtype(L, load);
+			load->release();
+			lua_rawseti(L, -2, i);
+		}
+
+		return 1;
+	}
+
+	const char *filename = luaL_checkstring(L, 1);
+
+	AsyncLoad *load = nullptr;
+	luax_catchexcept(L, [&]() { load = instance()->loadAsync(filename, kind, priority); });
+
+	luax_pushtype(L, load);
+	load->release();
+	return 1;
+}
+
 static int w_write_or_append(lua_State *L, File::Mode mode)
 {
 	const char *filename = luaL_checkstring(L, 1);
@@ -724,6 +791,94 @@ int w_getDirectoryItems(lua_State *L)
 	return 1;
 }
 
+int w_scan(lua_State *L)
+{
+	const char *dir = luaL_checkstring(L, 1);
+
+	bool recursive = false;
+	bool cache = false;
+	Filesystem::FileType filtertype = Filesystem::FILETYPE_MAX_ENUM;
+	bool hasfilterfunc = false;
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+
+		lua_getfield(L, 2, "recursive");
+		recursive = luax_toboolean(L, -1);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 2, "cache");
+		cache = luax_toboolean(L, -1);
+		lua_pop(L, 1);
+
+		// The filter can be a file type or a function which receives each
+		// item's name and type, and returns whether to include it.
+		lua_getfield(L, 2, "filter");
+		if (lua_type(L, -1) == LUA_TSTRING)
+		{
+			const char *typestr = lua_tostring(L, -1);
+			if (!Filesystem::getConstant(typestr, filtertype))
+				return luax_enumerror(L, "file type", Filesystem::getConstants(filtertype), typestr);
+			lua_pop(L, 1);
+		}
+		else if (lua_isfunction(L, -1))
+			hasfilterfunc = true;
+		else if (!lua_isnil(L, -1))
+			return luaL_argerror(L, 2, "filter must be a file type or a function");
+		else
+			lua_pop(L, 1);
+	}
+
+	std::vector<Filesystem::ScanEntry> entries;
+	bool success = false;
+	luax_catchexcept(L, [&]() { success = instance()->scan(dir, recursive, cache, entries); });
+
+	if (!success)
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	int filterfuncidx = lua_gettop(L);
+	lua_createtable(L, (int) entries.size(), 0);
+
+	int count = 0;
+	for (const Filesystem::ScanEntry &e : entries)
+	{
+		if (filtertype != Filesystem::FILETYPE_MAX_ENUM && e.info.type != filtertype)
+			continue;
+
+		if (hasfilterfunc)
+		{
+			const char *typestr = nullptr;
+			Filesystem::getConstant(e.info.type, typestr);
+
+			lua_pushvalue(L, filterfuncidx);
+			lua_pushstring(L, e.name.c_str());
+			lua_pushstring(L, typestr);
+			lua_call(L, 2, 1);
+
+			bool include = luax_toboolean(L, -1);
+			lua_pop(L, 1);
+
+			if (!include)
+				continue;
+		}
+
+		lua_createtable(L, 0, 5);
+
+		lua_pushstring(L, e.name.c_str());
+		lua_setfield(L, -2, "name");
+
+		setInfoFields(L, e.info);
+
+		lua_rawseti(L, -2, ++count);
+	}
+
+	return 1;
+}
+
 int w_lines(lua_State *L)
 {
 	if (lua_isstring(L, 1))
@@ -1080,9 +1235,12 @@ static const luaL_Reg functions[] =
 	{ "createDirectory", w_createDirectory },
 	{ "remove", w_remove },
 	{ "read", w_read },
+	{ "readMapped", w_readMapped },
+	{ "loadAsync", w_loadAsync },
 	{ "write", w_write },
 	{ "append", w_append },
 	{ "getDirectoryItems", w_getDirectoryItems },
+	{ "scan", w_scan },
 	{ "lines", w_lines },
 	{ "load", w_load },
 	{ "exists", w_exists },
@@ -1106,6 +1264,7 @@ static const lua_CFunction types[] =
 	luaopen_file,
 	luaopen_nativefile,
 	luaopen_filedata,
+	luaopen_asyncload,
 	0
 };
 
@@ -23,6 +23,7 @@
 
 // LOVE
 #include "font/Font.h"
+#include "thread/threads.h"
 
 // FreeType2
 #include <ft2build.h>
@@ -52,6 +53,10 @@ class Font : public love::font::Font
 	// FreeType library
 	FT_Library library;
 
+	// Faces are created and destroyed on any thread which loads or releases
+	// a Rasterizer, but the library doesn't allow that concurrently.
+	love::thread::MutexRef libraryMutex;
+
 }; // Font
 
 } // freetype
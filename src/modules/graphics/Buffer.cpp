@@ -31,6 +31,8 @@ love::Type Buffer::type("GraphicsBuffer", &Object::type);
 
 int Buffer::bufferCount = 0;
 int64 Buffer::totalGraphicsMemory = 0;
+int Buffer::uploadCount = 0;
+int64 Buffer::uploadBytes = 0;
 
 Buffer::Buffer(Graphics *gfx, const Settings &settings, const std::vector<DataDeclaration> &bufferformat, size_t size, size_t arraylength)
 	: arrayLength(0)
@@ -52,6 +52,11 @@ class Buffer : public love::Object, public Resource
 	static int bufferCount;
 	static int64 totalGraphicsMemory;
 
+	// Number of fill calls and bytes uploaded through them since the last
+	// present.
+	static int uploadCount;
+	static int64 uploadBytes;
+
 	static const size_t SHADER_STORAGE_BUFFER_MAX_STRIDE = 2048;
 
 	enum MapType
@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "FrameRecorder.h"
+#include "Graphics.h"
+#include "image/Image.h"
+#include "image/ImageData.h"
+#include "filesystem/Filesystem.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+
+namespace love
+{
+namespace graphics
+{
+
+// Converts bottom-to-top RGBA8 rows to top-to-bottom planar YUV 4:2:0.
+static void convertToYUV420(const uint8 *rgba, int w, int h, uint8 *yuv)
+{
+	int cw = (w + 1) / 2;
+	int ch = (h + 1) / 2;
+
+	uint8 *yplane = yuv;
+	uint8 *uplane = yplane + (size_t) w * h;
+	uint8 *vplane = uplane + (size_t) cw * ch;
+
+	auto row = [&](int y) { return rgba + (size_t) (h - 1 - y) * w * 4; };
+
+	for (int y = 0; y < h; y++)
+	{
+		const uint8 *src = row(y);
+		uint8 *dst = yplane + (size_t) y * w;
+
+		for (int x = 0; x < w; x++, src += 4)
+			dst[x] = (uint8) (((66 * src[0] + 129 * src[1] + 25 * src[2] + 128) >> 8) + 16);
+	}
+
+	for (int cy = 0; cy < ch; cy++)
+	{
+		const uint8 *row0 = row(cy * 2);
+		const uint8 *row1 = row(std::min(cy * 2 + 1, h - 1));
+
+		for (int cx = 0; cx < cw; cx++)
+		{
+			int x0 = cx * 2 * 4;
+			int x1 = std::min(cx * 2 + 1, w - 1) * 4;
+
+			int r = (row0[x0 + 0] + row0[x1 + 0] + row1[x0 + 0] + row1[x1 + 0] + 2) >> 2;
+			int g = (row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1] + 2) >> 2;
+			int b = (row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2] + 2) >> 2;
+
+			uplane[(size_t) cy * cw + cx] = (uint8) (((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+			vplane[(size_t) cy * cw + cx] = (uint8) (((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+		}
+	}
+}
+
+FrameRecorder::FrameRecorder(Graphics *gfx, const Settings &settings)
+	: gfx(gfx)
+	, settings(settings)
+	, stats()
+	, slots(std::max(settings.maxPendingFrames, 1))
+{
+	if (settings.interval < 1)
+		throw love::Exception("Recording interval must be at least 1.");
+
+	if (settings.maxPendingFrames < 1)
+		throw love::Exception("Maximum pending recorded frames must be at least 1.");
+
+	auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		throw love::Exception("love.filesystem must be loaded in order to record frames.");
+
+	if (Module::getInstance<image::Image>(Module::M_IMAGE) == nullptr)
+		throw love::Exception("love.image must be loaded in order to record frames.");
+
+	if (!settings.directory.empty() && !fs->createDirectory(settings.directory.c_str()))
+		throw love::Exception("Could not create recording directory '%s'.", settings.directory.c_str());
+}
+
+FrameRecorder::~FrameRecorder()
+{
+	finish();
+}
+
+void FrameRecorder::presentFrame(int width, int height)
+{
+	update();
+
+	int64 frame = stats.presentedFrames++;
+	if (frame % settings.interval != 0)
+		return;
+
+	Slot *slot = acquireSlot(width, height);
+
+	if (slot == nullptr)
+	{
+		love::thread::Lock lock(mutex);
+		stats.droppedFrames++;
+		return;
+	}
+
+	Rect rect = {0, 0, width, height};
+	slot->readback.set(gfx->newBackbufferReadbackInternal(rect, slot->imageData), Acquire::NORETAIN);
+	slot->frame = frame;
+
+	love::thread::Lock lock(mutex);
+	slot->state = SLOT_READBACK;
+	stats.capturedFrames++;
+}
+
+void FrameRecorder::update()
+{
+	for (Slot &slot : slots)
+	{
+		// Only this thread moves slots out of readback, but workers change the
+		// state of slots they're encoding.
+		{
+			love::thread::Lock lock(mutex);
+			if (slot.state != SLOT_READBACK)
+				continue;
+		}
+
+		slot.readback->update();
+		if (!slot.readback->isComplete())
+			continue;
+
+		bool error = slot.readback->hasError();
+		slot.readback.set(nullptr);
+
+		{
+			love::thread::Lock lock(mutex);
+			slot.state = error ? SLOT_FREE : SLOT_ENCODING;
+			if (error)
+				stats.failedFrames++;
+		}
+
+		if (!error)
+		{
+			Slot *s = &slot;
+			love::thread::ThreadPool::getShared().submit([this, s]() { encode(s); });
+		}
+	}
+}
+
+FrameRecorder::Slot *FrameRecorder::acquireSlot(int width, int height)
+{
+	while (true)
+	{
+		Slot *oldestreadback = nullptr;
+
+		{
+			love::thread::Lock lock(mutex);
+
+			for (Slot &slot : slots)
+			{
+				if (slot.state == SLOT_FREE)
+				{
+					image::ImageData *img = slot.imageData.get();
+					if (img == nullptr || img->getWidth() != width || img->getHeight() != height)
+					{
+						auto module = Module::getInstance<image::Image>(Module::M_IMAGE);
+						slot.imageData.set(module->newImageData(width, height, PIXELFORMAT_RGBA8_UNORM, nullptr), Acquire::NORETAIN);
+					}
+					return &slot;
+				}
+				else if (slot.state == SLOT_READBACK && (oldestreadback == nullptr || slot.frame < oldestreadback->frame))
+					oldestreadback = &slot;
+			}
+
+			if (!settings.wait)
+				return nullptr;
+
+			// Every slot is being encoded, so wait for a worker to finish one.
+			if (oldestreadback == nullptr)
+			{
+				cond->wait(mutex);
+				continue;
+			}
+		}
+
+		oldestreadback->readback->wait();
+		update();
+	}
+}
+
+std::string FrameRecorder::getFilename(int64 frame) const
+{
+	const char *ext = "png";
+	getConstant(settings.format, ext);
+
+	char name[64];
+	snprintf(name, sizeof(name), "%08lld.%s", (long long) frame, ext);
+
+	if (settings.directory.empty())
+		return name;
+
+	return settings.directory + "/" + name;
+}
+
+void FrameRecorder::encode(Slot *slot)
+{
+	bool success = true;
+
+	try
+	{
+		image::ImageData *img = slot->imageData;
+		std::string filename = getFilename(slot->frame);
+
+		if (settings.format == FORMAT_YUV)
+		{
+			int w = img->getWidth();
+			int h = img->getHeight();
+			std::vector<uint8> yuv((size_t) w * h + 2 * (size_t) ((w + 1) / 2) * ((h + 1) / 2));
+			convertToYUV420((const uint8 *) img->getData(), w, h, yuv.data());
+
+			auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+			fs->write(filename.c_str(), yuv.data(), (int64) yuv.size());
+		}
+		else
+		{
+			image::FormatHandler::EncodedFormat format = image::FormatHandler::ENCODED_PNG;
+			if (settings.format == FORMAT_QOI)
+				format = image::FormatHandler::ENCODED_QOI;
+			else if (settings.format == FORMAT_TGA)
+				format = image::FormatHandler::ENCODED_TGA;
+
+			// Frames are written continuously, so favour speed over file size.
+			image::FormatHandler::EncodeSettings encodesettings;
+			encodesettings.compressionLevel = 1;
+
+			fixBackbufferReadbackPixels(img);
+			img->encode(format, filename.c_str(), true, encodesettings)->release();
+		}
+	}
+	catch (std::exception &)
+	{
+		success = false;
+	}
+
+	love::thread::Lock lock(mutex);
+
+	slot->state = SLOT_FREE;
+	if (success)
+		stats.writtenFrames++;
+	else
+		stats.failedFrames++;
+
+	cond->broadcast();
+}
+
+void FrameRecorder::finish()
+{
+	for (Slot &slot : slots)
+	{
+		bool inreadback = false;
+		{
+			love::thread::Lock lock(mutex);
+			inreadback = slot.state == SLOT_READBACK;
+		}
+
+		if (inreadback)
+			slot.readback->wait();
+	}
+
+	update();
+
+	love::thread::Lock lock(mutex);
+
+	while (std::any_of(slots.begin(), slots.end(), [](const Slot &slot) { return slot.state != SLOT_FREE; }))
+		cond->wait(mutex);
+}
+
+FrameRecorder::Stats FrameRecorder::getStats() const
+{
+	love::thread::Lock lock(mutex);
+
+	Stats s = stats;
+	s.pendingFrames = (int) std::count_if(slots.begin(), slots.end(), [](const Slot &slot) { return slot.state != SLOT_FREE; });
+
+	return s;
+}
+
+STRINGMAP_CLASS_BEGIN(FrameRecorder, FrameRecorder::Format, FrameRecorder::FORMAT_MAX_ENUM, format)
+{
+	{ "png", FrameRecorder::FORMAT_PNG },
+	{ "qoi", FrameRecorder::FORMAT_QOI },
+	{ "tga", FrameRecorder::FORMAT_TGA },
+	{ "yuv", FrameRecorder::FORMAT_YUV },
+}
+STRINGMAP_CLASS_END(FrameRecorder, FrameRecorder::Format, FrameRecorder::FORMAT_MAX_ENUM, format)
+
+} // graphics
+} // love
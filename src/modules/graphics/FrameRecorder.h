@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/config.h"
+#include "common/int.h"
+#include "common/Object.h"
+#include "common/StringMap.h"
+#include "thread/threads.h"
+#include "GraphicsReadback.h"
+
+// C++
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+
+class Graphics;
+
+/**
+ * Captures every Nth presented frame into a fixed set of reusable slots, and
+ * encodes and writes the captured frames to the save directory on worker
+ * threads. Frames which arrive while every slot is busy are dropped, unless
+ * the recorder is set to wait for a free slot.
+ **/
+class FrameRecorder
+{
+public:
+
+	enum Format
+	{
+		FORMAT_PNG,
+		FORMAT_QOI,
+		FORMAT_TGA,
+		FORMAT_YUV, // Planar 4:2:0, BT.601 limited range.
+		FORMAT_MAX_ENUM
+	};
+
+	struct Settings
+	{
+		Format format = FORMAT_PNG;
+		std::string directory = "recording";
+		int interval = 1;
+		int maxPendingFrames = 4;
+		bool wait = false;
+	};
+
+	struct Stats
+	{
+		int64 presentedFrames = 0;
+		int64 capturedFrames = 0;
+		int64 droppedFrames = 0;
+		int64 writtenFrames = 0;
+		int64 failedFrames = 0;
+		int pendingFrames = 0;
+	};
+
+	FrameRecorder(Graphics *gfx, const Settings &settings);
+	~FrameRecorder();
+
+	/**
+	 * Called by the graphics backend for each presented frame, before the
+	 * backbuffer is swapped.
+	 **/
+	void presentFrame(int width, int height);
+
+	/**
+	 * Blocks until every captured frame has been written.
+	 **/
+	void finish();
+
+	Stats getStats() const;
+	const Settings &getSettings() const { return settings; }
+
+	STRINGMAP_CLASS_DECLARE(Format);
+
+private:
+
+	enum SlotState
+	{
+		SLOT_FREE,
+		SLOT_READBACK,
+		SLOT_ENCODING,
+	};
+
+	struct Slot
+	{
+		SlotState state = SLOT_FREE;
+		int64 frame = 0;
+		StrongRef<image::ImageData> imageData;
+		StrongRef<GraphicsReadback> readback;
+	};
+
+	void update();
+	Slot *acquireSlot(int width, int height);
+	void encode(Slot *slot);
+	std::string getFilename(int64 frame) const;
+
+	Graphics *gfx;
+	Settings settings;
+	Stats stats;
+
+	std::vector<Slot> slots;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+}; // FrameRecorder
+
+} // graphics
+} // love
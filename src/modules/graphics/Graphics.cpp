@@ -33,10 +33,14 @@
 #include "TextBatch.h"
 #include "common/deprecation.h"
 #include "common/config.h"
+#include "common/memory.h"
+#include "image/ImageData.h"
+#include "thread/ThreadPool.h"
 
 // C++
 #include <algorithm>
 #include <tuple>
+#include <thread>
 #include <stdlib.h>
 
 namespace love
@@ -219,7 +223,10 @@ Graphics::Graphics(const char *name)
 	, backbufferSettings()
 	, created(false)
 	, active(true)
+	, frameRecorder(nullptr)
+	, profiler(nullptr)
 	, batchedDrawState()
+	, textureUploadBuffer(nullptr)
 	, deviceProjectionMatrix()
 	, renderTargetSwitchCount(0)
 	, drawCalls(0)
@@ -279,10 +286,28 @@ Graphics::~Graphics()
 		batchedDrawState.vb[1]->release();
 	if (batchedDrawState.indexBuffer)
 		batchedDrawState.indexBuffer->release();
+	if (textureUploadBuffer)
+		textureUploadBuffer->release();
 
 	for (int i = 0; i < (int) SHADERSTAGE_MAX_ENUM; i++)
 		cachedShaderStages[i].clear();
 
+	delete frameRecorder;
+	delete profiler;
+
+	// The backend should have finished these while its context was alive.
+	for (PendingScreenshot *screenshot : pendingScreenshots)
+	{
+		while (screenshot->submitted && !screenshot->processed.load(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		for (const auto &info : screenshot->callbacks)
+			info.callback(&info, nullptr, nullptr);
+
+		delete screenshot;
+	}
+	pendingScreenshots.clear();
+
 	pendingReadbacks.clear();
 	clearTemporaryResources();
 
@@ -348,9 +373,9 @@ Video *Graphics::newVideo(love::video::VideoStream *stream, float dpiscale)
 	return new Video(this, stream, dpiscale);
 }
 
-love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage)
+love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, bool instanced)
 {
-	return new SpriteBatch(this, texture, size, usage);
+	return new SpriteBatch(this, texture, size, usage, instanced);
 }
 
 love::graphics::ParticleSystem *Graphics::newParticleSystem(Texture *texture, int size)
@@ -1481,6 +1506,106 @@ void Graphics::updatePendingReadbacks()
 	}
 }
 
+void Graphics::queueScreenshotReadback(GraphicsReadback *readback)
+{
+	PendingScreenshot *screenshot = new PendingScreenshot();
+	screenshot->callbacks = std::move(pendingScreenshotCallbacks);
+	screenshot->readback.set(readback, Acquire::NORETAIN);
+
+	pendingScreenshotCallbacks.clear();
+	pendingScreenshots.push_back(screenshot);
+}
+
+void Graphics::updatePendingScreenshots(void *screenshotCallbackData)
+{
+	for (PendingScreenshot *screenshot : pendingScreenshots)
+	{
+		if (screenshot->submitted)
+			continue;
+
+		screenshot->readback->update();
+		if (!screenshot->readback->isComplete())
+			continue;
+
+		screenshot->submitted = true;
+
+		image::ImageData *imagedata = screenshot->readback->getImageData();
+		if (screenshot->readback->hasError() || imagedata == nullptr)
+		{
+			screenshot->processed.store(true, std::memory_order_release);
+			continue;
+		}
+
+		// The readback (and its ImageData) stays alive until processed is set.
+		love::thread::ThreadPool::getShared().submit([screenshot, imagedata]()
+		{
+			fixBackbufferReadbackPixels(imagedata);
+			screenshot->processed.store(true, std::memory_order_release);
+		});
+	}
+
+	// Screenshots are delivered in the order they were captured.
+	while (!pendingScreenshots.empty() && pendingScreenshots.front()->processed.load(std::memory_order_acquire))
+	{
+		PendingScreenshot *screenshot = pendingScreenshots.front();
+		pendingScreenshots.erase(pendingScreenshots.begin());
+
+		image::ImageData *imagedata = nullptr;
+		if (!screenshot->readback->hasError())
+			imagedata = screenshot->readback->getImageData();
+
+		for (int i = 0; i < (int) screenshot->callbacks.size(); i++)
+		{
+			const auto &info = screenshot->callbacks[i];
+
+			try
+			{
+				if (imagedata == nullptr)
+				{
+					info.callback(&info, nullptr, nullptr);
+					continue;
+				}
+
+				// Each callback gets its own copy, since they may modify it.
+				StrongRef<image::ImageData> img(imagedata);
+				if (i > 0)
+					img.set(imagedata->clone(), Acquire::NORETAIN);
+
+				info.callback(&info, img, screenshotCallbackData);
+			}
+			catch (...)
+			{
+				for (int j = i + 1; j < (int) screenshot->callbacks.size(); j++)
+				{
+					const auto &ninfo = screenshot->callbacks[j];
+					ninfo.callback(&ninfo, nullptr, nullptr);
+				}
+				delete screenshot;
+				throw;
+			}
+		}
+
+		delete screenshot;
+	}
+}
+
+void Graphics::finishPendingScreenshots()
+{
+	for (PendingScreenshot *screenshot : pendingScreenshots)
+	{
+		if (!screenshot->submitted)
+			screenshot->readback->wait();
+	}
+
+	updatePendingScreenshots(nullptr);
+
+	while (!pendingScreenshots.empty())
+	{
+		std::this_thread::yield();
+		updatePendingScreenshots(nullptr);
+	}
+}
+
 VertexAttributesID Graphics::registerVertexAttributes(const VertexAttributes &attributes)
 {
 	for (size_t i = 0; i < vertexAttributesDatabase.size(); i++)
@@ -1678,6 +1803,99 @@ void Graphics::captureScreenshot(const ScreenshotInfo &info)
 	pendingScreenshotCallbacks.push_back(info);
 }
 
+void Graphics::startRecording(const FrameRecorder::Settings &settings)
+{
+	if (frameRecorder != nullptr)
+		throw love::Exception("Frames are already being recorded.");
+
+	if (!isBackbufferReadbackSupported())
+		throw love::Exception("Frame recording is not supported with the current graphics backend.");
+
+	frameRecorder = new FrameRecorder(this, settings);
+}
+
+FrameRecorder::Stats Graphics::stopRecording()
+{
+	if (frameRecorder == nullptr)
+		return FrameRecorder::Stats();
+
+	frameRecorder->finish();
+	FrameRecorder::Stats stats = frameRecorder->getStats();
+
+	delete frameRecorder;
+	frameRecorder = nullptr;
+
+	return stats;
+}
+
+bool Graphics::isRecording() const
+{
+	return frameRecorder != nullptr;
+}
+
+FrameRecorder::Stats Graphics::getRecordingStats() const
+{
+	if (frameRecorder == nullptr)
+		return FrameRecorder::Stats();
+
+	return frameRecorder->getStats();
+}
+
+void Graphics::startProfiling(const Profiler::Settings &settings)
+{
+	if (profiler != nullptr)
+		throw love::Exception("Profiling has already been started.");
+
+	profiler = new Profiler(settings.gpu ? getGPUTimer() : nullptr, settings);
+}
+
+void Graphics::stopProfiling()
+{
+	delete profiler;
+	profiler = nullptr;
+}
+
+bool Graphics::isProfiling() const
+{
+	return profiler != nullptr;
+}
+
+void Graphics::pushProfileZone(const char *name)
+{
+	if (profiler == nullptr)
+		return;
+
+	// The zone's GPU time should only include draws made inside it.
+	if (profiler->isGPUTimingEnabled())
+		flushBatchedDraws();
+
+	profiler->pushZone(name);
+}
+
+void Graphics::popProfileZone()
+{
+	if (profiler == nullptr)
+		return;
+
+	if (profiler->isGPUTimingEnabled())
+		flushBatchedDraws();
+
+	profiler->popZone();
+}
+
+int Graphics::saveProfile(const std::string &filename) const
+{
+	if (profiler == nullptr)
+		throw love::Exception("Profiling has not been started.");
+
+	return profiler->saveChromeTrace(filename);
+}
+
+GraphicsReadback *Graphics::newBackbufferReadbackInternal(const Rect &/*rect*/, image::ImageData */*dest*/)
+{
+	throw love::Exception("Backbuffer readback is not supported with the current graphics backend.");
+}
+
 void Graphics::copyBuffer(Buffer *source, Buffer *dest, size_t sourceoffset, size_t destoffset, size_t size)
 {
 	Range sourcerange(sourceoffset, size);
@@ -1876,6 +2094,28 @@ void Graphics::copyBufferToTexture(Buffer *source, Texture *dest, size_t sourceo
 	dest->copyFromBuffer(source, sourceoffset, sourcewidth, size, slice, mipmap, rect);
 }
 
+StreamBuffer *Graphics::getTextureUploadBuffer(size_t size)
+{
+	if (textureUploadBuffer != nullptr && textureUploadBuffer->getUsableSize() >= size)
+		return textureUploadBuffer;
+
+	// Grow the buffer when a frame needs more than it can hold. A buffer which
+	// is still in use by the GPU is kept alive by the backend until it's done.
+	size_t buffersize = std::max(size, (size_t) 1024 * 1024);
+	if (textureUploadBuffer != nullptr)
+		buffersize = std::max(buffersize, textureUploadBuffer->getSize() * 2);
+
+	buffersize = alignUp(buffersize, (size_t) 256);
+
+	StreamBuffer *buffer = newStreamBuffer(BUFFERUSAGE_VERTEX, buffersize);
+
+	if (textureUploadBuffer != nullptr)
+		textureUploadBuffer->release();
+
+	textureUploadBuffer = buffer;
+	return textureUploadBuffer;
+}
+
 static const char *getIndirectArgsTypeName(Graphics::IndirectArgsType argstype)
 {
 	switch (argstype)
@@ -2768,6 +3008,10 @@ Graphics::Stats Graphics::getStats() const
 	stats.buffers = Buffer::bufferCount;
 	stats.textureMemory = Texture::totalGraphicsMemory;
 	stats.bufferMemory = Buffer::totalGraphicsMemory;
+	stats.bufferUploads = Buffer::uploadCount;
+	stats.bufferUploadBytes = Buffer::uploadBytes;
+	stats.videoUploadBytes = Video::uploadBytes;
+	stats.videoUploadTime = Video::uploadTime;
 
 	return stats;
 }
@@ -38,6 +38,8 @@
 #include "Quad.h"
 #include "Mesh.h"
 #include "GraphicsReadback.h"
+#include "FrameRecorder.h"
+#include "Profiler.h"
 #include "Deprecations.h"
 #include "renderstate.h"
 #include "math/Transform.h"
@@ -49,6 +51,7 @@
 // C++
 #include <string>
 #include <vector>
+#include <atomic>
 
 namespace love
 {
@@ -232,6 +235,10 @@ class Graphics : public Module
 		int buffers;
 		int64 textureMemory;
 		int64 bufferMemory;
+		int bufferUploads;
+		int64 bufferUploadBytes;
+		int64 videoUploadBytes;
+		double videoUploadTime;
 	};
 
 	struct DrawCommand
@@ -485,7 +492,7 @@ class Graphics : public Module
 	Font *newDefaultFont(int size, const font::TrueTypeRasterizer::Settings &settings);
 	Video *newVideo(love::video::VideoStream *stream, float dpiscale);
 
-	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage);
+	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, bool instanced = false);
 	ParticleSystem *newParticleSystem(Texture *texture, int size);
 
 	Shader *newShader(const std::vector<std::string> &stagessource, const Shader::CompileOptions &options);
@@ -733,10 +740,36 @@ class Graphics : public Module
 
 	void captureScreenshot(const ScreenshotInfo &info);
 
+	void startRecording(const FrameRecorder::Settings &settings);
+	FrameRecorder::Stats stopRecording();
+	bool isRecording() const;
+	FrameRecorder::Stats getRecordingStats() const;
+
+	void startProfiling(const Profiler::Settings &settings);
+	void stopProfiling();
+	bool isProfiling() const;
+	const Profiler *getProfiler() const { return profiler; }
+
+	/**
+	 * Profile zones are no-ops when profiling isn't active. When GPU times are
+	 * being recorded, these flush any batched draws.
+	 **/
+	void pushProfileZone(const char *name);
+	void popProfileZone();
+
+	int saveProfile(const std::string &filename) const;
+
 	void copyBuffer(Buffer *source, Buffer *dest, size_t sourceoffset, size_t destoffset, size_t size);
 	void copyTextureToBuffer(Texture *source, Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth);
 	void copyBufferToTexture(Buffer *source, Texture *dest, size_t sourceoffset, int sourcewidth, int slice, int mipmap, const Rect &rect);
 
+	/**
+	 * Gets a persistently mapped buffer with at least the given number of
+	 * bytes free for texture data uploaded this frame. Data written to it is
+	 * copied to textures with Texture::copyFromStreamBuffer.
+	 **/
+	StreamBuffer *getTextureUploadBuffer(size_t size);
+
 	void dispatchThreadgroups(Shader *shader, int x, int y, int z);
 	void dispatchIndirect(Shader *shader, Buffer *indirectargs, int argsindex);
 
@@ -952,6 +985,8 @@ class Graphics : public Module
 
 protected:
 
+	friend class FrameRecorder;
+
 	struct DisplayState
 	{
 		DisplayState();
@@ -1047,6 +1082,15 @@ class Graphics : public Module
 	virtual GraphicsReadback *newReadbackInternal(ReadbackMethod method, Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset) = 0;
 	virtual GraphicsReadback *newReadbackInternal(ReadbackMethod method, Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty) = 0;
 
+	// Asynchronously reads back the backbuffer before it's presented, with rows
+	// in bottom-to-top order. Used for screenshots and frame recording.
+	virtual bool isBackbufferReadbackSupported() const { return false; }
+	virtual GraphicsReadback *newBackbufferReadbackInternal(const Rect &rect, image::ImageData *dest);
+
+	// Returns null if the backend can't time GPU work. The backend owns the
+	// timer, and must stop profiling before destroying it.
+	virtual GPUTimer *getGPUTimer() { return nullptr; }
+
 	virtual bool dispatch(Shader *shader, int x, int y, int z) = 0;
 	virtual bool dispatch(Shader *shader, Buffer *indirectargs, size_t argsoffset) = 0;
 
@@ -1063,6 +1107,25 @@ class Graphics : public Module
 
 	void updatePendingReadbacks();
 
+	struct PendingScreenshot
+	{
+		std::vector<ScreenshotInfo> callbacks;
+		StrongRef<GraphicsReadback> readback;
+		bool submitted = false;
+		std::atomic<bool> processed {false};
+	};
+
+	// Takes ownership of a readback of the backbuffer (in bottom-to-top row
+	// order) for the pending screenshot callbacks. Its pixels are fixed up on a
+	// worker thread once it completes, and the callbacks are called from a
+	// later updatePendingScreenshots.
+	void queueScreenshotReadback(GraphicsReadback *readback);
+	void updatePendingScreenshots(void *screenshotCallbackData);
+
+	// Blocks until every pending screenshot is complete, and calls their
+	// callbacks without callback data.
+	void finishPendingScreenshots();
+
 	void releaseDefaultResources();
 
 	void validateStencilState(const StencilState &s) const;
@@ -1085,10 +1148,16 @@ class Graphics : public Module
 	StrongRef<love::graphics::Font> defaultFont;
 
 	std::vector<ScreenshotInfo> pendingScreenshotCallbacks;
+	std::vector<PendingScreenshot *> pendingScreenshots;
+
+	FrameRecorder *frameRecorder;
+	Profiler *profiler;
 	std::vector<StrongRef<GraphicsReadback>> pendingReadbacks;
 
 	BatchedDrawState batchedDrawState;
 
+	StreamBuffer *textureUploadBuffer;
+
 	std::vector<Matrix4> transformStack;
 	Matrix4 deviceProjectionMatrix;
 
@@ -114,6 +114,26 @@ GraphicsReadback::GraphicsReadback(Graphics *gfx, ReadbackMethod method, Texture
 	imageDataY = dest != nullptr ? desty : 0;
 }
 
+GraphicsReadback::GraphicsReadback(ReadbackMethod method, PixelFormat format, const Rect &rect, love::image::ImageData *dest)
+	: dataType(DATA_TEXTURE)
+	, method(method)
+	, imageData(dest)
+	, rect(rect)
+	, textureFormat(format)
+{
+	if (rect.w <= 0 || rect.h <= 0)
+		throw love::Exception("Invalid rectangle dimensions.");
+
+	if (dest != nullptr)
+	{
+		if (getLinearPixelFormat(dest->getFormat()) != textureFormat)
+			throw love::Exception("Destination ImageData pixel format must match the source format.");
+
+		if (rect.w > dest->getWidth() || rect.h > dest->getHeight())
+			throw love::Exception("The specified rectangle does not fit within the destination ImageData's dimensions.");
+	}
+}
+
 GraphicsReadback::~GraphicsReadback()
 {
 }
@@ -221,5 +241,33 @@ GraphicsReadback::Status GraphicsReadback::readbackBuffer(Buffer *buffer, size_t
 	return success ? STATUS_COMPLETE : STATUS_ERROR;
 }
 
+void fixBackbufferReadbackPixels(image::ImageData *imagedata)
+{
+	int h = imagedata->getHeight();
+	size_t row = imagedata->getWidth() * 4;
+	uint8 *pixels = (uint8 *) imagedata->getData();
+
+	std::vector<uint8> temp(row);
+
+	for (int y = 0; y < (h + 1) / 2; y++)
+	{
+		uint8 *top = pixels + y * row;
+		uint8 *bottom = pixels + (h - 1 - y) * row;
+
+		for (size_t i = 3; i < row; i += 4)
+		{
+			top[i] = 255;
+			bottom[i] = 255;
+		}
+
+		if (top != bottom)
+		{
+			memcpy(temp.data(), top, row);
+			memcpy(top, bottom, row);
+			memcpy(bottom, temp.data(), row);
+		}
+	}
+}
+
 } // graphics
 } // love
@@ -90,6 +90,10 @@ class GraphicsReadback : public love::Object
 		DATA_TEXTURE,
 	};
 
+	// For readbacks of pixels which don't belong to a Texture, such as the
+	// backbuffer. The destination ImageData is optional.
+	GraphicsReadback(ReadbackMethod method, PixelFormat format, const Rect &rect, love::image::ImageData *dest);
+
 	void *prepareReadbackDest(size_t size);
 	Status readbackBuffer(Buffer *buffer, size_t offset, size_t size);
 
@@ -109,5 +113,11 @@ class GraphicsReadback : public love::Object
 
 }; // GraphicsReadback
 
+/**
+ * Flips the rows of an RGBA8 backbuffer readback to be top-to-bottom, and makes
+ * every pixel fully opaque.
+ **/
+void fixBackbufferReadbackPixels(love::image::ImageData *imagedata);
+
 } // graphics
 } // love
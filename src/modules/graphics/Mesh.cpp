@@ -407,12 +407,12 @@ void *Mesh::getVertexData() const
 void Mesh::setVertexDataModified(size_t offset, size_t size)
 {
 	if (vertexData != nullptr)
-		modifiedVertexData.encapsulate(offset, size);
+		modifiedVertexData.add(offset, size);
 }
 
 void Mesh::flush()
 {
-	if (vertexBuffer.get() && vertexData != nullptr && modifiedVertexData.isValid())
+	if (vertexBuffer.get() && vertexData != nullptr && !modifiedVertexData.isEmpty())
 	{
 		if (vertexBuffer->getDataUsage() == BUFFERDATAUSAGE_STREAM)
 		{
@@ -420,12 +420,11 @@ void Mesh::flush()
 		}
 		else
 		{
-			size_t offset = modifiedVertexData.getOffset();
-			size_t size = modifiedVertexData.getSize();
-			vertexBuffer->fill(offset, size, vertexData + offset);
+			for (const Range &range : modifiedVertexData)
+				vertexBuffer->fill(range.getOffset(), range.getSize(), vertexData + range.getOffset());
 		}
 
-		modifiedVertexData.invalidate();
+		modifiedVertexData.clear();
 	}
 
 	if (indexDataModified && indexData != nullptr && indexBuffer != nullptr)
@@ -26,6 +26,7 @@
 #include "common/math.h"
 #include "common/StringMap.h"
 #include "common/Range.h"
+#include "common/RangeSet.h"
 #include "Drawable.h"
 #include "Texture.h"
 #include "vertex.h"
@@ -209,7 +210,10 @@ class Mesh : public Drawable
 	// Vertex buffer, for the vertex data.
 	StrongRef<Buffer> vertexBuffer;
 	uint8 *vertexData = nullptr;
-	Range modifiedVertexData = Range();
+
+	// Modified byte ranges of vertexData. Ranges within 4 KB of each other are
+	// uploaded together.
+	RangeSet modifiedVertexData = RangeSet(16, 4096);
 
 	size_t vertexCount = 0;
 	size_t vertexStride = 0;
@@ -0,0 +1,401 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "Profiler.h"
+#include "common/Exception.h"
+#include "common/Module.h"
+#include "filesystem/Filesystem.h"
+#include "timer/Timer.h"
+
+// C++
+#include <algorithm>
+
+// C
+#include <stdio.h>
+
+namespace love
+{
+namespace graphics
+{
+
+enum GPUQueryBits
+{
+	GPU_QUERY_START = 1 << 0,
+	GPU_QUERY_END = 1 << 1,
+};
+
+static void appendJSONString(std::string &out, const std::string &str)
+{
+	out += '"';
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+			out += c;
+		}
+		else if ((unsigned char) c < 0x20)
+		{
+			char escaped[8];
+			snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int) c);
+			out += escaped;
+		}
+		else
+			out += c;
+	}
+
+	out += '"';
+}
+
+static void appendTraceEvent(std::string &out, const std::string &name, const char *category, int tid, double start, double end, double origin, int64 frame)
+{
+	char buffer[256];
+	snprintf(buffer, sizeof(buffer), ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%lld}},\n",
+		category, tid, (start - origin) * 1000000.0, std::max(end - start, 0.0) * 1000000.0, (long long) frame);
+
+	out += "{\"name\":";
+	appendJSONString(out, name);
+	out += buffer;
+}
+
+Profiler::Profiler(GPUTimer *gpuTimer, const Settings &settings)
+	: gpuTimer(settings.gpu ? gpuTimer : nullptr)
+	, frames(std::max(settings.frames, 2))
+	, currentFrame(0)
+	, oldestPendingFrame(0)
+	, frameName(0)
+	, presentName(0)
+{
+	frameName = getNameID("frame");
+	presentName = getNameID("present");
+
+	beginFrame();
+}
+
+Profiler::~Profiler()
+{
+	for (Frame &frame : frames)
+		releaseQueries(frame);
+}
+
+int Profiler::getNameID(const char *name)
+{
+	auto it = nameIDs.find(name);
+	if (it != nameIDs.end())
+		return it->second;
+
+	int id = (int) names.size();
+	names.push_back(name);
+	nameIDs[names.back()] = id;
+	return id;
+}
+
+void Profiler::beginFrame()
+{
+	Frame &frame = getFrame(currentFrame);
+
+	// Overwriting the oldest frame in the ring buffer.
+	releaseQueries(frame);
+
+	frame.index = currentFrame;
+	frame.zones.clear();
+	frame.pendingZones = 0;
+	frame.hasClockOffset = false;
+	frame.clockOffset = 0.0;
+
+	oldestPendingFrame = std::max(oldestPendingFrame, currentFrame - (int64) frames.size() + 1);
+
+	uint64 gpunow = 0;
+	if (gpuTimer != nullptr && gpuTimer->getCurrentTime(gpunow))
+	{
+		frame.hasClockOffset = true;
+		frame.clockOffset = love::timer::Timer::getTime() - (double) gpunow / 1000000000.0;
+	}
+
+	openZone(frameName, true);
+}
+
+void Profiler::openZone(int name, bool gpu)
+{
+	Frame &frame = getFrame(currentFrame);
+
+	Zone zone = {};
+	zone.name = name;
+	zone.depth = (int) zoneStack.size();
+	zone.cpuStart = love::timer::Timer::getTime();
+	zone.cpuEnd = zone.cpuStart;
+	zone.gpuStart = -1.0;
+	zone.gpuEnd = -1.0;
+	zone.gpuPending = 0;
+	zone.gpuValid = false;
+
+	if (gpu && gpuTimer != nullptr && gpuTimer->timestamp(zone.gpuStartQuery))
+	{
+		zone.gpuPending = GPU_QUERY_START;
+		zone.gpuValid = true;
+		frame.pendingZones++;
+	}
+
+	zoneStack.push_back(frame.zones.size());
+	frame.zones.push_back(zone);
+}
+
+void Profiler::endZoneQuery(Frame &frame, Zone &zone)
+{
+	if ((zone.gpuPending & GPU_QUERY_START) == 0 || (zone.gpuPending & GPU_QUERY_END) != 0)
+		return;
+
+	if (gpuTimer->timestamp(zone.gpuEndQuery))
+		zone.gpuPending |= GPU_QUERY_END;
+	else
+	{
+		gpuTimer->release(zone.gpuStartQuery);
+		zone.gpuPending = 0;
+		zone.gpuValid = false;
+		frame.pendingZones--;
+	}
+}
+
+void Profiler::closeZone(Frame &frame, Zone &zone)
+{
+	endZoneQuery(frame, zone);
+	zone.cpuEnd = love::timer::Timer::getTime();
+}
+
+void Profiler::pushZone(const char *name)
+{
+	openZone(getNameID(name), true);
+}
+
+void Profiler::popZone()
+{
+	// The bottom of the stack is the automatic frame zone.
+	if (zoneStack.size() <= 1)
+		throw love::Exception("There is no profile zone to pop.");
+
+	Frame &frame = getFrame(currentFrame);
+	closeZone(frame, frame.zones[zoneStack.back()]);
+	zoneStack.pop_back();
+}
+
+void Profiler::beginPresent()
+{
+	Frame &frame = getFrame(currentFrame);
+
+	// Zones which were left open are closed at the end of the frame.
+	while (zoneStack.size() > 1)
+	{
+		closeZone(frame, frame.zones[zoneStack.back()]);
+		zoneStack.pop_back();
+	}
+
+	// The frame's GPU time ends with its last submitted command, but its CPU
+	// time includes the present.
+	if (!zoneStack.empty())
+		endZoneQuery(frame, frame.zones[zoneStack.back()]);
+
+	openZone(presentName, false);
+}
+
+void Profiler::endPresent()
+{
+	Frame &frame = getFrame(currentFrame);
+
+	while (!zoneStack.empty())
+	{
+		closeZone(frame, frame.zones[zoneStack.back()]);
+		zoneStack.pop_back();
+	}
+
+	if (gpuTimer != nullptr)
+		gpuTimer->newFrame();
+
+	for (int64 i = oldestPendingFrame; i <= currentFrame; i++)
+	{
+		Frame &f = getFrame(i);
+		if (f.index == i && f.pendingZones > 0)
+			resolve(f, currentFrame - i >= MAX_PENDING_FRAMES);
+	}
+
+	while (oldestPendingFrame <= currentFrame && getFrame(oldestPendingFrame).pendingZones == 0)
+		oldestPendingFrame++;
+
+	if (frame.pendingZones == 0)
+		finishFrame(frame);
+
+	currentFrame++;
+	beginFrame();
+}
+
+void Profiler::releaseQueries(Frame &frame)
+{
+	if (frame.pendingZones == 0)
+		return;
+
+	for (Zone &zone : frame.zones)
+	{
+		if (zone.gpuPending & GPU_QUERY_START)
+			gpuTimer->release(zone.gpuStartQuery);
+		if (zone.gpuPending & GPU_QUERY_END)
+			gpuTimer->release(zone.gpuEndQuery);
+
+		if (zone.gpuPending != 0)
+			zone.gpuValid = false;
+		zone.gpuPending = 0;
+	}
+
+	frame.pendingZones = 0;
+}
+
+void Profiler::resolve(Frame &frame, bool discard)
+{
+	if (discard)
+		releaseQueries(frame);
+
+	for (Zone &zone : frame.zones)
+	{
+		if (zone.gpuPending == 0)
+			continue;
+
+		if (zone.gpuPending & GPU_QUERY_START)
+		{
+			auto result = gpuTimer->getResult(zone.gpuStartQuery, zone.gpuStartTime);
+			if (result != GPUTimer::RESULT_PENDING)
+				zone.gpuPending &= ~GPU_QUERY_START;
+			if (result == GPUTimer::RESULT_LOST)
+				zone.gpuValid = false;
+		}
+
+		if (zone.gpuPending & GPU_QUERY_END)
+		{
+			auto result = gpuTimer->getResult(zone.gpuEndQuery, zone.gpuEndTime);
+			if (result != GPUTimer::RESULT_PENDING)
+				zone.gpuPending &= ~GPU_QUERY_END;
+			if (result == GPUTimer::RESULT_LOST)
+				zone.gpuValid = false;
+		}
+
+		if (!zone.gpuValid && zone.gpuPending != 0)
+		{
+			if (zone.gpuPending & GPU_QUERY_START)
+				gpuTimer->release(zone.gpuStartQuery);
+			if (zone.gpuPending & GPU_QUERY_END)
+				gpuTimer->release(zone.gpuEndQuery);
+			zone.gpuPending = 0;
+		}
+
+		if (zone.gpuPending == 0)
+			frame.pendingZones--;
+	}
+
+	if (frame.pendingZones == 0 && frame.index != currentFrame)
+		finishFrame(frame);
+}
+
+void Profiler::finishFrame(Frame &frame)
+{
+	if (frame.zones.empty())
+		return;
+
+	// Without a way to read the GPU clock directly, the GPU timeline is lined
+	// up so the frame's GPU work starts when its CPU work does.
+	const Zone &framezone = frame.zones[0];
+	double offset = frame.clockOffset;
+
+	if (!frame.hasClockOffset)
+	{
+		if (!framezone.gpuValid)
+			return;
+		offset = framezone.cpuStart - (double) framezone.gpuStartTime / 1000000000.0;
+	}
+
+	for (Zone &zone : frame.zones)
+	{
+		if (!zone.gpuValid || zone.gpuPending != 0)
+			continue;
+
+		zone.gpuStart = offset + (double) zone.gpuStartTime / 1000000000.0;
+		zone.gpuEnd = offset + (double) std::max(zone.gpuEndTime, zone.gpuStartTime) / 1000000000.0;
+	}
+}
+
+const Profiler::Frame *Profiler::getLatestFrame() const
+{
+	int64 oldest = std::max((int64) 0, currentFrame - (int64) frames.size() + 1);
+
+	for (int64 i = currentFrame - 1; i >= oldest; i--)
+	{
+		const Frame &frame = getFrame(i);
+		if (frame.index == i && frame.pendingZones == 0)
+			return &frame;
+	}
+
+	return nullptr;
+}
+
+int Profiler::saveChromeTrace(const std::string &filename) const
+{
+	auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		throw love::Exception("love.filesystem must be loaded in order to save a profile.");
+
+	int64 oldest = std::max((int64) 0, currentFrame - (int64) frames.size() + 1);
+
+	double origin = -1.0;
+	int framecount = 0;
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}},\n";
+
+	for (int64 i = oldest; i < currentFrame; i++)
+	{
+		const Frame &frame = getFrame(i);
+		if (frame.index != i || frame.pendingZones != 0 || frame.zones.empty())
+			continue;
+
+		if (origin < 0.0)
+			origin = frame.zones[0].cpuStart;
+
+		for (const Zone &zone : frame.zones)
+		{
+			const std::string &name = names[zone.name];
+			appendTraceEvent(json, name, "cpu", 1, zone.cpuStart, zone.cpuEnd, origin, i);
+			if (zone.gpuStart >= 0.0)
+				appendTraceEvent(json, name, "gpu", 2, zone.gpuStart, zone.gpuEnd, origin, i);
+		}
+
+		framecount++;
+	}
+
+	// The metadata events always end with ",\n", so the last event needs its
+	// trailing comma removed.
+	json.resize(json.size() - 2);
+	json += "\n]}\n";
+
+	fs->write(filename.c_str(), json.data(), (int64) json.size());
+
+	return framecount;
+}
+
+} // graphics
+} // love
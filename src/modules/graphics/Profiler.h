@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/config.h"
+#include "common/int.h"
+
+// C++
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace love
+{
+namespace graphics
+{
+
+/**
+ * Backend interface for GPU timestamp queries. Timestamps are written into the
+ * GPU command stream and their results become available some frames later.
+ **/
+class GPUTimer
+{
+public:
+
+	enum Result
+	{
+		RESULT_PENDING,
+		RESULT_READY,
+		RESULT_LOST,
+	};
+
+	virtual ~GPUTimer() {}
+
+	/**
+	 * Writes a timestamp after all previously submitted GPU work. Returns false
+	 * if no query could be issued. The returned handle must be passed to
+	 * getResult until it stops returning RESULT_PENDING, or to release.
+	 **/
+	virtual bool timestamp(uint64 &handle) = 0;
+
+	/**
+	 * Gets the time in nanoseconds of a timestamp, on the GPU's clock.
+	 **/
+	virtual Result getResult(uint64 handle, uint64 &nanoseconds) = 0;
+
+	/**
+	 * Gives back a timestamp whose result is no longer wanted.
+	 **/
+	virtual void release(uint64 handle) = 0;
+
+	/**
+	 * Gets the GPU clock's current time in nanoseconds, if the backend can
+	 * query it without waiting for the GPU.
+	 **/
+	virtual bool getCurrentTime(uint64 &/*nanoseconds*/) { return false; }
+
+	/**
+	 * Called once per presented frame.
+	 **/
+	virtual void newFrame() {}
+
+}; // GPUTimer
+
+/**
+ * Records named CPU and GPU timing zones for each presented frame into a ring
+ * buffer of recent frames. Every frame has an automatic "frame" zone covering
+ * the whole frame, and a CPU-only "present" zone covering submission and the
+ * buffer swap.
+ **/
+class Profiler
+{
+public:
+
+	struct Settings
+	{
+		int frames = 120;
+		bool gpu = true;
+	};
+
+	struct Zone
+	{
+		int name;
+		int depth;
+
+		// Seconds, from love.timer.getTime.
+		double cpuStart;
+		double cpuEnd;
+
+		// Seconds on the CPU's timeline, or negative when GPU timing is
+		// unavailable for this zone.
+		double gpuStart;
+		double gpuEnd;
+
+		uint64 gpuStartQuery;
+		uint64 gpuEndQuery;
+
+		// Nanoseconds on the GPU's clock, once resolved.
+		uint64 gpuStartTime;
+		uint64 gpuEndTime;
+
+		// Bitmask of the timestamp queries still waiting for a result.
+		int gpuPending;
+		bool gpuValid;
+	};
+
+	struct Frame
+	{
+		int64 index = -1;
+		std::vector<Zone> zones;
+
+		// Number of zones whose GPU timestamps haven't been resolved yet.
+		int pendingZones = 0;
+
+		// Offset from GPU clock to CPU clock seconds, if the backend could
+		// provide one when the frame started.
+		bool hasClockOffset = false;
+		double clockOffset = 0.0;
+	};
+
+	// gpuTimer may be null, in which case only CPU times are recorded.
+	Profiler(GPUTimer *gpuTimer, const Settings &settings);
+	~Profiler();
+
+	bool isGPUTimingEnabled() const { return gpuTimer != nullptr; }
+
+	void pushZone(const char *name);
+	void popZone();
+
+	/**
+	 * Called by the graphics backend before the frame's commands are
+	 * submitted, and after the frame has been presented.
+	 **/
+	void beginPresent();
+	void endPresent();
+
+	/**
+	 * Gets the most recent frame whose zones are fully resolved, or null.
+	 **/
+	const Frame *getLatestFrame() const;
+
+	const std::string &getZoneName(int name) const { return names[name]; }
+
+	/**
+	 * Writes every resolved frame in Chrome trace event JSON format to a file
+	 * in the save directory. Returns the number of frames written.
+	 **/
+	int saveChromeTrace(const std::string &filename) const;
+
+private:
+
+	// GPU results which haven't arrived after this many frames are discarded.
+	static const int MAX_PENDING_FRAMES = 16;
+
+	Frame &getFrame(int64 index) { return frames[index % (int64) frames.size()]; }
+	const Frame &getFrame(int64 index) const { return frames[index % (int64) frames.size()]; }
+
+	int getNameID(const char *name);
+	void beginFrame();
+	void openZone(int name, bool gpu);
+	void endZoneQuery(Frame &frame, Zone &zone);
+	void closeZone(Frame &frame, Zone &zone);
+	void releaseQueries(Frame &frame);
+	void resolve(Frame &frame, bool discard);
+	void finishFrame(Frame &frame);
+
+	GPUTimer *gpuTimer;
+
+	std::vector<Frame> frames;
+	int64 currentFrame;
+	int64 oldestPendingFrame;
+
+	std::vector<size_t> zoneStack;
+
+	std::vector<std::string> names;
+	std::unordered_map<std::string, int> nameIDs;
+
+	int frameName;
+	int presentName;
+
+}; // Profiler
+
+} // graphics
+} // love
@@ -1812,6 +1812,32 @@ vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
 }
 )";
 
+// Expands each SpriteBatch instance into a quad. See SpriteBatch::SpriteInstance.
+// The SpriteRotation location is SpriteBatch::ROTATION_ATTRIB_LOCATION.
+static const std::string defaultSpriteInstancesVertex = R"(
+layout (location = 0) in vec4 VertexPosition;
+layout (location = 1) in vec4 VertexTexCoord;
+layout (location = 2) in vec4 VertexColor;
+layout (location = 3) in float SpriteRotation;
+
+out highp vec4 VaryingTexCoord;
+out mediump vec4 VaryingColor;
+
+void vertexmain()
+{
+	vec2 corner = vec2(float(love_VertexID / 2), float(love_VertexID % 2));
+	vec2 local = corner * VertexPosition.zw;
+
+	float c = cos(SpriteRotation);
+	float s = sin(SpriteRotation);
+	vec2 position = VertexPosition.xy + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+	VaryingTexCoord = vec4(mix(VertexTexCoord.xy, VertexTexCoord.zw, corner), 0.0, 0.0);
+	VaryingColor = gammaCorrectColor(VertexColor) * ConstantColor;
+	love_Position = ClipSpaceFromLocal * vec4(position, 0.0, 1.0);
+}
+)";
+
 static const std::string defaultStandardPixel = R"(
 vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
 {
@@ -1840,6 +1866,8 @@ const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType
 	{
 		if (shader == STANDARD_POINTS)
 			return defaultPointsVertex;
+		else if (shader == STANDARD_SPRITE_INSTANCES)
+			return defaultSpriteInstancesVertex;
 		else
 			return defaultVertex;
 	}
@@ -1852,6 +1880,7 @@ const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType
 		case STANDARD_VIDEO: return defaultVideoPixel;
 		case STANDARD_ARRAY: return defaultArrayPixel;
 		case STANDARD_POINTS: return defaultStandardPixel;
+		case STANDARD_SPRITE_INSTANCES: return defaultStandardPixel;
 		case STANDARD_MAX_ENUM: return nocode;
 	}
 
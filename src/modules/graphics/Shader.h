@@ -95,6 +95,7 @@ class Shader : public Object, public Resource
 		STANDARD_VIDEO,
 		STANDARD_ARRAY,
 		STANDARD_POINTS,
+		STANDARD_SPRITE_INSTANCES,
 		STANDARD_MAX_ENUM
 	};
 
@@ -26,9 +26,11 @@
 #include "Quad.h"
 #include "Graphics.h"
 #include "Buffer.h"
+#include "thread/ThreadPool.h"
 
 // C++
 #include <algorithm>
+#include <cmath>
 
 // C
 #include <stddef.h>
@@ -40,16 +42,41 @@ namespace graphics
 
 love::Type SpriteBatch::type("SpriteBatch", &Drawable::type);
 
-SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage)
+// Sprites added with addMany are split across worker threads once there are
+// enough of them to be worth it.
+static const int PARALLEL_SPRITES_MIN = 8192;
+
+// Modified sprites closer together than this many bytes are uploaded in a
+// single call, and at most MAX_UPLOAD_RANGES separate uploads happen per flush.
+static const size_t UPLOAD_MERGE_BYTES = 4096;
+static const size_t MAX_UPLOAD_RANGES = 16;
+
+static std::vector<Buffer::DataDeclaration> getInstanceDeclaration()
+{
+	return {
+		{ getConstant(ATTRIB_POS), DATAFORMAT_FLOAT_VEC4, 0, ATTRIB_POS },
+		{ "SpriteRotation", DATAFORMAT_FLOAT, 0, SpriteBatch::ROTATION_ATTRIB_LOCATION },
+		{ getConstant(ATTRIB_TEXCOORD), DATAFORMAT_UNORM16_VEC4, 0, ATTRIB_TEXCOORD },
+		{ getConstant(ATTRIB_COLOR), DATAFORMAT_UNORM8_VEC4, 0, ATTRIB_COLOR },
+	};
+}
+
+static inline uint16 toUnorm16(float v)
+{
+	return (uint16) (v * 65535.0f + 0.5f);
+}
+
+SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, bool instanced)
 	: texture(texture)
 	, size(size)
 	, next(0)
 	, color(255, 255, 255, 255)
 	, colorf(1.0f, 1.0f, 1.0f, 1.0f)
+	, instanced(instanced)
 	, attributesID()
 	, array_buf(nullptr)
 	, vertex_data(nullptr)
-	, modified_sprites()
+	, modified_sprites(MAX_UPLOAD_RANGES)
 	, range_start(-1)
 	, range_count(-1)
 {
@@ -59,14 +86,29 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 	if (texture == nullptr)
 		throw love::Exception("A texture must be used when creating a SpriteBatch.");
 
+	if (instanced && texture->getTextureType() != TEXTURE_2D)
+		throw love::Exception("Instanced SpriteBatches can only be used with 2D textures.");
+
 	if (texture->getTextureType() == TEXTURE_2D_ARRAY)
 		vertex_format = CommonFormat::XYf_STPf_RGBAub;
 	else
 		vertex_format = CommonFormat::XYf_STf_RGBAub;
 
-	vertex_stride = getFormatStride(vertex_format);
+	if (instanced)
+	{
+		vertex_format = CommonFormat::NONE;
+		vertex_stride = sizeof(SpriteInstance);
+		sprite_stride = vertex_stride;
+	}
+	else
+	{
+		vertex_stride = getFormatStride(vertex_format);
+		sprite_stride = vertex_stride * 4;
+	}
+
+	size_t vertex_size = sprite_stride * size;
 
-	size_t vertex_size = vertex_stride * 4 * size;
+	modified_sprites.setMergeDistance(UPLOAD_MERGE_BYTES / sprite_stride);
 
 	vertex_data = (uint8 *) malloc(vertex_size);
 	if (vertex_data == nullptr)
@@ -75,7 +117,7 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 	memset(vertex_data, 0, vertex_size);
 
 	Buffer::Settings settings(BUFFERUSAGEFLAG_VERTEX, usage);
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
+	auto decl = instanced ? getInstanceDeclaration() : Buffer::getCommonFormatDeclaration(vertex_format);
 
 	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
 }
@@ -106,19 +148,43 @@ int SpriteBatch::add(Quad *quad, const Matrix4 &m, int index /*= -1*/)
 
 	int spriteindex = (index == -1 ? next : index);
 
-	size_t offset = spriteindex * vertex_stride * 4;
-	auto verts = (XYf_STf_RGBAub *) (vertex_data + offset);
+	if (instanced)
+	{
+		checkInstanceQuad(quad);
 
-	m.transformXY(verts, quadpositions, 4);
+		// Instances can only represent rotation and scale, so any shearing in
+		// the transform is dropped.
+		Vector2 corners[3];
+		m.transformXY(corners, quadpositions, 3);
 
-	for (int i = 0; i < 4; i++)
+		Vector2 xedge = corners[2] - corners[0];
+		Vector2 yedge = corners[1] - corners[0];
+
+		float w = xedge.getLength();
+		float angle = w > 0.0f ? atan2f(xedge.y, xedge.x) : atan2f(-yedge.x, yedge.y);
+		float h = cosf(angle) * yedge.y - sinf(angle) * yedge.x;
+
+		if (w == 0.0f)
+			h = yedge.getLength();
+
+		writeInstance(spriteindex, corners[0], Vector2(w, h), angle, quad, color);
+	}
+	else
 	{
-		verts[i].s = quadtexcoords[i].x;
-		verts[i].t = quadtexcoords[i].y;
-		verts[i].color = color;
+		size_t offset = spriteindex * sprite_stride;
+		auto verts = (XYf_STf_RGBAub *) (vertex_data + offset);
+
+		m.transformXY(verts, quadpositions, 4);
+
+		for (int i = 0; i < 4; i++)
+		{
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].color = color;
+		}
 	}
 
-	modified_sprites.encapsulate(spriteindex);
+	modified_sprites.add(spriteindex);
 
 	// Increment counter.
 	if (index == -1)
@@ -151,7 +217,7 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 
 	int spriteindex = (index == -1 ? next : index);
 
-	size_t offset = spriteindex * vertex_stride * 4;
+	size_t offset = spriteindex * sprite_stride;
 	auto verts = (XYf_STPf_RGBAub *) (vertex_data + offset);
 
 	m.transformXY(verts, quadpositions, 4);
@@ -164,7 +230,7 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 		verts[i].color = color;
 	}
 
-	modified_sprites.encapsulate(spriteindex);
+	modified_sprites.add(spriteindex);
 
 	// Increment counter.
 	if (index == -1)
@@ -173,6 +239,166 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 	return index;
 }
 
+void SpriteBatch::checkInstanceQuad(Quad *quad) const
+{
+	// Texture coordinates are stored as normalized integers.
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+	const Vector2 &tc0 = quadtexcoords[0];
+	const Vector2 &tc1 = quadtexcoords[3];
+
+	if (std::min(std::min(tc0.x, tc0.y), std::min(tc1.x, tc1.y)) < 0.0f || std::max(std::max(tc0.x, tc0.y), std::max(tc1.x, tc1.y)) > 1.0f)
+		throw love::Exception("Quads used in an instanced SpriteBatch must be within the bounds of the texture.");
+}
+
+void SpriteBatch::writeInstance(int spriteindex, const Vector2 &pos, const Vector2 &size, float angle, Quad *quad, Color32 c)
+{
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+	const Vector2 &tc0 = quadtexcoords[0];
+	const Vector2 &tc1 = quadtexcoords[3];
+
+	auto instance = (SpriteInstance *) (vertex_data + spriteindex * sprite_stride);
+
+	instance->x = pos.x;
+	instance->y = pos.y;
+	instance->w = size.x;
+	instance->h = size.y;
+	instance->angle = angle;
+	instance->s0 = toUnorm16(tc0.x);
+	instance->t0 = toUnorm16(tc0.y);
+	instance->s1 = toUnorm16(tc1.x);
+	instance->t1 = toUnorm16(tc1.y);
+	instance->color = c;
+}
+
+void SpriteBatch::writeSprite(int spriteindex, const SpriteData &sprite, Quad *quad, Color32 c)
+{
+	const Vector2 *quadpositions = quad->getVertexPositions();
+
+	float cosa = 1.0f;
+	float sina = 0.0f;
+	if (sprite.angle != 0.0f)
+	{
+		cosa = cosf(sprite.angle);
+		sina = sinf(sprite.angle);
+	}
+
+	// Same as Matrix4::setTransformation without shearing, applied directly
+	// to the quad's corners.
+	auto transform = [&](const Vector2 &p) -> Vector2
+	{
+		float lx = (p.x - sprite.ox) * sprite.sx;
+		float ly = (p.y - sprite.oy) * sprite.sy;
+		return Vector2(sprite.x + cosa * lx - sina * ly, sprite.y + sina * lx + cosa * ly);
+	};
+
+	if (instanced)
+	{
+		Vector2 size = (quadpositions[3] - quadpositions[0]);
+		size.x *= sprite.sx;
+		size.y *= sprite.sy;
+		writeInstance(spriteindex, transform(quadpositions[0]), size, sprite.angle, quad, c);
+		return;
+	}
+
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+	uint8 *data = vertex_data + spriteindex * sprite_stride;
+
+	if (vertex_format == CommonFormat::XYf_STPf_RGBAub)
+	{
+		auto verts = (XYf_STPf_RGBAub *) data;
+		float layer = (float) quad->getLayer();
+
+		for (int i = 0; i < 4; i++)
+		{
+			Vector2 p = transform(quadpositions[i]);
+			verts[i].x = p.x;
+			verts[i].y = p.y;
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].p = layer;
+			verts[i].color = c;
+		}
+	}
+	else
+	{
+		auto verts = (XYf_STf_RGBAub *) data;
+
+		for (int i = 0; i < 4; i++)
+		{
+			Vector2 p = transform(quadpositions[i]);
+			verts[i].x = p.x;
+			verts[i].y = p.y;
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].color = c;
+		}
+	}
+}
+
+int SpriteBatch::reserveSprites(int count, int index)
+{
+	if (count < 0 || index < -1 || (index >= 0 && index + count > size))
+		throw love::Exception("Invalid sprite index: %d", index + 1);
+
+	if (index >= 0)
+		return index;
+
+	if (next + count > size)
+		setBufferSize(std::max(size * 2, next + count));
+
+	return next;
+}
+
+int SpriteBatch::addMany(const SpriteData *sprites, int count, const std::vector<Quad *> &quads, const Color32 *colors, int index)
+{
+	int first = reserveSprites(count, index);
+
+	if (count == 0)
+		return first;
+
+	Quad *defaultquad = texture->getQuad();
+
+	for (Quad *quad : quads)
+	{
+		if (instanced)
+			checkInstanceQuad(quad);
+
+		if (vertex_format == CommonFormat::XYf_STPf_RGBAub && (quad->getLayer() < 0 || quad->getLayer() >= texture->getLayerCount()))
+			throw love::Exception("Invalid layer: %d (Texture has %d layers)", quad->getLayer() + 1, texture->getLayerCount());
+	}
+
+	Color32 c = color;
+
+	auto writesprites = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const SpriteData &sprite = sprites[i];
+			int quadindex = (int) sprite.quad - 1;
+			Quad *quad = quadindex >= 0 && quadindex < (int) quads.size() ? quads[quadindex] : defaultquad;
+
+			writeSprite(first + (int) i, sprite, quad, colors != nullptr ? colors[i] : c);
+		}
+	};
+
+	if (count >= PARALLEL_SPRITES_MIN)
+		love::thread::ThreadPool::getShared().parallelFor(count, PARALLEL_SPRITES_MIN / 4, writesprites);
+	else
+		writesprites(0, count);
+
+	modified_sprites.add(first, count);
+
+	if (index == -1)
+		next += count;
+
+	return first;
+}
+
+bool SpriteBatch::isInstanced() const
+{
+	return instanced;
+}
+
 void SpriteBatch::clear()
 {
 	// Reset the position of the next index.
@@ -181,17 +407,21 @@ void SpriteBatch::clear()
 
 void SpriteBatch::flush()
 {
-	if (modified_sprites.isValid())
+	if (!modified_sprites.isEmpty())
 	{
-		size_t offset = modified_sprites.getOffset() * vertex_stride * 4;
-		size_t size = modified_sprites.getSize() * vertex_stride * 4;
-
 		if (array_buf->getDataUsage() == BUFFERDATAUSAGE_STREAM)
 			array_buf->fill(0, array_buf->getSize(), vertex_data);
 		else
-			array_buf->fill(offset, size, vertex_data + offset);
+		{
+			for (const Range &range : modified_sprites)
+			{
+				size_t offset = range.getOffset() * sprite_stride;
+				size_t size = range.getSize() * sprite_stride;
+				array_buf->fill(offset, size, vertex_data + offset);
+			}
+		}
 
-		modified_sprites.invalidate();
+		modified_sprites.clear();
 	}
 }
 
@@ -236,7 +466,7 @@ void SpriteBatch::setBufferSize(int newsize)
 	if (newsize == size)
 		return;
 
-	size_t vertex_size = vertex_stride * 4 * newsize;
+	size_t vertex_size = sprite_stride * newsize;
 
 	int new_next = std::min(next, newsize);
 
@@ -246,11 +476,11 @@ void SpriteBatch::setBufferSize(int newsize)
 
 	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
 	Buffer::Settings settings(array_buf->getUsageFlags(), array_buf->getDataUsage());
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
+	auto decl = instanced ? getInstanceDeclaration() : Buffer::getCommonFormatDeclaration(vertex_format);
 
 	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
 
-	array_buf->fill(0, vertex_stride * 4 * new_next, new_vertex_data);
+	array_buf->fill(0, sprite_stride * new_next, new_vertex_data);
 
 	vertex_data = (uint8 *) new_vertex_data;
 
@@ -267,6 +497,9 @@ int SpriteBatch::getBufferSize() const
 
 void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh *mesh)
 {
+	if (instanced)
+		throw love::Exception("Vertex attributes cannot be attached to an instanced SpriteBatch.");
+
 	if ((buffer->getUsageFlags() & BUFFERUSAGEFLAG_VERTEX) == 0)
 		throw love::Exception("GraphicsBuffer must be created with vertex buffer support to be used as a SpriteBatch vertex attribute.");
 
@@ -373,6 +606,34 @@ void SpriteBatch::updateVertexAttributes(Graphics *gfx)
 	attributesID = gfx->registerVertexAttributes(attributes);
 }
 
+void SpriteBatch::drawInstanced(Graphics *gfx, int start, int count)
+{
+	if (!attributesID.isValid())
+	{
+		VertexAttributes attributes;
+		attributes.set(ATTRIB_POS, DATAFORMAT_FLOAT_VEC4, offsetof(SpriteInstance, x), 0);
+		attributes.set(ROTATION_ATTRIB_LOCATION, DATAFORMAT_FLOAT, offsetof(SpriteInstance, angle), 0);
+		attributes.set(ATTRIB_TEXCOORD, DATAFORMAT_UNORM16_VEC4, offsetof(SpriteInstance, s0), 0);
+		attributes.set(ATTRIB_COLOR, DATAFORMAT_UNORM8_VEC4, offsetof(SpriteInstance, color), 0);
+		attributes.setBufferLayout(0, (uint16) sprite_stride, STEP_PER_INSTANCE);
+
+		attributesID = gfx->registerVertexAttributes(attributes);
+	}
+
+	// The draw range is applied through the buffer offset, since draws don't
+	// have a base instance.
+	bufferBindings.clear();
+	bufferBindings.set(0, array_buf, start * sprite_stride);
+
+	Graphics::DrawCommand cmd(attributesID, &bufferBindings);
+	cmd.primitiveType = PRIMITIVE_TRIANGLE_STRIP;
+	cmd.vertexCount = 4;
+	cmd.instanceCount = count;
+	cmd.texture = gfx->getTextureOrDefaultForActiveShader(texture);
+
+	gfx->draw(cmd);
+}
+
 void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 {
 	if (next == 0)
@@ -385,7 +646,9 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 		if (Shader::isDefaultActive())
 		{
 			Shader::StandardShader defaultshader = Shader::STANDARD_DEFAULT;
-			if (texture->getTextureType() == TEXTURE_2D_ARRAY)
+			if (instanced)
+				defaultshader = Shader::STANDARD_SPRITE_INSTANCES;
+			else if (texture->getTextureType() == TEXTURE_2D_ARRAY)
 				defaultshader = Shader::STANDARD_ARRAY;
 
 			Shader::attachDefault(defaultshader);
@@ -393,10 +656,23 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 	}
 
 	if (Shader::current)
-		Shader::current->validateDrawState(PRIMITIVE_TRIANGLES, texture);
+		Shader::current->validateDrawState(instanced ? PRIMITIVE_TRIANGLE_STRIP : PRIMITIVE_TRIANGLES, texture);
 
 	flush(); // Upload any modified sprite data to the GPU.
 
+	if (instanced)
+	{
+		Graphics::TempTransform transform(gfx, m);
+
+		int start = std::min(std::max(0, range_start), next - 1);
+		int count = range_count > 0 ? std::min(next, range_count) : next;
+		count = std::min(count, next - start);
+
+		if (count > 0)
+			drawInstanced(gfx, start, count);
+		return;
+	}
+
 	bool attributesIDneedsupdate = !attributesID.isValid();
 
 	for (const auto &it : attached_attributes)
@@ -25,12 +25,14 @@
 
 // C++
 #include <unordered_map>
+#include <vector>
 
 // LOVE
 #include "common/math.h"
 #include "common/Matrix.h"
 #include "common/Color.h"
 #include "common/Range.h"
+#include "common/RangeSet.h"
 #include "Drawable.h"
 #include "Mesh.h"
 #include "vertex.h"
@@ -52,7 +54,45 @@ class SpriteBatch : public Drawable
 
 	static love::Type type;
 
-	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage);
+	/**
+	 * Sprite parameters used by addMany and setMany. The layout matches the
+	 * packed float arrays accepted from Lua.
+	 **/
+	struct SpriteData
+	{
+		float x, y;
+		float angle;
+		float sx, sy;
+		float ox, oy;
+
+		// 1-based index into the list of quads given to addMany, or 0 to use
+		// the whole texture.
+		float quad;
+	};
+
+	/**
+	 * A single sprite in an instanced SpriteBatch. Each instance is expanded
+	 * into a quad in the vertex shader.
+	 **/
+	struct SpriteInstance
+	{
+		// Position of the sprite's first corner (origin already applied), and
+		// its scaled size.
+		float x, y;
+		float w, h;
+		float angle;
+
+		// Texture coordinate rectangle as normalized 16 bit integers.
+		uint16 s0, t0, s1, t1;
+
+		Color32 color;
+	};
+
+	// Vertex attribute location of SpriteInstance::angle, after the standard
+	// attributes. Must match SpriteRotation in the instanced vertex shader.
+	static const int ROTATION_ATTRIB_LOCATION = 3;
+
+	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, bool instanced = false);
 	virtual ~SpriteBatch();
 
 	int add(const Matrix4 &m, int index = -1);
@@ -60,6 +100,25 @@ class SpriteBatch : public Drawable
 	int addLayer(int layer, const Matrix4 &m, int index = -1);
 	int addLayer(int layer, Quad *quad, const Matrix4 &m, int index = -1);
 
+	/**
+	 * Adds or replaces many sprites at once. Sprites without a valid quad
+	 * index use the whole texture.
+	 * @param sprites The parameters of each sprite.
+	 * @param count The number of sprites.
+	 * @param quads The quads the sprites' quad indices refer to.
+	 * @param colors Per-sprite colors, or null to use the current color.
+	 * @param index The index of the first sprite to replace, or -1 to add
+	 *        new sprites at the end of the batch.
+	 * @return The index of the first sprite.
+	 **/
+	int addMany(const SpriteData *sprites, int count, const std::vector<Quad *> &quads, const Color32 *colors, int index = -1);
+
+	/**
+	 * Whether sprites are stored as one instance record each, rather than as
+	 * four vertices.
+	 **/
+	bool isInstanced() const;
+
 	void clear();
 
 	void flush();
@@ -109,6 +168,12 @@ class SpriteBatch : public Drawable
 private:
 
 	void updateVertexAttributes(Graphics *gfx);
+	void drawInstanced(Graphics *gfx, int start, int count);
+
+	void checkInstanceQuad(Quad *quad) const;
+	void writeSprite(int spriteindex, const SpriteData &sprite, Quad *quad, Color32 c);
+	void writeInstance(int spriteindex, const Vector2 &pos, const Vector2 &size, float angle, Quad *quad, Color32 c);
+	int reserveSprites(int count, int index);
 
 	struct AttachedAttribute
 	{
@@ -136,16 +201,21 @@ class SpriteBatch : public Drawable
 	Color32 color;
 	Colorf colorf;
 
+	bool instanced;
+
 	CommonFormat vertex_format;
 	size_t vertex_stride;
 
+	// Number of bytes used by each sprite in vertex_data.
+	size_t sprite_stride;
+
 	VertexAttributesID attributesID;
 	BufferBindings bufferBindings;
 
 	StrongRef<love::graphics::Buffer> array_buf;
 	uint8 *vertex_data;
 
-	Range modified_sprites;
+	RangeSet modified_sprites;
 
 	std::unordered_map<std::string, AttachedAttribute> attached_attributes;
 	
@@ -154,5 +224,8 @@ class SpriteBatch : public Drawable
 	
 }; // SpriteBatch
 
+static_assert(sizeof(SpriteBatch::SpriteData) == sizeof(float) * 8, "SpriteData must be tightly packed.");
+static_assert(sizeof(SpriteBatch::SpriteInstance) == 32, "SpriteInstance must be 32 bytes.");
+
 } // graphics
 } // love
@@ -48,6 +48,7 @@ namespace graphics
 
 class Graphics;
 class Buffer;
+class StreamBuffer;
 
 enum TextureType
 {
@@ -272,6 +273,10 @@ class Texture : public Drawable, public Resource
 	virtual void copyFromBuffer(Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) = 0;
 	virtual void copyToBuffer(Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth, size_t size) = 0;
 
+	// The source offset is relative to the offset returned by unmapping the
+	// StreamBuffer. Higher level code does validation.
+	virtual void copyFromStreamBuffer(StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) = 0;
+
 	virtual ptrdiff_t getRenderTargetHandle() const = 0;
 	virtual ptrdiff_t getSamplerHandle() const = 0;
 
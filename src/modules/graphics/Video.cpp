@@ -23,6 +23,12 @@
 // LOVE
 #include "Shader.h"
 #include "Graphics.h"
+#include "StreamBuffer.h"
+#include "common/memory.h"
+#include "timer/Timer.h"
+
+// C
+#include <string.h>
 
 namespace love
 {
@@ -31,6 +37,9 @@ namespace graphics
 
 love::Type Video::type("Video", &Drawable::type);
 
+int64 Video::uploadBytes = 0;
+double Video::uploadTime = 0.0;
+
 Video::Video(Graphics *gfx, love::video::VideoStream *stream, float dpiscale)
 	: stream(stream)
 	, width(stream->getWidth() / dpiscale)
@@ -113,7 +122,7 @@ love::video::VideoStream *Video::getStream()
 
 void Video::draw(Graphics *gfx, const Matrix4 &m)
 {
-	update();
+	update(gfx);
 
 	// setVideoTextures may call flushBatchedDraws before setting the textures, so
 	// we can't call it after requestBatchedDraw.
@@ -157,7 +166,7 @@ void Video::draw(Graphics *gfx, const Matrix4 &m)
 	gfx->flushBatchedDraws();
 }
 
-void Video::update()
+void Video::update(Graphics *gfx)
 {
 	bool bufferschanged = stream->swapBuffers();
 	stream->fillBackBuffer();
@@ -166,20 +175,52 @@ void Video::update()
 	{
 		auto frame = (const love::video::VideoStream::Frame*) stream->getFrontBuffer();
 
-		int widths[3]  = {frame->yw, frame->cw, frame->cw};
-		int heights[3] = {frame->yh, frame->ch, frame->ch};
+		double starttime = love::timer::Timer::getTime();
+		uploadFrame(gfx, frame);
+		uploadTime += love::timer::Timer::getTime() - starttime;
+	}
+}
+
+void Video::uploadFrame(Graphics *gfx, const love::video::VideoStream::Frame *frame)
+{
+	int widths[3]  = {frame->yw, frame->cw, frame->cw};
+	int heights[3] = {frame->yh, frame->ch, frame->ch};
 
-		const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
+	const unsigned char *data[3] = {frame->yplane, frame->cbplane, frame->crplane};
 
-		for (int i = 0; i < 3; i++)
-		{
-			size_t bpp = getPixelFormatBlockSize(PIXELFORMAT_R8_UNORM);
-			size_t size = bpp * widths[i] * heights[i];
+	// All three planes are staged in a single mapping, each starting at a
+	// 4 byte aligned offset as required by buffer to texture copies.
+	size_t sizes[3];
+	size_t offsets[3];
+	size_t totalsize = 0;
 
-			Rect rect = {0, 0, widths[i], heights[i]};
-			textures[i]->replacePixels(data[i], size, 0, 0, rect, false);
-		}
+	for (int i = 0; i < 3; i++)
+	{
+		sizes[i] = getPixelFormatSliceSize(PIXELFORMAT_R8_UNORM, widths[i], heights[i]);
+		offsets[i] = totalsize;
+		totalsize += alignUp(sizes[i], 4);
 	}
+
+	// Draws using the previous frame's contents must happen first.
+	Graphics::flushBatchedDrawsGlobal();
+
+	StreamBuffer *buffer = gfx->getTextureUploadBuffer(totalsize);
+
+	StreamBuffer::MapInfo map = buffer->map(totalsize);
+	for (int i = 0; i < 3; i++)
+		memcpy(map.data + offsets[i], data[i], sizes[i]);
+
+	size_t offset = buffer->unmap(totalsize);
+
+	for (int i = 0; i < 3; i++)
+	{
+		Rect rect = {0, 0, widths[i], heights[i]};
+		textures[i]->copyFromStreamBuffer(buffer, offset + offsets[i], widths[i], sizes[i], 0, 0, rect);
+	}
+
+	buffer->markUsed(totalsize);
+
+	uploadBytes += (int64) totalsize;
 }
 
 love::audio::Source *Video::getSource()
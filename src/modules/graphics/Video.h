@@ -22,6 +22,7 @@
 
 // LOVE
 #include "common/math.h"
+#include "common/int.h"
 #include "Drawable.h"
 #include "Texture.h"
 #include "vertex.h"
@@ -41,6 +42,11 @@ class Video : public Drawable
 
 	static love::Type type;
 
+	// Bytes of video frame data uploaded, and the time spent staging them,
+	// since the last present.
+	static int64 uploadBytes;
+	static double uploadTime;
+
 	Video(Graphics *gfx, love::video::VideoStream *stream, float dpiscale = 1.0f);
 	virtual ~Video();
 
@@ -63,7 +69,8 @@ class Video : public Drawable
 
 private:
 
-	void update();
+	void update(Graphics *gfx);
+	void uploadFrame(Graphics *gfx, const love::video::VideoStream::Frame *frame);
 
 	StrongRef<love::video::VideoStream> stream;
 
@@ -219,6 +219,10 @@ bool Buffer::fill(size_t offset, size_t size, const void *data)
 	memcpy(dest, data, size);
 
 	unmap(offset, size);
+
+	++uploadCount;
+	uploadBytes += size;
+
 	return true;
 }}
 
@@ -22,6 +22,7 @@
 #include "StreamBuffer.h"
 #include "Buffer.h"
 #include "Texture.h"
+#include "graphics/Video.h"
 #include "GraphicsReadback.h"
 #include "Shader.h"
 #include "ShaderStage.h"
@@ -1723,11 +1724,16 @@ void Graphics::present(void *screenshotCallbackData)
 	for (StreamBuffer *buffer : batchedDrawState.vb)
 		buffer->nextFrame();
 	batchedDrawState.indexBuffer->nextFrame();
+	if (textureUploadBuffer != nullptr)
+		textureUploadBuffer->nextFrame();
 
 	uniformBuffer->nextFrame();
 	uniformBufferData = {};
 	uniformBufferOffset = 0;
 
+	if (profiler != nullptr)
+		profiler->beginPresent();
+
 	id<MTLCommandBuffer> cmd = getCommandBuffer();
 
 	if (cmd != nil && activeDrawable != nil)
@@ -1796,10 +1802,17 @@ void Graphics::present(void *screenshotCallbackData)
 	shaderSwitches = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Buffer::uploadCount = 0;
+	Buffer::uploadBytes = 0;
+	Video::uploadBytes = 0;
+	Video::uploadTime = 0.0;
 
 	updatePendingReadbacks();
 	updateTemporaryResources();
 	processCompletedCommandBuffers();
+
+	if (profiler != nullptr)
+		profiler->endPresent();
 }}
 
 int Graphics::getBackbufferMSAA() const
@@ -43,6 +43,7 @@ class Texture final : public love::graphics::Texture
 
 	void copyFromBuffer(love::graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 	void copyToBuffer(love::graphics::Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth, size_t size) override;
+	void copyFromStreamBuffer(love::graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 
 	void setSamplerState(const SamplerState &s) override;
 
@@ -58,6 +59,7 @@ class Texture final : public love::graphics::Texture
 
 	void uploadByteData(const void *data, size_t size, int level, int slice, const Rect &r) override;
 	void generateMipmapsInternal() override;
+	void copyFromBufferHandle(id<MTLBuffer> buffer, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect);
 
 	id<MTLTexture> texture = nil;
 	id<MTLTexture> msaaTexture = nil;
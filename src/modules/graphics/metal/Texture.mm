@@ -20,6 +20,7 @@
 
 #include "Texture.h"
 #include "Graphics.h"
+#include "graphics/StreamBuffer.h"
 
 namespace love
 {
@@ -320,8 +321,19 @@ void Texture::generateMipmapsInternal()
 
 void Texture::copyFromBuffer(love::graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
 { @autoreleasepool {
-	id<MTLBlitCommandEncoder> encoder = Graphics::getInstance()->useBlitEncoder();
 	id<MTLBuffer> buffer = (__bridge id<MTLBuffer>)(void *) source->getHandle();
+	copyFromBufferHandle(buffer, sourceoffset, sourcewidth, size, slice, mipmap, rect);
+}}
+
+void Texture::copyFromStreamBuffer(love::graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{ @autoreleasepool {
+	id<MTLBuffer> buffer = (__bridge id<MTLBuffer>)(void *) source->getHandle();
+	copyFromBufferHandle(buffer, sourceoffset, sourcewidth, size, slice, mipmap, rect);
+}}
+
+void Texture::copyFromBufferHandle(id<MTLBuffer> buffer, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{ @autoreleasepool {
+	id<MTLBlitCommandEncoder> encoder = Graphics::getInstance()->useBlitEncoder();
 
 	size_t rowSize = 0;
 	if (isCompressed())
@@ -292,6 +292,9 @@ bool Buffer::fill(size_t offset, size_t size, const void *data)
 		glBufferSubData(target, (GLintptr) offset, (GLsizeiptr) size, data);
 	}
 
+	++uploadCount;
+	uploadBytes += size;
+
 	return true;
 }
 
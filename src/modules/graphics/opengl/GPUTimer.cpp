@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "GPUTimer.h"
+
+namespace love
+{
+namespace graphics
+{
+namespace opengl
+{
+
+GPUTimer::GPUTimer()
+	: generation(0)
+	, useEXT(false)
+{
+	loadVolatile();
+}
+
+GPUTimer::~GPUTimer()
+{
+	unloadVolatile();
+}
+
+bool GPUTimer::isSupported()
+{
+	if (GLAD_VERSION_3_3 || GLAD_ARB_timer_query)
+		return true;
+
+	if (GLAD_EXT_disjoint_timer_query)
+	{
+		// Some implementations of the extension don't support timestamp
+		// counters, only elapsed time queries.
+		GLint bits = 0;
+		glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &bits);
+		return bits > 0;
+	}
+
+	return false;
+}
+
+bool GPUTimer::loadVolatile()
+{
+	useEXT = !(GLAD_VERSION_3_3 || GLAD_ARB_timer_query);
+	return true;
+}
+
+void GPUTimer::unloadVolatile()
+{
+	if (!queries.empty())
+	{
+		if (useEXT)
+			glDeleteQueriesEXT((GLsizei) queries.size(), queries.data());
+		else
+			glDeleteQueries((GLsizei) queries.size(), queries.data());
+	}
+
+	queries.clear();
+	freeQueries.clear();
+	generation++;
+}
+
+bool GPUTimer::timestamp(uint64 &handle)
+{
+	GLuint query = 0;
+
+	if (!freeQueries.empty())
+	{
+		query = freeQueries.back();
+		freeQueries.pop_back();
+	}
+	else if (queries.size() < MAX_QUERIES)
+	{
+		if (useEXT)
+			glGenQueriesEXT(1, &query);
+		else
+			glGenQueries(1, &query);
+
+		if (query == 0)
+			return false;
+
+		queries.push_back(query);
+	}
+	else
+		return false;
+
+	if (useEXT)
+		glQueryCounterEXT(query, GL_TIMESTAMP_EXT);
+	else
+		glQueryCounter(query, GL_TIMESTAMP);
+
+	handle = ((uint64) generation << 32) | query;
+	return true;
+}
+
+GPUTimer::Result GPUTimer::getResult(uint64 handle, uint64 &nanoseconds)
+{
+	if (!isCurrent(handle))
+		return RESULT_LOST;
+
+	GLuint query = (GLuint) (handle & 0xFFFFFFFF);
+	GLuint available = 0;
+	GLuint64 result = 0;
+
+	if (useEXT)
+		glGetQueryObjectuivEXT(query, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+	else
+		glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (!available)
+		return RESULT_PENDING;
+
+	if (useEXT)
+		glGetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &result);
+	else
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+
+	freeQueries.push_back(query);
+
+	nanoseconds = result;
+	return RESULT_READY;
+}
+
+void GPUTimer::release(uint64 handle)
+{
+	if (isCurrent(handle))
+		freeQueries.push_back((GLuint) (handle & 0xFFFFFFFF));
+}
+
+bool GPUTimer::getCurrentTime(uint64 &nanoseconds)
+{
+	// GL_TIMESTAMP can only be queried directly with GL 3.3, ARB_timer_query
+	// or EXT_disjoint_timer_query. The extensions don't provide
+	// glGetInteger64v themselves.
+	if (!(GLAD_VERSION_3_3 || GLAD_ARB_timer_query || GLAD_EXT_disjoint_timer_query))
+		return false;
+
+	if (fp_glGetInteger64v == nullptr)
+		return false;
+
+	GLint64 now = 0;
+	glGetInteger64v(useEXT ? GL_TIMESTAMP_EXT : GL_TIMESTAMP, &now);
+
+	if (now <= 0)
+		return false;
+
+	nanoseconds = (uint64) now;
+	return true;
+}
+
+void GPUTimer::newFrame()
+{
+	if (!useEXT)
+		return;
+
+	// A disjoint operation (e.g. a GPU frequency change) makes the results of
+	// every outstanding query meaningless.
+	GLint disjoint = 0;
+	glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+	if (disjoint)
+	{
+		generation++;
+		freeQueries = queries;
+	}
+}
+
+} // opengl
+} // graphics
+} // love
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "graphics/Profiler.h"
+#include "graphics/Volatile.h"
+#include "OpenGL.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+namespace opengl
+{
+
+/**
+ * GPU timestamps using GL_TIMESTAMP query counters (GL 3.3, ARB_timer_query
+ * or EXT_disjoint_timer_query). Query objects are recycled once their results
+ * have been read.
+ **/
+class GPUTimer final : public love::graphics::GPUTimer, public Volatile
+{
+public:
+
+	GPUTimer();
+	virtual ~GPUTimer();
+
+	static bool isSupported();
+
+	// Implements love::graphics::GPUTimer.
+	bool timestamp(uint64 &handle) override;
+	Result getResult(uint64 handle, uint64 &nanoseconds) override;
+	void release(uint64 handle) override;
+	bool getCurrentTime(uint64 &nanoseconds) override;
+	void newFrame() override;
+
+	// Implements Volatile.
+	bool loadVolatile() override;
+	void unloadVolatile() override;
+
+private:
+
+	static const size_t MAX_QUERIES = 4096;
+
+	bool isCurrent(uint64 handle) const { return (uint32) (handle >> 32) == generation; }
+
+	std::vector<GLuint> queries;
+	std::vector<GLuint> freeQueries;
+
+	// Incremented whenever outstanding queries become invalid.
+	uint32 generation;
+
+	bool useEXT;
+
+}; // GPUTimer
+
+} // opengl
+} // graphics
+} // love
@@ -31,6 +31,7 @@
 #include "window/Window.h"
 #include "Buffer.h"
 #include "ShaderStage.h"
+#include "graphics/Video.h"
 
 #include "libraries/xxHash/xxhash.h"
 
@@ -114,6 +115,7 @@ Graphics::Graphics()
 	, internalBackbufferFBO(0)
 	, bufferMapMemory(nullptr)
 	, bufferMapMemorySize(2 * 1024 * 1024)
+	, gpuTimer(nullptr)
 	, pixelFormatUsage()
 {
 	gl = OpenGL();
@@ -146,6 +148,8 @@ Graphics::Graphics()
 
 Graphics::~Graphics()
 {
+	stopProfiling();
+	delete gpuTimer;
 	delete[] bufferMapMemory;
 }
 
@@ -189,6 +193,19 @@ love::graphics::GraphicsReadback *Graphics::newReadbackInternal(ReadbackMethod m
 	return new GraphicsReadback(this, method, texture, slice, mipmap, rect, dest, destx, desty);
 }
 
+love::graphics::GraphicsReadback *Graphics::newBackbufferReadbackInternal(const Rect &rect, image::ImageData *dest)
+{
+	return new GraphicsReadback(this, getSystemBackbufferFBO(), rect, dest);
+}
+
+love::graphics::GPUTimer *Graphics::getGPUTimer()
+{
+	if (gpuTimer == nullptr && GPUTimer::isSupported())
+		gpuTimer = new GPUTimer();
+
+	return gpuTimer;
+}
+
 void Graphics::backbufferChanged(const BackbufferSettings &settings)
 {
 	bool changed = settings != backbufferSettings;
@@ -407,6 +424,11 @@ void Graphics::unSetMode()
 
 	flushBatchedDraws();
 
+	// Screenshot and recording readbacks need the current context to finish.
+	finishPendingScreenshots();
+	if (frameRecorder != nullptr)
+		frameRecorder->finish();
+
 	internalBackbuffer.set(nullptr);
 	internalBackbufferDepthStencil.set(nullptr);
 
@@ -1254,72 +1276,31 @@ void Graphics::present(void *screenshotCallbackData)
 
 	if (!pendingScreenshotCallbacks.empty())
 	{
-		size_t row = 4 * w;
-		size_t size = row * h;
-
-		GLubyte *pixels = nullptr;
-		GLubyte *screenshot = nullptr;
+		// The pixels are copied into a buffer on the GPU and read back once
+		// they're ready, instead of stalling here until the frame is done.
+		love::graphics::GraphicsReadback *readback = nullptr;
 
 		try
 		{
-			pixels = new GLubyte[size];
-			screenshot = new GLubyte[size];
+			readback = newBackbufferReadbackInternal({0, 0, w, h}, nullptr);
 		}
-		catch (std::exception &)
+		catch (love::Exception &)
 		{
-			delete[] pixels;
-			delete[] screenshot;
-			throw love::Exception("Out of memory.");
-		}
-
-		gl.bindFramebuffer(OpenGL::FRAMEBUFFER_ALL, getSystemBackbufferFBO());
-		glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-
-		// Replace alpha values with full opacity.
-		for (size_t i = 3; i < size; i += 4)
-			pixels[i] = 255;
-
-		// OpenGL sucks and reads pixels from the lower-left. Let's fix that.
-		GLubyte *src = pixels - row;
-		GLubyte *dst = screenshot + size;
-
-		for (int i = 0; i < h; ++i)
-			memcpy(dst-=row, src+=row, row);
-
-		delete[] pixels;
-
-		auto imagemodule = Module::getInstance<love::image::Image>(M_IMAGE);
-
-		for (int i = 0; i < (int) pendingScreenshotCallbacks.size(); i++)
-		{
-			const auto &info = pendingScreenshotCallbacks[i];
-			image::ImageData *img = nullptr;
-
-			try
-			{
-				img = imagemodule->newImageData(w, h, PIXELFORMAT_RGBA8_UNORM, screenshot);
-			}
-			catch (love::Exception &)
-			{
-				delete[] screenshot;
+			for (const auto &info : pendingScreenshotCallbacks)
 				info.callback(&info, nullptr, nullptr);
-				for (int j = i + 1; j < (int) pendingScreenshotCallbacks.size(); j++)
-				{
-					const auto &ninfo = pendingScreenshotCallbacks[j];
-					ninfo.callback(&ninfo, nullptr, nullptr);
-				}
-				pendingScreenshotCallbacks.clear();
-				throw;
-			}
-
-			info.callback(&info, img, screenshotCallbackData);
-			img->release();
+			pendingScreenshotCallbacks.clear();
+			throw;
 		}
 
-		delete[] screenshot;
-		pendingScreenshotCallbacks.clear();
+		queueScreenshotReadback(readback);
 	}
 
+	if (frameRecorder != nullptr)
+		frameRecorder->presentFrame(w, h);
+
+	if (profiler != nullptr)
+		profiler->beginPresent();
+
 #ifdef LOVE_IOS
 	// Hack: SDL's color renderbuffer must be bound when swapBuffers is called.
 	SDL_PropertiesID props = SDL_GetWindowProperties(SDL_GL_GetCurrentWindow());
@@ -1330,6 +1311,8 @@ void Graphics::present(void *screenshotCallbackData)
 	for (StreamBuffer *buffer : batchedDrawState.vb)
 		buffer->nextFrame();
 	batchedDrawState.indexBuffer->nextFrame();
+	if (textureUploadBuffer != nullptr)
+		textureUploadBuffer->nextFrame();
 
 	auto window = getInstance<love::window::Window>(M_WINDOW);
 	if (window != nullptr)
@@ -1342,9 +1325,17 @@ void Graphics::present(void *screenshotCallbackData)
 	gl.stats.shaderSwitches = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Buffer::uploadCount = 0;
+	Buffer::uploadBytes = 0;
+	Video::uploadBytes = 0;
+	Video::uploadTime = 0.0;
 
 	updatePendingReadbacks();
+	updatePendingScreenshots(screenshotCallbackData);
 	updateTemporaryResources();
+
+	if (profiler != nullptr)
+		profiler->endPresent();
 }
 
 int Graphics::getBackbufferMSAA() const
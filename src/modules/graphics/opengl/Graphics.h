@@ -38,6 +38,7 @@
 
 #include "Texture.h"
 #include "Shader.h"
+#include "GPUTimer.h"
 
 #include "libraries/xxHash/xxhash.h"
 
@@ -139,6 +140,9 @@ class Graphics final : public love::graphics::Graphics
 
 	love::graphics::GraphicsReadback *newReadbackInternal(ReadbackMethod method, love::graphics::Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset) override;
 	love::graphics::GraphicsReadback *newReadbackInternal(ReadbackMethod method, love::graphics::Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty) override;
+	bool isBackbufferReadbackSupported() const override { return true; }
+	love::graphics::GraphicsReadback *newBackbufferReadbackInternal(const Rect &rect, image::ImageData *dest) override;
+	love::graphics::GPUTimer *getGPUTimer() override;
 
 	void setRenderTargetsInternal(const RenderTargets &rts, int pixelw, int pixelh, bool hasSRGBtexture) override;
 	void initCapabilities() override;
@@ -169,6 +173,8 @@ class Graphics final : public love::graphics::Graphics
 	char *bufferMapMemory;
 	size_t bufferMapMemorySize;
 
+	GPUTimer *gpuTimer;
+
 	// [non-readable, readable]
 	uint32 pixelFormatUsage[PIXELFORMAT_MAX_ENUM][2];
 
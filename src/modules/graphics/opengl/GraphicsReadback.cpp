@@ -84,6 +84,26 @@ GraphicsReadback::GraphicsReadback(love::graphics::Graphics *gfx, ReadbackMethod
 	}
 }
 
+GraphicsReadback::GraphicsReadback(love::graphics::Graphics *gfx, GLuint framebuffer, const Rect &rect, image::ImageData *dest)
+	: love::graphics::GraphicsReadback(READBACK_ASYNC, PIXELFORMAT_RGBA8_UNORM, rect, dest)
+{
+	size_t size = getPixelFormatSliceSize(textureFormat, rect.w, rect.h);
+	stagingBuffer = gfx->getTemporaryBuffer(size, DATAFORMAT_FLOAT, 0, BUFFERDATAUSAGE_READBACK);
+
+	GLuint current_fbo = gl.getFramebuffer(OpenGL::FRAMEBUFFER_ALL);
+	gl.bindFramebuffer(OpenGL::FRAMEBUFFER_ALL, framebuffer);
+
+	// glReadPixels writes to the active PIXEL_PACK_BUFFER instead of client
+	// memory, which lets the copy happen without stalling the GPU.
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, (GLuint) stagingBuffer->getHandle());
+	glReadPixels(rect.x, rect.y, rect.w, rect.h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	gl.bindFramebuffer(OpenGL::FRAMEBUFFER_ALL, current_fbo);
+
+	sync.fence();
+}
+
 GraphicsReadback::~GraphicsReadback()
 {
 }
@@ -24,6 +24,7 @@
 #include "graphics/GraphicsReadback.h"
 #include "graphics/Volatile.h"
 #include "FenceSync.h"
+#include "OpenGL.h"
 #include "common/math.h"
 
 namespace love
@@ -39,6 +40,10 @@ class GraphicsReadback final : public love::graphics::GraphicsReadback, public V
 
 	GraphicsReadback(love::graphics::Graphics *gfx, ReadbackMethod method, love::graphics::Buffer *buffer, size_t offset, size_t size, data::ByteData *dest, size_t destoffset);
 	GraphicsReadback(love::graphics::Graphics *gfx, ReadbackMethod method, love::graphics::Texture *texture, int slice, int mipmap, const Rect &rect, image::ImageData *dest, int destx, int desty);
+
+	// Asynchronously reads RGBA8 pixels from a framebuffer such as the system
+	// backbuffer. Rows are in OpenGL's bottom-to-top order.
+	GraphicsReadback(love::graphics::Graphics *gfx, GLuint framebuffer, const Rect &rect, image::ImageData *dest);
 	virtual ~GraphicsReadback();
 
 	void wait() override;
@@ -23,6 +23,7 @@
 #include "graphics/Graphics.h"
 #include "Graphics.h"
 #include "Buffer.h"
+#include "graphics/StreamBuffer.h"
 #include "common/int.h"
 
 // STD
@@ -530,15 +531,27 @@ void Texture::copyFromBuffer(love::graphics::Buffer *source, size_t sourceoffset
 {
 	// Higher level code does validation.
 
-	GLuint glbuffer = (GLuint) source->getHandle();
-	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, glbuffer);
+	// glTexSubImage and friends copy from the active pixel_unpack_buffer by
+	// treating the pointer as a byte offset.
+	const uint8 *byteoffset = (const uint8 *)(ptrdiff_t)sourceoffset;
+	copyFromBufferHandle((GLuint) source->getHandle(), byteoffset, sourcewidth, size, slice, mipmap, rect);
+}
+
+void Texture::copyFromStreamBuffer(love::graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{
+	// Client memory stream buffers have no GL buffer, and their offsets are
+	// pointers to the data instead, which works the same way here.
+	const uint8 *byteoffset = (const uint8 *)(ptrdiff_t)sourceoffset;
+	copyFromBufferHandle((GLuint) source->getHandle(), byteoffset, sourcewidth, size, slice, mipmap, rect);
+}
+
+void Texture::copyFromBufferHandle(GLuint buffer, const uint8 *byteoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
 
 	if (!isCompressed()) // Not supported in GL with compressed textures...
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, sourcewidth);
 
-	// glTexSubImage and friends copy from the active pixel_unpack_buffer by
-	// treating the pointer as a byte offset.
-	const uint8 *byteoffset = (const uint8 *)(ptrdiff_t)sourceoffset;
 	uploadByteData(byteoffset, size, mipmap, slice, rect);
 
 	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
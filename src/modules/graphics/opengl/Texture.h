@@ -49,6 +49,7 @@ class Texture final : public love::graphics::Texture, public Volatile
 
 	void copyFromBuffer(love::graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 	void copyToBuffer(love::graphics::Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth, size_t size) override;
+	void copyFromStreamBuffer(love::graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 
 	void setSamplerState(const SamplerState &s) override;
 
@@ -66,6 +67,7 @@ class Texture final : public love::graphics::Texture, public Volatile
 	void createTexture();
 
 	void uploadByteData(const void *data, size_t size, int level, int slice, const Rect &r) override;
+	void copyFromBufferHandle(GLuint buffer, const uint8 *byteoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect);
 
 	void generateMipmapsInternal() override;
 
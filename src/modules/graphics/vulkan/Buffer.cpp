@@ -284,6 +284,9 @@ bool Buffer::fill(size_t offset, size_t size, const void *data)
 		vmaDestroyBuffer(allocator, fillBuffer, fillAllocation);
 	});
 
+	++uploadCount;
+	uploadBytes += size;
+
 	return true;
 }
 
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "GPUTimer.h"
+#include "Graphics.h"
+
+namespace love
+{
+namespace graphics
+{
+namespace vulkan
+{
+
+GPUTimer::GPUTimer(Graphics *vgfx)
+	: vgfx(vgfx)
+{
+	loadVolatile();
+}
+
+GPUTimer::~GPUTimer()
+{
+	unloadVolatile();
+}
+
+bool GPUTimer::loadVolatile()
+{
+	if (queryPool != VK_NULL_HANDLE)
+		return true;
+
+	uint32 validBits = 0;
+	if (!vgfx->getTimestampProperties(nanosecondsPerTick, validBits))
+		return false;
+
+	validMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+	VkQueryPoolCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	createInfo.queryCount = QUERIES_PER_FRAME * MAX_FRAMES_IN_FLIGHT;
+
+	if (vkCreateQueryPool(vgfx->getDevice(), &createInfo, nullptr, &queryPool) != VK_SUCCESS)
+	{
+		queryPool = VK_NULL_HANDLE;
+		return false;
+	}
+
+	return true;
+}
+
+void GPUTimer::unloadVolatile()
+{
+	for (FrameQueries &frame : frames)
+	{
+		frame.generation++;
+		frame.count = 0;
+		frame.active = false;
+		frame.hasResults = false;
+	}
+
+	if (queryPool == VK_NULL_HANDLE)
+		return;
+
+	vgfx->queueCleanUp([device = vgfx->getDevice(), queryPool = queryPool]() {
+		vkDestroyQueryPool(device, queryPool, nullptr);
+	});
+
+	queryPool = VK_NULL_HANDLE;
+}
+
+void GPUTimer::beginFrame(VkCommandBuffer commandBuffer)
+{
+	if (queryPool == VK_NULL_HANDLE)
+		return;
+
+	frameIndex = (frameIndex + 1) % MAX_FRAMES_IN_FLIGHT;
+	FrameQueries &frame = frames[frameIndex];
+	uint32 first = frameIndex * QUERIES_PER_FRAME;
+
+	// The last commands which used this range have completed by the time it's
+	// reused, so its results can be read without waiting.
+	frame.hasResults = false;
+	if (frame.active && frame.count > 0)
+	{
+		frame.results.resize(frame.count);
+		VkResult result = vkGetQueryPoolResults(
+			vgfx->getDevice(), queryPool, first, frame.count,
+			frame.results.size() * sizeof(uint64), frame.results.data(),
+			sizeof(uint64), VK_QUERY_RESULT_64_BIT);
+
+		frame.hasResults = result == VK_SUCCESS;
+		frame.resultsGeneration = frame.generation;
+	}
+
+	frame.generation++;
+	frame.count = 0;
+
+	vkCmdResetQueryPool(commandBuffer, queryPool, first, QUERIES_PER_FRAME);
+	frame.active = true;
+}
+
+bool GPUTimer::timestamp(uint64 &handle)
+{
+	FrameQueries &frame = frames[frameIndex];
+
+	if (queryPool == VK_NULL_HANDLE || !frame.active || frame.count >= QUERIES_PER_FRAME)
+		return false;
+
+	uint32 query = frameIndex * QUERIES_PER_FRAME + frame.count;
+	vkCmdWriteTimestamp(vgfx->getActiveCommandBuffer(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, query);
+
+	handle = ((uint64) frame.generation << 32) | ((uint64) frameIndex << 16) | frame.count;
+	frame.count++;
+
+	return true;
+}
+
+GPUTimer::Result GPUTimer::getResult(uint64 handle, uint64 &nanoseconds)
+{
+	uint32 generation = (uint32) (handle >> 32);
+	uint32 index = (uint32) ((handle >> 16) & 0xFFFF);
+	uint32 query = (uint32) (handle & 0xFFFF);
+
+	if (index >= MAX_FRAMES_IN_FLIGHT)
+		return RESULT_LOST;
+
+	const FrameQueries &frame = frames[index];
+
+	if (frame.active && generation == frame.generation)
+		return RESULT_PENDING;
+
+	if (!frame.hasResults || generation != frame.resultsGeneration || query >= frame.results.size())
+		return RESULT_LOST;
+
+	nanoseconds = (uint64) ((double) (frame.results[query] & validMask) * nanosecondsPerTick);
+	return RESULT_READY;
+}
+
+} // vulkan
+} // graphics
+} // love
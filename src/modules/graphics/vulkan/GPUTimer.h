@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+#include "graphics/Profiler.h"
+#include "graphics/Volatile.h"
+
+#include "Vulkan.h"
+#include "VulkanWrapper.h"
+
+#include <vector>
+
+namespace love
+{
+namespace graphics
+{
+namespace vulkan
+{
+
+class Graphics;
+
+// GPU timestamps written with vkCmdWriteTimestamp. Each frame in flight has its
+// own range of queries in a single pool, and a frame's results are read back
+// when its range is reset, MAX_FRAMES_IN_FLIGHT frames after it was recorded.
+class GPUTimer final
+	: public love::graphics::GPUTimer
+	, public Volatile
+{
+public:
+	GPUTimer(Graphics *vgfx);
+	virtual ~GPUTimer();
+
+	bool timestamp(uint64 &handle) override;
+	Result getResult(uint64 handle, uint64 &nanoseconds) override;
+	void release(uint64 /*handle*/) override {}
+
+	virtual bool loadVolatile() override;
+	virtual void unloadVolatile() override;
+
+	// Must be called at the start of each frame's command buffer, outside of a
+	// render pass.
+	void beginFrame(VkCommandBuffer commandBuffer);
+
+private:
+	static constexpr uint32 QUERIES_PER_FRAME = 1024;
+
+	struct FrameQueries
+	{
+		uint32 generation = 0;
+		uint32 count = 0;
+		bool active = false;
+
+		uint32 resultsGeneration = 0;
+		bool hasResults = false;
+		std::vector<uint64> results;
+	};
+
+	Graphics *vgfx;
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+
+	double nanosecondsPerTick = 1.0;
+	uint64 validMask = 0;
+
+	FrameQueries frames[MAX_FRAMES_IN_FLIGHT];
+	uint32 frameIndex = 0;
+};
+
+} // vulkan
+} // graphics
+} // love
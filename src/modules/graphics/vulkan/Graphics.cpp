@@ -28,6 +28,7 @@
 #include "GraphicsReadback.h"
 #include "Shader.h"
 #include "Vulkan.h"
+#include "graphics/Video.h"
 
 #include <SDL3/SDL_vulkan.h>
 #include <SDL3/SDL_hints.h>
@@ -228,6 +229,9 @@ Graphics::Graphics()
 
 Graphics::~Graphics()
 {
+	stopProfiling();
+	delete gpuTimer;
+
 	defaultVertexBuffer.set(nullptr);
 	localUniformBuffer.set(nullptr);
 
@@ -596,6 +600,12 @@ void Graphics::present(void *screenshotCallbackdata)
 
 	deprecations.draw(this);
 
+	if (profiler != nullptr)
+	{
+		flushBatchedDraws();
+		profiler->beginPresent();
+	}
+
 	StrongRef<image::ImageData> screenshotImageData = submitGpuCommands(SUBMIT_PRESENT);
 
 	VkResult result = VK_SUCCESS;
@@ -654,10 +664,16 @@ void Graphics::present(void *screenshotCallbackdata)
 	for (love::graphics::StreamBuffer *buffer : batchedDrawState.vb)
 		buffer->nextFrame();
 	batchedDrawState.indexBuffer->nextFrame();
+	if (textureUploadBuffer != nullptr)
+		textureUploadBuffer->nextFrame();
 
 	drawCalls = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Buffer::uploadCount = 0;
+	Buffer::uploadBytes = 0;
+	Video::uploadBytes = 0;
+	Video::uploadTime = 0.0;
 
 	updatePendingReadbacks();
 	updateTemporaryResources();
@@ -676,6 +692,9 @@ void Graphics::present(void *screenshotCallbackdata)
 		}
 		pendingScreenshotCallbacks.clear();
 	}
+
+	if (profiler != nullptr)
+		profiler->endPresent();
 }
 
 void Graphics::backbufferChanged(const BackbufferSettings &settings)
@@ -1486,6 +1505,9 @@ void Graphics::beginSwapChainFrame()
 
 	startRecordingGraphicsCommands();
 
+	if (gpuTimer != nullptr)
+		gpuTimer->beginFrame(commandBuffers.at(currentFrame));
+
 	if (!swapChainImages.empty())
 	{
 		Vulkan::cmdTransitionImageLayout(
@@ -1601,6 +1623,41 @@ VkCommandBuffer Graphics::getCommandBufferForDataTransfer()
 	return commandBuffers.at(currentFrame);
 }
 
+bool Graphics::getTimestampProperties(double &nanosecondsPerTick, uint32 &validBits)
+{
+	if (physicalDevice == VK_NULL_HANDLE)
+		return false;
+
+	QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+	if (!indices.graphicsFamily.hasValue)
+		return false;
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	if (indices.graphicsFamily.value >= queueFamilyCount)
+		return false;
+
+	nanosecondsPerTick = properties.limits.timestampPeriod;
+	validBits = queueFamilies[indices.graphicsFamily.value].timestampValidBits;
+
+	return validBits > 0 && nanosecondsPerTick > 0.0;
+}
+
+love::graphics::GPUTimer *Graphics::getGPUTimer()
+{
+	if (gpuTimer == nullptr && device != VK_NULL_HANDLE)
+		gpuTimer = new GPUTimer(this);
+
+	return gpuTimer;
+}
+
 void Graphics::queueCleanUp(std::function<void()> cleanUp)
 {
 	cleanUpFunctions.at(currentFrame).push_back(cleanUp);
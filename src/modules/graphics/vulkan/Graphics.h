@@ -27,6 +27,7 @@
 #include "ShaderStage.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "GPUTimer.h"
 
 // libraries
 #include "VulkanWrapper.h"
@@ -280,6 +281,8 @@ class Graphics final : public love::graphics::Graphics
 	VkDevice getDevice() const;
 	VmaAllocator getVmaAllocator() const;
 	VkCommandBuffer getCommandBufferForDataTransfer();
+	VkCommandBuffer getActiveCommandBuffer() const { return commandBuffers.at(currentFrame); }
+	bool getTimestampProperties(double &nanosecondsPerTick, uint32 &validBits);
 	void queueCleanUp(std::function<void()> cleanUp);
 	void addReadbackCallback(std::function<void()> callback);
 	StrongRef<image::ImageData> submitGpuCommands(SubmitMode);
@@ -311,6 +314,7 @@ class Graphics final : public love::graphics::Graphics
 	void initCapabilities() override;
 	void getAPIStats(int &shaderswitches) const override;
 	void setRenderTargetsInternal(const RenderTargets &rts, int pixelw, int pixelh, bool hasSRGBtexture) override;
+	love::graphics::GPUTimer *getGPUTimer() override;
 
 private:
 
@@ -437,6 +441,7 @@ class Graphics final : public love::graphics::Graphics
 	std::vector<std::vector<std::function<void()>>> readbackCallbacks;
 	std::set<StrongRef<Shader>> usedShadersInFrame;
 	RenderpassState renderPassState;
+	GPUTimer *gpuTimer = nullptr;
 };
 
 } // vulkan
@@ -31,9 +31,10 @@ namespace vulkan
 
 static VkBufferUsageFlags getUsageFlags(BufferUsage mode)
 {
+	// Vertex stream buffers are also used to stage texture uploads.
 	switch (mode)
 	{
-	case BUFFERUSAGE_VERTEX: return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+	case BUFFERUSAGE_VERTEX: return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 	case BUFFERUSAGE_INDEX: return VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 	case BUFFERUSAGE_UNIFORM: return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 	default:
@@ -22,6 +22,7 @@
 #include "Graphics.h"
 #include "Vulkan.h"
 #include "Buffer.h"
+#include "graphics/StreamBuffer.h"
 
 #include <limits>
 #include <array>
@@ -716,6 +717,16 @@ void Texture::uploadByteData(const void *data, size_t size, int level, int slice
 }
 
 void Texture::copyFromBuffer(graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{
+	copyFromBufferHandle((VkBuffer) source->getHandle(), sourceoffset, sourcewidth, slice, mipmap, rect);
+}
+
+void Texture::copyFromStreamBuffer(graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect)
+{
+	copyFromBufferHandle((VkBuffer) source->getHandle(), sourceoffset, sourcewidth, slice, mipmap, rect);
+}
+
+void Texture::copyFromBufferHandle(VkBuffer buffer, size_t sourceoffset, int sourcewidth, int slice, int mipmap, const Rect &rect)
 {
 	auto commandBuffer = vgfx->getCommandBufferForDataTransfer();
 
@@ -738,7 +749,7 @@ void Texture::copyFromBuffer(graphics::Buffer *source, size_t sourceoffset, int
 	VkImageLayout copyDstLayout = imageData.layout == VK_IMAGE_LAYOUT_GENERAL ? imageData.layout : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 	Vulkan::cmdTransitionImageLayout(commandBuffer, imageData.image, format, renderTarget, imageData.layout, copyDstLayout, layers.mipLevel, 1, layers.baseArrayLayer, 1);
 
-	vkCmdCopyBufferToImage(commandBuffer, (VkBuffer)source->getHandle(), imageData.image, copyDstLayout, 1, &region);
+	vkCmdCopyBufferToImage(commandBuffer, buffer, imageData.image, copyDstLayout, 1, &region);
 
 	Vulkan::cmdTransitionImageLayout(commandBuffer, imageData.image, format, renderTarget, copyDstLayout, imageData.layout, layers.mipLevel, 1, layers.baseArrayLayer, 1);
 }
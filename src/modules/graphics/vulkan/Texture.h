@@ -55,6 +55,7 @@ class Texture final
 
 	void copyFromBuffer(graphics::Buffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 	void copyToBuffer(graphics::Buffer *dest, int slice, int mipmap, const Rect &rect, size_t destoffset, int destwidth, size_t size) override;
+	void copyFromStreamBuffer(graphics::StreamBuffer *source, size_t sourceoffset, int sourcewidth, size_t size, int slice, int mipmap, const Rect &rect) override;
 
 	ptrdiff_t getRenderTargetHandle() const override;
 	ptrdiff_t getSamplerHandle() const override;
@@ -74,6 +75,8 @@ class Texture final
 
 private:
 
+	void copyFromBufferHandle(VkBuffer buffer, size_t sourceoffset, int sourcewidth, int slice, int mipmap, const Rect &rect);
+
 	struct VulkanImageData
 	{
 		VkImage image = VK_NULL_HANDLE;
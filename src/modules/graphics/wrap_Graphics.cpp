@@ -557,6 +557,206 @@ int w_captureScreenshot(lua_State *L)
 	return 0;
 }
 
+static int pushRecordingStats(lua_State *L, const FrameRecorder::Stats &stats)
+{
+	lua_createtable(L, 0, 6);
+
+	lua_pushnumber(L, (lua_Number) stats.presentedFrames);
+	lua_setfield(L, -2, "presented");
+
+	lua_pushnumber(L, (lua_Number) stats.capturedFrames);
+	lua_setfield(L, -2, "captured");
+
+	lua_pushnumber(L, (lua_Number) stats.droppedFrames);
+	lua_setfield(L, -2, "dropped");
+
+	lua_pushnumber(L, (lua_Number) stats.writtenFrames);
+	lua_setfield(L, -2, "written");
+
+	lua_pushnumber(L, (lua_Number) stats.failedFrames);
+	lua_setfield(L, -2, "failed");
+
+	lua_pushinteger(L, stats.pendingFrames);
+	lua_setfield(L, -2, "pending");
+
+	return 1;
+}
+
+int w_startRecording(lua_State *L)
+{
+	FrameRecorder::Settings settings;
+
+	if (!lua_isnoneornil(L, 1))
+	{
+		luaL_checktype(L, 1, LUA_TTABLE);
+
+		lua_getfield(L, 1, "format");
+		if (!lua_isnoneornil(L, -1))
+		{
+			const char *str = luaL_checkstring(L, -1);
+			if (!FrameRecorder::getConstant(str, settings.format))
+				return luax_enumerror(L, "recording format", FrameRecorder::getConstants(settings.format), str);
+		}
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "directory");
+		if (!lua_isnoneornil(L, -1))
+			settings.directory = luax_checkstring(L, -1);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "interval");
+		settings.interval = (int) luaL_optinteger(L, -1, settings.interval);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "maxpending");
+		settings.maxPendingFrames = (int) luaL_optinteger(L, -1, settings.maxPendingFrames);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "wait");
+		settings.wait = luax_optboolean(L, -1, settings.wait);
+		lua_pop(L, 1);
+	}
+
+	luax_catchexcept(L, [&]() { instance()->startRecording(settings); });
+	return 0;
+}
+
+int w_stopRecording(lua_State *L)
+{
+	FrameRecorder::Stats stats;
+	luax_catchexcept(L, [&]() { stats = instance()->stopRecording(); });
+	return pushRecordingStats(L, stats);
+}
+
+int w_isRecording(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isRecording());
+	return 1;
+}
+
+int w_getRecordingStats(lua_State *L)
+{
+	return pushRecordingStats(L, instance()->getRecordingStats());
+}
+
+int w_startProfiling(lua_State *L)
+{
+	Profiler::Settings settings;
+
+	if (!lua_isnoneornil(L, 1))
+	{
+		luaL_checktype(L, 1, LUA_TTABLE);
+
+		lua_getfield(L, 1, "frames");
+		settings.frames = (int) luaL_optinteger(L, -1, settings.frames);
+		lua_pop(L, 1);
+
+		lua_getfield(L, 1, "gpu");
+		settings.gpu = luax_optboolean(L, -1, settings.gpu);
+		lua_pop(L, 1);
+	}
+
+	if (settings.frames < 1)
+		return luaL_error(L, "Number of profiled frames must be at least 1.");
+
+	luax_catchexcept(L, [&]() { instance()->startProfiling(settings); });
+	return 0;
+}
+
+int w_stopProfiling(lua_State *)
+{
+	instance()->stopProfiling();
+	return 0;
+}
+
+int w_isProfiling(lua_State *L)
+{
+	luax_pushboolean(L, instance()->isProfiling());
+	return 1;
+}
+
+int w_pushProfileZone(lua_State *L)
+{
+	const char *name = luaL_checkstring(L, 1);
+	luax_catchexcept(L, [&]() { instance()->pushProfileZone(name); });
+	return 0;
+}
+
+int w_popProfileZone(lua_State *L)
+{
+	luax_catchexcept(L, [&]() { instance()->popProfileZone(); });
+	return 0;
+}
+
+int w_getProfileZones(lua_State *L)
+{
+	const Profiler *profiler = instance()->getProfiler();
+	const Profiler::Frame *frame = profiler != nullptr ? profiler->getLatestFrame() : nullptr;
+
+	if (frame == nullptr)
+	{
+		lua_newtable(L);
+		return 1;
+	}
+
+	double framestart = frame->zones.empty() ? 0.0 : frame->zones[0].cpuStart;
+
+	// Not every zone has a GPU time, so measure from the first one that does.
+	double gpuframestart = 0.0;
+	for (const Profiler::Zone &zone : frame->zones)
+	{
+		if (zone.gpuStart >= 0.0)
+		{
+			gpuframestart = zone.gpuStart;
+			break;
+		}
+	}
+
+	lua_createtable(L, (int) frame->zones.size(), 0);
+
+	for (size_t i = 0; i < frame->zones.size(); i++)
+	{
+		const Profiler::Zone &zone = frame->zones[i];
+
+		lua_createtable(L, 0, 6);
+
+		luax_pushstring(L, profiler->getZoneName(zone.name));
+		lua_setfield(L, -2, "name");
+
+		lua_pushinteger(L, zone.depth);
+		lua_setfield(L, -2, "depth");
+
+		lua_pushnumber(L, zone.cpuStart - framestart);
+		lua_setfield(L, -2, "cpustart");
+
+		lua_pushnumber(L, zone.cpuEnd - zone.cpuStart);
+		lua_setfield(L, -2, "cputime");
+
+		if (zone.gpuStart >= 0.0)
+		{
+			lua_pushnumber(L, zone.gpuStart - gpuframestart);
+			lua_setfield(L, -2, "gpustart");
+
+			lua_pushnumber(L, zone.gpuEnd - zone.gpuStart);
+			lua_setfield(L, -2, "gputime");
+		}
+
+		lua_rawseti(L, -2, (int) i + 1);
+	}
+
+	lua_pushnumber(L, (lua_Number) frame->index);
+	return 2;
+}
+
+int w_saveProfile(lua_State *L)
+{
+	std::string filename = luax_checkstring(L, 1);
+	int frames = 0;
+	luax_catchexcept(L, [&]() { frames = instance()->saveProfile(filename); });
+	lua_pushinteger(L, frames);
+	return 1;
+}
+
 int w_setScissor(lua_State *L)
 {
 	int nargs = lua_gettop(L);
@@ -1441,16 +1641,18 @@ int w_newSpriteBatch(lua_State *L)
 	Texture *texture = luax_checktexture(L, 1);
 	int size = (int) luaL_optinteger(L, 2, 1000);
 	BufferDataUsage usage = BUFFERDATAUSAGE_DYNAMIC;
-	if (lua_gettop(L) > 2)
+	if (!lua_isnoneornil(L, 3))
 	{
 		const char *usagestr = luaL_checkstring(L, 3);
 		if (!getConstant(usagestr, usage))
 			return luax_enumerror(L, "usage hint", getConstants(usage), usagestr);
 	}
 
+	bool instanced = luax_optboolean(L, 4, false);
+
 	SpriteBatch *t = nullptr;
 	luax_catchexcept(L,
-		[&](){ t = instance()->newSpriteBatch(texture, size, usage); }
+		[&](){ t = instance()->newSpriteBatch(texture, size, usage, instanced); }
 	);
 
 	luax_pushtype(L, t);
@@ -2347,7 +2549,15 @@ int w_newVideo(lua_State *L)
 	luax_checkgraphicscreated(L);
 
 	if (!luax_istype(L, 1, love::video::VideoStream::type))
-		luax_convobj(L, 1, "video", "newVideoStream");
+	{
+		if (lua_isnoneornil(L, 3) && lua_isnoneornil(L, 4))
+			luax_convobj(L, 1, "video", "newVideoStream");
+		else
+		{
+			int idxs[] = {1, 3, 4};
+			luax_convobj(L, idxs, 3, "video", "newVideoStream");
+		}
+	}
 
 	auto stream = luax_checktype<love::video::VideoStream>(L, 1);
 	float dpiscale = (float) luaL_optnumber(L, 2, 1.0);
@@ -3206,7 +3416,7 @@ int w_getStats(lua_State *L)
 	if (lua_istable(L, 1))
 		lua_pushvalue(L, 1);
 	else
-		lua_createtable(L, 0, 7);
+		lua_createtable(L, 0, 13);
 
 	lua_pushinteger(L, stats.drawCalls);
 	lua_setfield(L, -2, "drawcalls");
@@ -3235,6 +3445,18 @@ int w_getStats(lua_State *L)
 	lua_pushnumber(L, (lua_Number) stats.bufferMemory);
 	lua_setfield(L, -2, "buffermemory");
 
+	lua_pushinteger(L, stats.bufferUploads);
+	lua_setfield(L, -2, "bufferuploads");
+
+	lua_pushnumber(L, (lua_Number) stats.bufferUploadBytes);
+	lua_setfield(L, -2, "bufferuploadbytes");
+
+	lua_pushnumber(L, (lua_Number) stats.videoUploadBytes);
+	lua_setfield(L, -2, "videouploadbytes");
+
+	lua_pushnumber(L, stats.videoUploadTime);
+	lua_setfield(L, -2, "videouploadtime");
+
 	return 1;
 }
 
@@ -4004,6 +4226,17 @@ int w_inverseTransformPoint(lua_State *L)
 	return 2;
 }
 
+int w_transformPoints(lua_State *L)
+{
+	return love::math::luax_transformpoints(L, 1, instance()->getTransform());
+}
+
+int w_inverseTransformPoints(lua_State *L)
+{
+	Matrix4 inverse = instance()->getTransform().inverse();
+	return love::math::luax_transformpoints(L, 1, inverse);
+}
+
 int w_setProjection(lua_State *L)
 {
 	math::Transform *transform = luax_totype<math::Transform>(L, 1);
@@ -4122,6 +4355,17 @@ static const luaL_Reg functions[] =
 	{ "getStats", w_getStats },
 
 	{ "captureScreenshot", w_captureScreenshot },
+	{ "startRecording", w_startRecording },
+	{ "stopRecording", w_stopRecording },
+	{ "isRecording", w_isRecording },
+	{ "getRecordingStats", w_getRecordingStats },
+	{ "startProfiling", w_startProfiling },
+	{ "stopProfiling", w_stopProfiling },
+	{ "isProfiling", w_isProfiling },
+	{ "pushProfileZone", w_pushProfileZone },
+	{ "popProfileZone", w_popProfileZone },
+	{ "getProfileZones", w_getProfileZones },
+	{ "saveProfile", w_saveProfile },
 
 	{ "draw", w_draw },
 	{ "drawLayer", w_drawLayer },
@@ -4184,6 +4428,8 @@ static const luaL_Reg functions[] =
 	{ "replaceTransform", w_replaceTransform },
 	{ "transformPoint", w_transformPoint },
 	{ "inverseTransformPoint", w_inverseTransformPoint },
+	{ "transformPoints", w_transformPoints },
+	{ "inverseTransformPoints", w_inverseTransformPoints },
 
 	{ "setProjection", w_setProjection },
 	{ "resetProjection", w_resetProjection },
@@ -31,7 +31,7 @@ function graphics.newVideo(file, settings)
 	settings = settings == nil and {} or settings
 	if type(settings) ~= "table" then error("bad argument #2 to newVideo (expected table)", 2) end
 
-	local video = love.graphics._newVideo(file, settings.dpiscale)
+	local video = love.graphics._newVideo(file, settings.dpiscale, settings.bufferframes, settings.cachekeyframes)
 	local source, success
 
 	if settings.audio ~= false and love.audio then
@@ -23,6 +23,10 @@
 #include "Texture.h"
 #include "wrap_Texture.h"
 
+// C++
+#include <algorithm>
+#include <vector>
+
 namespace love
 {
 namespace graphics
@@ -122,6 +126,131 @@ int w_SpriteBatch_setLayer(lua_State *L)
 	return 0;
 }
 
+static int w_SpriteBatch_addMany_or_setMany(lua_State *L, SpriteBatch *t, int startidx, int index)
+{
+	const int components = (int) (sizeof(SpriteBatch::SpriteData) / sizeof(float));
+
+	std::vector<SpriteBatch::SpriteData> spritestorage;
+	const SpriteBatch::SpriteData *sprites = nullptr;
+	int count = 0;
+
+	if (luax_istype(L, startidx, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, startidx);
+		if (data->getSize() % sizeof(SpriteBatch::SpriteData) != 0)
+			return luaL_error(L, "Sprite data size must be a multiple of %d bytes.", (int) sizeof(SpriteBatch::SpriteData));
+
+		sprites = (const SpriteBatch::SpriteData *) data->getData();
+		count = (int) (data->getSize() / sizeof(SpriteBatch::SpriteData));
+	}
+	else
+	{
+		luaL_checktype(L, startidx, LUA_TTABLE);
+		int len = (int) luax_objlen(L, startidx);
+		if (len % components != 0)
+			return luaL_error(L, "Sprite table length must be a multiple of %d.", components);
+
+		count = len / components;
+		spritestorage.resize(count);
+
+		float *values = (float *) spritestorage.data();
+		for (int i = 0; i < len; i++)
+		{
+			lua_rawgeti(L, startidx, i + 1);
+			values[i] = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 1);
+		}
+
+		sprites = spritestorage.data();
+	}
+
+	std::vector<Quad *> quads;
+	if (!lua_isnoneornil(L, startidx + 1))
+	{
+		luaL_checktype(L, startidx + 1, LUA_TTABLE);
+		int len = (int) luax_objlen(L, startidx + 1);
+		quads.reserve(len);
+
+		for (int i = 1; i <= len; i++)
+		{
+			lua_rawgeti(L, startidx + 1, i);
+			quads.push_back(luax_checktype<Quad>(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+
+	std::vector<Color32> colorstorage;
+	const Color32 *colors = nullptr;
+	int colorsidx = startidx + 2;
+
+	if (luax_istype(L, colorsidx, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, colorsidx);
+		if (data->getSize() < sizeof(Color32) * count)
+			return luaL_error(L, "Color data must contain at least %d bytes.", (int) sizeof(Color32) * count);
+
+		colors = (const Color32 *) data->getData();
+	}
+	else if (!lua_isnoneornil(L, colorsidx))
+	{
+		luaL_checktype(L, colorsidx, LUA_TTABLE);
+		if ((int) luax_objlen(L, colorsidx) < count * 4)
+			return luaL_error(L, "Color table must contain at least %d values.", count * 4);
+
+		colorstorage.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			for (int j = 1; j <= 4; j++)
+				lua_rawgeti(L, colorsidx, i * 4 + j);
+
+			Colorf c;
+			c.r = (float) luaL_checknumber(L, -4);
+			c.g = (float) luaL_checknumber(L, -3);
+			c.b = (float) luaL_checknumber(L, -2);
+			c.a = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 4);
+
+			c.r = std::min(std::max(c.r, 0.0f), 1.0f);
+			c.g = std::min(std::max(c.g, 0.0f), 1.0f);
+			c.b = std::min(std::max(c.b, 0.0f), 1.0f);
+			c.a = std::min(std::max(c.a, 0.0f), 1.0f);
+			colorstorage[i] = toColor32(c);
+		}
+
+		colors = colorstorage.data();
+	}
+
+	luax_catchexcept(L, [&]() { index = t->addMany(sprites, count, quads, colors, index); });
+	return index;
+}
+
+int w_SpriteBatch_addMany(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+
+	int index = w_SpriteBatch_addMany_or_setMany(L, t, 2, -1);
+	lua_pushinteger(L, index + 1);
+
+	return 1;
+}
+
+int w_SpriteBatch_setMany(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	int index = (int) luaL_checkinteger(L, 2) - 1;
+
+	w_SpriteBatch_addMany_or_setMany(L, t, 3, index);
+
+	return 0;
+}
+
+int w_SpriteBatch_isInstanced(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	luax_pushboolean(L, t->isInstanced());
+	return 1;
+}
+
 int w_SpriteBatch_clear(lua_State *L)
 {
 	SpriteBatch *t = luax_checkspritebatch(L, 1);
@@ -266,6 +395,9 @@ static const luaL_Reg w_SpriteBatch_functions[] =
 	{ "set", w_SpriteBatch_set },
 	{ "addLayer", w_SpriteBatch_addLayer },
 	{ "setLayer", w_SpriteBatch_setLayer },
+	{ "addMany", w_SpriteBatch_addMany },
+	{ "setMany", w_SpriteBatch_setMany },
+	{ "isInstanced", w_SpriteBatch_isInstanced },
 	{ "clear", w_SpriteBatch_clear },
 	{ "flush", w_SpriteBatch_flush },
 	{ "setTexture", w_SpriteBatch_setTexture },
@@ -0,0 +1,948 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "BlockCompressor.h"
+#include "ImageFilters.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace love
+{
+namespace image
+{
+
+// 4x4 RGBA8 pixels, in row-major order.
+struct Block
+{
+	uint8 rgba[16][4];
+};
+
+static void loadBlock(const uint8 *rgba, int width, int height, int bx, int by, Block &block)
+{
+	for (int y = 0; y < 4; y++)
+	{
+		int sy = std::min(by * 4 + y, height - 1);
+		for (int x = 0; x < 4; x++)
+		{
+			int sx = std::min(bx * 4 + x, width - 1);
+			memcpy(block.rgba[y * 4 + x], rgba + ((size_t) sy * width + sx) * 4, 4);
+		}
+	}
+}
+
+static int clamp255(int v)
+{
+	return std::min(std::max(v, 0), 255);
+}
+
+static int colorDistance(const uint8 *a, const int *b, int channels)
+{
+	int d = 0;
+	for (int c = 0; c < channels; c++)
+		d += (a[c] - b[c]) * (a[c] - b[c]);
+	return d;
+}
+
+/**
+ * Fits a line through the pixels (the principal axis of their distribution),
+ * and returns the two extremes of the pixels projected onto it.
+ **/
+static void fitEndpoints(const Block &block, const bool *mask, int channels, float e0[4], float e1[4])
+{
+	float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	int count = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask && !mask[i])
+			continue;
+		for (int c = 0; c < channels; c++)
+			mean[c] += block.rgba[i][c];
+		count++;
+	}
+
+	for (int c = 0; c < channels; c++)
+		mean[c] /= std::max(count, 1);
+
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask && !mask[i])
+			continue;
+
+		float d[4];
+		for (int c = 0; c < channels; c++)
+			d[c] = block.rgba[i][c] - mean[c];
+
+		for (int a = 0; a < channels; a++)
+		{
+			for (int b = 0; b < channels; b++)
+				cov[a][b] += d[a] * d[b];
+		}
+	}
+
+	// Power iteration for the dominant eigenvector.
+	float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+	for (int iter = 0; iter < 8; iter++)
+	{
+		float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		float length = 0.0f;
+
+		for (int a = 0; a < channels; a++)
+		{
+			for (int b = 0; b < channels; b++)
+				next[a] += cov[a][b] * axis[b];
+			length = std::max(length, fabsf(next[a]));
+		}
+
+		if (length < 1e-6f)
+			break;
+
+		for (int a = 0; a < channels; a++)
+			axis[a] = next[a] / length;
+	}
+
+	float lengthsq = 0.0f;
+	for (int c = 0; c < channels; c++)
+		lengthsq += axis[c] * axis[c];
+
+	float minp = 0.0f;
+	float maxp = 0.0f;
+
+	if (lengthsq > 0.0f)
+	{
+		float inv = 1.0f / sqrtf(lengthsq);
+		for (int c = 0; c < channels; c++)
+			axis[c] *= inv;
+
+		minp = 1e30f;
+		maxp = -1e30f;
+
+		for (int i = 0; i < 16; i++)
+		{
+			if (mask && !mask[i])
+				continue;
+
+			float p = 0.0f;
+			for (int c = 0; c < channels; c++)
+				p += (block.rgba[i][c] - mean[c]) * axis[c];
+
+			minp = std::min(minp, p);
+			maxp = std::max(maxp, p);
+		}
+	}
+
+	for (int c = 0; c < channels; c++)
+	{
+		e0[c] = std::min(std::max(mean[c] + axis[c] * maxp, 0.0f), 255.0f);
+		e1[c] = std::min(std::max(mean[c] + axis[c] * minp, 0.0f), 255.0f);
+	}
+}
+
+/**
+ * Moves the endpoints to the least squares solution for the given per-pixel
+ * interpolation weights (0 = e0, 1 = e1).
+ **/
+static void refineEndpoints(const Block &block, const bool *mask, const float *weights, int channels, float e0[4], float e1[4])
+{
+	float a = 0.0f, b = 0.0f, c = 0.0f;
+	float d0[4] = {}, d1[4] = {};
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask && !mask[i])
+			continue;
+
+		float w = weights[i];
+		float iw = 1.0f - w;
+
+		a += iw * iw;
+		b += iw * w;
+		c += w * w;
+
+		for (int ch = 0; ch < channels; ch++)
+		{
+			d0[ch] += iw * block.rgba[i][ch];
+			d1[ch] += w * block.rgba[i][ch];
+		}
+	}
+
+	float det = a * c - b * b;
+	if (fabsf(det) < 1e-6f)
+		return;
+
+	for (int ch = 0; ch < channels; ch++)
+	{
+		e0[ch] = std::min(std::max((c * d0[ch] - b * d1[ch]) / det, 0.0f), 255.0f);
+		e1[ch] = std::min(std::max((a * d1[ch] - b * d0[ch]) / det, 0.0f), 255.0f);
+	}
+}
+
+// BC1 (DXT1) color blocks, also used by BC3 (DXT5).
+
+static uint16 packRGB565(const float c[3])
+{
+	int r = (int) (c[0] * 31.0f / 255.0f + 0.5f);
+	int g = (int) (c[1] * 63.0f / 255.0f + 0.5f);
+	int b = (int) (c[2] * 31.0f / 255.0f + 0.5f);
+	return (uint16) ((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16 v, int c[3])
+{
+	int r = (v >> 11) & 31;
+	int g = (v >> 5) & 63;
+	int b = v & 31;
+	c[0] = (r << 3) | (r >> 2);
+	c[1] = (g << 2) | (g >> 4);
+	c[2] = (b << 3) | (b >> 2);
+}
+
+// Builds the palette for a pair of endpoints, and picks the closest palette
+// entry for every pixel. Returns the total error.
+static int assignBC1Indices(const Block &block, const bool *transparent, uint16 c0, uint16 c1, bool threecolor, uint8 indices[16])
+{
+	int palette[4][3];
+	unpackRGB565(c0, palette[0]);
+	unpackRGB565(c1, palette[1]);
+
+	for (int c = 0; c < 3; c++)
+	{
+		if (threecolor)
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+		else
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+	}
+
+	int colors = threecolor ? 3 : 4;
+	int error = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (transparent && transparent[i])
+		{
+			indices[i] = 3;
+			continue;
+		}
+
+		int best = 0;
+		int bestdist = colorDistance(block.rgba[i], palette[0], 3);
+
+		for (int p = 1; p < colors; p++)
+		{
+			int dist = colorDistance(block.rgba[i], palette[p], 3);
+			if (dist < bestdist)
+			{
+				best = p;
+				bestdist = dist;
+			}
+		}
+
+		indices[i] = (uint8) best;
+		error += bestdist;
+	}
+
+	return error;
+}
+
+static void encodeBC1Color(const Block &block, bool punchthrough, uint8 *out)
+{
+	bool transparent[16];
+	bool opaque[16];
+	bool anytransparent = false;
+	bool anyopaque = false;
+
+	for (int i = 0; i < 16; i++)
+	{
+		transparent[i] = punchthrough && block.rgba[i][3] < 128;
+		opaque[i] = !transparent[i];
+		anytransparent = anytransparent || transparent[i];
+		anyopaque = anyopaque || opaque[i];
+	}
+
+	uint16 c0 = 0;
+	uint16 c1 = 0;
+	uint8 indices[16] = {};
+
+	if (!anyopaque)
+	{
+		// Three color mode (c0 <= c1) with every pixel transparent.
+		for (int i = 0; i < 16; i++)
+			indices[i] = 3;
+	}
+	else
+	{
+		float e0[4], e1[4];
+		fitEndpoints(block, opaque, 3, e0, e1);
+
+		int besterror = -1;
+
+		for (int iter = 0; iter < 3; iter++)
+		{
+			uint16 q0 = packRGB565(e0);
+			uint16 q1 = packRGB565(e1);
+
+			// Four color mode needs c0 > c1, three color mode c0 <= c1.
+			if (anytransparent ? q0 > q1 : q0 < q1)
+				std::swap(q0, q1);
+
+			uint8 candidate[16];
+			int error = assignBC1Indices(block, anytransparent ? transparent : nullptr, q0, q1, anytransparent || q0 == q1, candidate);
+
+			if (besterror < 0 || error < besterror)
+			{
+				besterror = error;
+				c0 = q0;
+				c1 = q1;
+				memcpy(indices, candidate, 16);
+			}
+
+			if (error == 0)
+				break;
+
+			// Weights of the palette entries between c0 (0) and c1 (1).
+			static const float fourweights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+			static const float threeweights[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+			const float *palweights = (anytransparent || q0 == q1) ? threeweights : fourweights;
+
+			float weights[16];
+			for (int i = 0; i < 16; i++)
+				weights[i] = palweights[candidate[i]];
+
+			int p0[3], p1[3];
+			unpackRGB565(q0, p0);
+			unpackRGB565(q1, p1);
+			for (int c = 0; c < 3; c++)
+			{
+				e0[c] = (float) p0[c];
+				e1[c] = (float) p1[c];
+			}
+
+			refineEndpoints(block, opaque, weights, 3, e0, e1);
+		}
+	}
+
+	out[0] = (uint8) (c0 & 0xFF);
+	out[1] = (uint8) (c0 >> 8);
+	out[2] = (uint8) (c1 & 0xFF);
+	out[3] = (uint8) (c1 >> 8);
+
+	uint32 bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint32) indices[i] << (i * 2);
+
+	out[4] = (uint8) (bits >> 0);
+	out[5] = (uint8) (bits >> 8);
+	out[6] = (uint8) (bits >> 16);
+	out[7] = (uint8) (bits >> 24);
+}
+
+// BC4 blocks, and the alpha part of BC3 (DXT5) blocks.
+
+static void encodeBC4(const uint8 values[16], uint8 *out)
+{
+	int vmin = 255;
+	int vmax = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		vmin = std::min(vmin, (int) values[i]);
+		vmax = std::max(vmax, (int) values[i]);
+	}
+
+	uint8 indices[16] = {};
+
+	if (vmax != vmin)
+	{
+		// Eight value mode (first endpoint > second endpoint).
+		int palette[8];
+		palette[0] = vmax;
+		palette[1] = vmin;
+		for (int i = 1; i <= 6; i++)
+			palette[i + 1] = ((7 - i) * vmax + i * vmin + 3) / 7;
+
+		for (int i = 0; i < 16; i++)
+		{
+			int best = 0;
+			int bestdist = 256;
+
+			for (int p = 0; p < 8; p++)
+			{
+				int dist = abs(values[i] - palette[p]);
+				if (dist < bestdist)
+				{
+					best = p;
+					bestdist = dist;
+				}
+			}
+
+			indices[i] = (uint8) best;
+		}
+	}
+
+	out[0] = (uint8) vmax;
+	out[1] = (uint8) vmin;
+
+	uint64 bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint64) indices[i] << (i * 3);
+
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (uint8) (bits >> (i * 8));
+}
+
+static void getChannel(const Block &block, int channel, uint8 values[16])
+{
+	for (int i = 0; i < 16; i++)
+		values[i] = block.rgba[i][channel];
+}
+
+// BC7 blocks. Only mode 6 (a single RGBA line with 4 bit indices) is used,
+// which handles smooth color and alpha gradients well.
+
+static const int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static void writeBits(uint8 *out, int &pos, uint32 value, int bits)
+{
+	for (int b = 0; b < bits; b++, pos++)
+	{
+		if ((value >> b) & 1)
+			out[pos >> 3] |= (uint8) (1 << (pos & 7));
+	}
+}
+
+// Endpoints are stored as 7 bits per channel plus a shared low bit.
+static void quantizeBC7Endpoint(const float e[4], int q[4], int &pbit)
+{
+	float besterror = 1e30f;
+
+	for (int p = 0; p < 2; p++)
+	{
+		int candidate[4];
+		float error = 0.0f;
+
+		for (int c = 0; c < 4; c++)
+		{
+			int v = (int) floorf((e[c] - p) / 2.0f + 0.5f);
+			candidate[c] = std::min(std::max(v, 0), 127);
+
+			float d = (float) ((candidate[c] << 1) | p) - e[c];
+			error += d * d;
+		}
+
+		if (error < besterror)
+		{
+			besterror = error;
+			pbit = p;
+			memcpy(q, candidate, sizeof(candidate));
+		}
+	}
+}
+
+static int assignBC7Indices(const Block &block, const int q0[4], int p0, const int q1[4], int p1, uint8 indices[16])
+{
+	int palette[16][4];
+
+	for (int c = 0; c < 4; c++)
+	{
+		int e0 = (q0[c] << 1) | p0;
+		int e1 = (q1[c] << 1) | p1;
+
+		for (int i = 0; i < 16; i++)
+			palette[i][c] = ((64 - bc7Weights4[i]) * e0 + bc7Weights4[i] * e1 + 32) >> 6;
+	}
+
+	int error = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int best = 0;
+		int bestdist = colorDistance(block.rgba[i], palette[0], 4);
+
+		for (int p = 1; p < 16; p++)
+		{
+			int dist = colorDistance(block.rgba[i], palette[p], 4);
+			if (dist < bestdist)
+			{
+				best = p;
+				bestdist = dist;
+			}
+		}
+
+		indices[i] = (uint8) best;
+		error += bestdist;
+	}
+
+	return error;
+}
+
+static void encodeBC7(const Block &block, uint8 *out)
+{
+	float e0[4], e1[4];
+	fitEndpoints(block, nullptr, 4, e0, e1);
+
+	int q0[4] = {}, q1[4] = {};
+	int p0 = 0, p1 = 0;
+	uint8 indices[16] = {};
+	int besterror = -1;
+
+	for (int iter = 0; iter < 3; iter++)
+	{
+		int c0[4], c1[4];
+		int cp0 = 0, cp1 = 0;
+		quantizeBC7Endpoint(e0, c0, cp0);
+		quantizeBC7Endpoint(e1, c1, cp1);
+
+		uint8 candidate[16];
+		int error = assignBC7Indices(block, c0, cp0, c1, cp1, candidate);
+
+		if (besterror < 0 || error < besterror)
+		{
+			besterror = error;
+			memcpy(q0, c0, sizeof(c0));
+			memcpy(q1, c1, sizeof(c1));
+			p0 = cp0;
+			p1 = cp1;
+			memcpy(indices, candidate, 16);
+		}
+
+		if (error == 0)
+			break;
+
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+			weights[i] = bc7Weights4[candidate[i]] / 64.0f;
+
+		refineEndpoints(block, nullptr, weights, 4, e0, e1);
+	}
+
+	// The first pixel's index has an implicit high bit of 0.
+	if (indices[0] & 8)
+	{
+		std::swap(q0, q1);
+		std::swap(p0, p1);
+		for (int i = 0; i < 16; i++)
+			indices[i] = (uint8) (15 - indices[i]);
+	}
+
+	memset(out, 0, 16);
+	int pos = 0;
+
+	writeBits(out, pos, 1 << 6, 7); // Mode 6.
+
+	for (int c = 0; c < 4; c++)
+	{
+		writeBits(out, pos, q0[c], 7);
+		writeBits(out, pos, q1[c], 7);
+	}
+
+	writeBits(out, pos, p0, 1);
+	writeBits(out, pos, p1, 1);
+
+	writeBits(out, pos, indices[0], 3);
+	for (int i = 1; i < 16; i++)
+		writeBits(out, pos, indices[i], 4);
+}
+
+// ETC1 blocks, which are also valid ETC2 RGB blocks. Each block is split into
+// two 2x4 or 4x2 halves, each with a base color and a table of brightness
+// offsets.
+
+static const int etcModifiers[8][2] =
+{
+	{ 2,   8 },
+	{ 5,  17 },
+	{ 9,  29 },
+	{ 13, 42 },
+	{ 18, 60 },
+	{ 24, 80 },
+	{ 33, 106 },
+	{ 47, 183 },
+};
+
+static void getETCSubblockPixels(int flip, int subblock, int pixels[8])
+{
+	int count = 0;
+
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			int half = flip ? y / 2 : x / 2;
+			if (half == subblock)
+				pixels[count++] = y * 4 + x;
+		}
+	}
+}
+
+static int evaluateETCSubblock(const Block &block, const int pixels[8], const int base[3], int &besttable, uint8 indices[16])
+{
+	int besterror = INT32_MAX;
+
+	for (int t = 0; t < 8; t++)
+	{
+		uint8 candidate[8];
+		int error = 0;
+
+		for (int k = 0; k < 8 && error < besterror; k++)
+		{
+			const uint8 *pixel = block.rgba[pixels[k]];
+			int bestdist = INT32_MAX;
+
+			// Index values 0-3 select +a, +b, -a, -b.
+			for (int m = 0; m < 4; m++)
+			{
+				int modifier = (m & 2) ? -etcModifiers[t][m & 1] : etcModifiers[t][m & 1];
+				int color[3];
+				for (int c = 0; c < 3; c++)
+					color[c] = clamp255(base[c] + modifier);
+
+				int dist = colorDistance(pixel, color, 3);
+				if (dist < bestdist)
+				{
+					bestdist = dist;
+					candidate[k] = (uint8) m;
+				}
+			}
+
+			error += bestdist;
+		}
+
+		if (error < besterror)
+		{
+			besterror = error;
+			besttable = t;
+			for (int k = 0; k < 8; k++)
+				indices[pixels[k]] = candidate[k];
+		}
+	}
+
+	return besterror;
+}
+
+static void writeBigEndian64(uint64 bits, uint8 *out)
+{
+	for (int i = 0; i < 8; i++)
+		out[i] = (uint8) (bits >> (56 - i * 8));
+}
+
+static void encodeETC1(const Block &block, uint8 *out)
+{
+	uint64 bestbits = 0;
+	int besterror = INT32_MAX;
+
+	for (int flip = 0; flip < 2; flip++)
+	{
+		int pixels[2][8];
+		float average[2][3] = {};
+
+		for (int s = 0; s < 2; s++)
+		{
+			getETCSubblockPixels(flip, s, pixels[s]);
+
+			for (int k = 0; k < 8; k++)
+			{
+				for (int c = 0; c < 3; c++)
+					average[s][c] += block.rgba[pixels[s][k]][c] / 8.0f;
+			}
+		}
+
+		for (int differential = 1; differential >= 0; differential--)
+		{
+			int quantized[2][3];
+			int base[2][3];
+			bool valid = true;
+
+			for (int s = 0; s < 2; s++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					if (differential)
+					{
+						quantized[s][c] = std::min(std::max((int) (average[s][c] * 31.0f / 255.0f + 0.5f), 0), 31);
+						base[s][c] = (quantized[s][c] << 3) | (quantized[s][c] >> 2);
+					}
+					else
+					{
+						quantized[s][c] = std::min(std::max((int) (average[s][c] * 15.0f / 255.0f + 0.5f), 0), 15);
+						base[s][c] = quantized[s][c] * 17;
+					}
+				}
+			}
+
+			if (differential)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					int delta = quantized[1][c] - quantized[0][c];
+					valid = valid && delta >= -4 && delta <= 3;
+				}
+			}
+
+			if (!valid)
+				continue;
+
+			uint8 indices[16] = {};
+			int tables[2] = {0, 0};
+			int error = evaluateETCSubblock(block, pixels[0], base[0], tables[0], indices);
+			if (error >= besterror)
+				continue;
+
+			error += evaluateETCSubblock(block, pixels[1], base[1], tables[1], indices);
+			if (error >= besterror)
+				continue;
+
+			uint64 bits = 0;
+
+			for (int c = 0; c < 3; c++)
+			{
+				int shift = 59 - c * 8;
+				if (differential)
+				{
+					int delta = quantized[1][c] - quantized[0][c];
+					bits |= (uint64) quantized[0][c] << shift;
+					bits |= (uint64) (delta & 7) << (shift - 3);
+				}
+				else
+				{
+					bits |= (uint64) quantized[0][c] << (shift + 1);
+					bits |= (uint64) quantized[1][c] << (shift - 3);
+				}
+			}
+
+			bits |= (uint64) tables[0] << 37;
+			bits |= (uint64) tables[1] << 34;
+			bits |= (uint64) differential << 33;
+			bits |= (uint64) flip << 32;
+
+			// Pixel indices are stored column by column, as separate high
+			// and low bit planes.
+			for (int y = 0; y < 4; y++)
+			{
+				for (int x = 0; x < 4; x++)
+				{
+					int index = indices[y * 4 + x];
+					int j = x * 4 + y;
+					bits |= (uint64) (index >> 1) << (j + 16);
+					bits |= (uint64) (index & 1) << j;
+				}
+			}
+
+			besterror = error;
+			bestbits = bits;
+		}
+	}
+
+	writeBigEndian64(bestbits, out);
+}
+
+// EAC alpha blocks, used by ETC2 RGBA.
+
+static const int eacModifiers[16][8] =
+{
+	{ -3, -6,  -9, -15, 2, 5, 8, 14 },
+	{ -3, -7, -10, -13, 2, 6, 9, 12 },
+	{ -2, -5,  -8, -13, 1, 4, 7, 12 },
+	{ -2, -4,  -6, -13, 1, 3, 5, 12 },
+	{ -3, -6,  -8, -12, 2, 5, 7, 11 },
+	{ -3, -7,  -9, -11, 2, 6, 8, 10 },
+	{ -4, -7,  -8, -11, 3, 6, 7, 10 },
+	{ -3, -5,  -8, -11, 2, 4, 7, 10 },
+	{ -2, -6,  -8, -10, 1, 5, 7,  9 },
+	{ -2, -5,  -8, -10, 1, 4, 7,  9 },
+	{ -2, -4,  -8, -10, 1, 3, 7,  9 },
+	{ -2, -5,  -7, -10, 1, 4, 6,  9 },
+	{ -3, -4,  -7, -10, 2, 3, 6,  9 },
+	{ -1, -2,  -3, -10, 0, 1, 2,  9 },
+	{ -4, -6,  -8,  -9, 3, 5, 7,  8 },
+	{ -3, -5,  -7,  -9, 2, 4, 6,  8 },
+};
+
+static void encodeEACAlpha(const uint8 values[16], uint8 *out)
+{
+	int vmin = 255;
+	int vmax = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		vmin = std::min(vmin, (int) values[i]);
+		vmax = std::max(vmax, (int) values[i]);
+	}
+
+	int besterror = INT32_MAX;
+	int bestbase = 0, bestmultiplier = 1, besttable = 0;
+	uint8 bestindices[16] = {};
+
+	for (int t = 0; t < 16 && besterror > 0; t++)
+	{
+		int tmin = *std::min_element(eacModifiers[t], eacModifiers[t] + 8);
+		int tmax = *std::max_element(eacModifiers[t], eacModifiers[t] + 8);
+
+		// Pick the multiplier which stretches the table over the value range.
+		int multiplier = (int) ((vmax - vmin) / (float) (tmax - tmin) + 0.5f);
+
+		for (int m = multiplier - 1; m <= multiplier + 1; m++)
+		{
+			if (m < 1 || m > 15)
+				continue;
+
+			int base = clamp255((int) floorf((vmin + vmax) / 2.0f - (tmin + tmax) * m / 2.0f + 0.5f));
+
+			uint8 indices[16];
+			int error = 0;
+
+			for (int i = 0; i < 16 && error < besterror; i++)
+			{
+				int bestdist = INT32_MAX;
+				for (int k = 0; k < 8; k++)
+				{
+					int d = clamp255(base + eacModifiers[t][k] * m) - values[i];
+					if (d * d < bestdist)
+					{
+						bestdist = d * d;
+						indices[i] = (uint8) k;
+					}
+				}
+				error += bestdist;
+			}
+
+			if (error < besterror)
+			{
+				besterror = error;
+				bestbase = base;
+				bestmultiplier = m;
+				besttable = t;
+				memcpy(bestindices, indices, 16);
+			}
+		}
+	}
+
+	uint64 bits = (uint64) bestbase << 56;
+	bits |= (uint64) bestmultiplier << 52;
+	bits |= (uint64) besttable << 48;
+
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			int j = x * 4 + y;
+			bits |= (uint64) bestindices[y * 4 + x] << (45 - j * 3);
+		}
+	}
+
+	writeBigEndian64(bits, out);
+}
+
+static void compressBlock(const Block &block, PixelFormat format, uint8 *out)
+{
+	uint8 values[16];
+
+	switch (getLinearPixelFormat(format))
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+		encodeBC1Color(block, true, out);
+		break;
+	case PIXELFORMAT_DXT5_UNORM:
+		getChannel(block, 3, values);
+		encodeBC4(values, out);
+		encodeBC1Color(block, false, out + 8);
+		break;
+	case PIXELFORMAT_BC4_UNORM:
+		getChannel(block, 0, values);
+		encodeBC4(values, out);
+		break;
+	case PIXELFORMAT_BC5_UNORM:
+		getChannel(block, 0, values);
+		encodeBC4(values, out);
+		getChannel(block, 1, values);
+		encodeBC4(values, out + 8);
+		break;
+	case PIXELFORMAT_BC7_UNORM:
+		encodeBC7(block, out);
+		break;
+	case PIXELFORMAT_ETC1_UNORM:
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+		encodeETC1(block, out);
+		break;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		getChannel(block, 3, values);
+		encodeEACAlpha(values, out);
+		encodeETC1(block, out + 8);
+		break;
+	default:
+		break;
+	}
+}
+
+bool isBlockCompressionSupported(PixelFormat format)
+{
+	switch (getLinearPixelFormat(format))
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT5_UNORM:
+	case PIXELFORMAT_BC4_UNORM:
+	case PIXELFORMAT_BC5_UNORM:
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_ETC1_UNORM:
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void compressBlocks(const uint8 *rgba, int width, int height, PixelFormat format, uint8 *dst)
+{
+	if (!isBlockCompressionSupported(format))
+		throw love::Exception("Compressing to the %s pixel format is not supported.", getPixelFormatName(format));
+
+	int blocksx = (width + 3) / 4;
+	int blocksy = (height + 3) / 4;
+	size_t blocksize = getPixelFormatBlockSize(format);
+
+	// Encoding a block costs far more than touching its pixels, so count each
+	// block as a lot of work when deciding whether to split rows up.
+	parallelForRows(blocksy, (size_t) blocksx * 1024, [&](size_t begin, size_t end)
+	{
+		Block block;
+		for (size_t by = begin; by < end; by++)
+		{
+			for (int bx = 0; bx < blocksx; bx++)
+			{
+				loadBlock(rgba, width, height, bx, (int) by, block);
+				compressBlock(block, format, dst + ((size_t) by * blocksx + bx) * blocksize);
+			}
+		}
+	});
+}
+
+} // image
+} // love
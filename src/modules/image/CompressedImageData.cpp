@@ -19,8 +19,13 @@
  **/
 
 #include "CompressedImageData.h"
+#include "ImageData.h"
+#include "BlockCompressor.h"
 #include "common/Exception.h"
 
+// C++
+#include <algorithm>
+
 namespace love
 {
 namespace image
@@ -61,6 +66,53 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler *> &forma
 	format = getLinearPixelFormat(format);
 }
 
+CompressedImageData::CompressedImageData(ImageData *source, PixelFormat format, bool mipmaps)
+	: format(getLinearPixelFormat(format))
+{
+	if (!isBlockCompressionSupported(format))
+		throw love::Exception("Compressing ImageData to the %s pixel format is not supported.", getPixelFormatName(format));
+
+	bool linear = source->isLinear();
+
+	std::vector<StrongRef<ImageData>> levels;
+	levels.emplace_back(source->convert(PIXELFORMAT_RGBA8_UNORM, linear), Acquire::NORETAIN);
+
+	if (mipmaps)
+	{
+		while (levels.back()->getWidth() > 1 || levels.back()->getHeight() > 1)
+		{
+			const ImageData *prev = levels.back().get();
+			int w = std::max(prev->getWidth() / 2, 1);
+			int h = std::max(prev->getHeight() / 2, 1);
+			levels.emplace_back(prev->resize(w, h, RESIZE_FILTER_BOX), Acquire::NORETAIN);
+		}
+	}
+
+	size_t totalsize = 0;
+	for (const auto &level : levels)
+		totalsize += getPixelFormatSliceSize(this->format, level->getWidth(), level->getHeight());
+
+	memory.set(new ByteData(totalsize, false), Acquire::NORETAIN);
+
+	size_t offset = 0;
+	for (const auto &level : levels)
+	{
+		int w = level->getWidth();
+		int h = level->getHeight();
+		size_t size = getPixelFormatSliceSize(this->format, w, h);
+
+		compressBlocks((const uint8 *) level->getData(), w, h, this->format, (uint8 *) memory->getData() + offset);
+
+		auto slice = new CompressedSlice(this->format, w, h, memory, offset, size);
+		dataImages.push_back(slice);
+		slice->release();
+
+		offset += size;
+	}
+
+	setLinear(linear);
+}
+
 CompressedImageData::CompressedImageData(const CompressedImageData &c)
 	: format(c.format)
 {
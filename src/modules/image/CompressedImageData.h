@@ -37,6 +37,8 @@ namespace love
 namespace image
 {
 
+class ImageData;
+
 /**
  * CompressedImageData represents image data which is designed to be uploaded to
  * the GPU and rendered in its compressed form, without being decompressed.
@@ -49,6 +51,15 @@ class CompressedImageData : public Data
 	static love::Type type;
 
 	CompressedImageData(const std::list<FormatHandler *> &formats, Data *filedata);
+
+	/**
+	 * Compresses the contents of an ImageData on the CPU. Blocks are encoded
+	 * in parallel on the shared thread pool.
+	 * @param source The ImageData to compress.
+	 * @param format The compressed pixel format to encode to.
+	 * @param mipmaps Whether to generate and compress a full mipmap chain.
+	 **/
+	CompressedImageData(ImageData *source, PixelFormat format, bool mipmaps);
 	CompressedImageData(const CompressedImageData &c);
 	virtual ~CompressedImageData();
 
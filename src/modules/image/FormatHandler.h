@@ -50,6 +50,27 @@ class FormatHandler : public love::Object
 		ENCODED_MAX_ENUM
 	};
 
+	// Row filters for encoders which predict pixels from their neighbours.
+	enum RowFilter
+	{
+		ROW_FILTER_NONE,
+		ROW_FILTER_SUB,
+		ROW_FILTER_UP,
+		ROW_FILTER_AVERAGE,
+		ROW_FILTER_PAETH,
+		ROW_FILTER_MINSUM,
+		ROW_FILTER_ENTROPY,
+		ROW_FILTER_MAX_ENUM
+	};
+
+	// Optional encoder parameters. Encoders ignore the ones they don't use.
+	struct EncodeSettings
+	{
+		// zlib-style compression level from 0 to 9, or -1 for the default.
+		int compressionLevel = -1;
+		RowFilter rowFilter = ROW_FILTER_MINSUM;
+	};
+
 	// Raw RGBA pixel data.
 	struct DecodedImage
 	{
@@ -91,7 +112,7 @@ class FormatHandler : public love::Object
 	/**
 	 * Encodes an image from raw pixel data into a particular format.
 	 **/
-	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format);
+	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format, const EncodeSettings &settings);
 
 	/**
 	 * Whether this format handler can parse the given Data into a
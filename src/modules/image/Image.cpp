@@ -21,6 +21,8 @@
 // LOVE
 #include "Image.h"
 #include "common/config.h"
+#include "filesystem/Filesystem.h"
+#include "libraries/xxHash/xxhash.h"
 
 #include "magpie/PNGHandler.h"
 #include "magpie/STBHandler.h"
@@ -90,6 +92,93 @@ love::image::CompressedImageData *Image::newCompressedData(Data *data)
 	return new CompressedImageData(formatHandlers, data);
 }
 
+love::image::CompressedImageData *Image::newCompressedData(ImageData *data, PixelFormat format, bool mipmaps, const char *cachedir)
+{
+	// Bump this whenever the encoders' output changes, so stale cache entries
+	// are ignored.
+	const uint32 encoderVersion = 1;
+
+	auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+
+	if (cachedir == nullptr || fs == nullptr)
+		return new CompressedImageData(data, format, mipmaps);
+
+	uint32 params[] = {
+		encoderVersion,
+		(uint32) data->getWidth(),
+		(uint32) data->getHeight(),
+		(uint32) data->getFormat(),
+		(uint32) getLinearPixelFormat(format),
+		(uint32) mipmaps,
+		(uint32) data->isLinear(),
+	};
+
+	uint64 seed = XXH64(params, sizeof(params), 0);
+	uint64 hash = XXH64(data->getData(), data->getSize(), seed);
+
+	char filename[32];
+	snprintf(filename, sizeof(filename), "%016llx.ktx", (unsigned long long) hash);
+	std::string path = std::string(cachedir) + "/" + filename;
+
+	// The cache is only written to the save directory, so a file with the same
+	// name in the game's source or another mounted archive isn't an entry.
+	bool cached = false;
+	if (fs->exists(path.c_str()))
+	{
+		try
+		{
+			cached = fs->getRealDirectory(path.c_str()) == fs->canonicalizeRealPath(fs->getSaveDirectory());
+		}
+		catch (love::Exception &)
+		{
+		}
+	}
+
+	// A cache entry that fails to load is treated as a miss and overwritten.
+	if (cached)
+	{
+		try
+		{
+			StrongRef<filesystem::FileData> filedata(fs->read(path.c_str()), Acquire::NORETAIN);
+			StrongRef<CompressedImageData> cached(new CompressedImageData(formatHandlers, filedata), Acquire::NORETAIN);
+
+			if (cached->getFormat() == getLinearPixelFormat(format))
+			{
+				cached->setLinear(data->isLinear());
+				cached->retain();
+				return cached.get();
+			}
+		}
+		catch (love::Exception &)
+		{
+		}
+	}
+
+	StrongRef<CompressedImageData> compressed(new CompressedImageData(data, format, mipmaps), Acquire::NORETAIN);
+
+	// Failing to write the cache shouldn't prevent the compressed data from
+	// being used.
+	try
+	{
+		std::vector<StrongRef<CompressedSlice>> slices;
+		for (int i = 0; i < compressed->getMipmapCount(); i++)
+			slices.emplace_back(compressed->getSlice(0, i));
+
+		StrongRef<ByteData> filedata(magpie::KTXHandler::encodeCompressed(compressed->getFormat(), slices), Acquire::NORETAIN);
+
+		if (!fs->exists(cachedir))
+			fs->createDirectory(cachedir);
+
+		fs->write(path.c_str(), filedata->getData(), filedata->getSize());
+	}
+	catch (love::Exception &)
+	{
+	}
+
+	compressed->retain();
+	return compressed.get();
+}
+
 bool Image::isCompressed(Data *data)
 {
 	for (FormatHandler *handler : formatHandlers)
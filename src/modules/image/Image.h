@@ -85,6 +85,18 @@ class Image : public Module
 	 **/
 	CompressedImageData *newCompressedData(Data *data);
 
+	/**
+	 * Compresses ImageData into a GPU-compressed pixel format on the CPU.
+	 * @param data The ImageData to compress.
+	 * @param format The compressed pixel format to use.
+	 * @param mipmaps Whether to generate mipmaps before compressing.
+	 * @param cachedir A directory in the save directory where compressed
+	 *        results are stored as KTX files keyed by a hash of their source
+	 *        pixels, or null to disable caching.
+	 * @return The new CompressedImageData.
+	 **/
+	CompressedImageData *newCompressedData(ImageData *data, PixelFormat format, bool mipmaps, const char *cachedir = nullptr);
+
 	/**
 	 * Determines whether a FileData is Compressed image data or not.
 	 * @param data The FileData to test.
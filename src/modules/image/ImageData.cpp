@@ -20,6 +20,7 @@
 
 #include "ImageData.h"
 #include "Image.h"
+#include "PixelConversion.h"
 #include "filesystem/Filesystem.h"
 
 #include <algorithm> // min/max
@@ -167,7 +168,7 @@ void ImageData::decode(Data *data)
 	pixelGetFunction = getPixelGetFunction(format);
 }
 
-love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile) const
+love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings) const
 {
 	FormatHandler *encoder = nullptr;
 	FormatHandler::EncodedImage encodedimage;
@@ -194,7 +195,7 @@ love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encod
 	}
 
 	if (encoder != nullptr)
-		encodedimage = encoder->encode(rawimage, encodedFormat);
+		encodedimage = encoder->encode(rawimage, encodedFormat, settings);
 
 	if (encoder == nullptr || encodedimage.data == nullptr)
 		throw love::Exception("No suitable image encoder for the %s pixel format.", getPixelFormatName(format));
@@ -269,6 +270,12 @@ static void setPixelRG8(const Colorf &c, ImageData::Pixel *p)
 	p->rgba8[1] = (uint8) (clamp01(c.g) * 255.0f + 0.5f);
 }
 
+static void setPixelLA8(const Colorf &c, ImageData::Pixel *p)
+{
+	p->rgba8[0] = (uint8) (clamp01(c.r) * 255.0f + 0.5f);
+	p->rgba8[1] = (uint8) (clamp01(c.a) * 255.0f + 0.5f);
+}
+
 static void setPixelRGBA8(const Colorf &c, ImageData::Pixel *p)
 {
 	p->rgba8[0] = (uint8) (clamp01(c.r) * 255.0f + 0.5f);
@@ -291,8 +298,8 @@ static void setPixelRG16(const Colorf &c, ImageData::Pixel *p)
 static void setPixelRGBA16(const Colorf &c, ImageData::Pixel *p)
 {
 	p->rgba16[0] = (uint16) (clamp01(c.r) * 65535.0f + 0.5f);
-	p->rgba16[1] = (uint16) (clamp01(c.b) * 65535.0f + 0.5f);
-	p->rgba16[2] = (uint16) (clamp01(c.g) * 65535.0f + 0.5f);
+	p->rgba16[1] = (uint16) (clamp01(c.g) * 65535.0f + 0.5f);
+	p->rgba16[2] = (uint16) (clamp01(c.b) * 65535.0f + 0.5f);
 	p->rgba16[3] = (uint16) (clamp01(c.a) * 65535.0f + 0.5f);
 }
 
@@ -398,6 +405,12 @@ static void getPixelRG8(const ImageData::Pixel *p, Colorf &c)
 	c.a = 1.0f;
 }
 
+static void getPixelLA8(const ImageData::Pixel *p, Colorf &c)
+{
+	c.r = c.g = c.b = p->rgba8[0] / 255.0f;
+	c.a = p->rgba8[1] / 255.0f;
+}
+
 static void getPixelRGBA8(const ImageData::Pixel *p, Colorf &c)
 {
 	c.r = p->rgba8[0] / 255.0f;
@@ -558,86 +571,6 @@ Colorf ImageData::getPixel(int x, int y) const
 	return c;
 }
 
-union Row
-{
-	uint8 *u8;
-	uint16 *u16;
-	float16 *f16;
-	float *f32;
-};
-
-static void pasteRGBA8toRGBA16(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u16[i] = (uint16) src.u8[i] << 8u;
-}
-
-static void pasteRGBA8toRGBA16F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f16[i] = float32to16(src.u8[i] / 255.0f);
-}
-
-static void pasteRGBA8toRGBA32F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f32[i] = src.u8[i] / 255.0f;
-}
-
-static void pasteRGBA16toRGBA8(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u8[i] = src.u16[i] >> 8u;
-}
-
-static void pasteRGBA16toRGBA16F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f16[i] = float32to16(src.u16[i] / 65535.0f);
-}
-
-static void pasteRGBA16toRGBA32F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f32[i] = src.u16[i] / 65535.0f;
-}
-
-static void pasteRGBA16FtoRGBA8(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u8[i] = (uint8) (clamp01(float16to32(src.f16[i])) * 255.0f + 0.5f);
-}
-
-static void pasteRGBA16FtoRGBA16(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u16[i] = (uint16) (clamp01(float16to32(src.f16[i])) * 65535.0f + 0.5f);
-}
-
-static void pasteRGBA16FtoRGBA32F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f32[i] = float16to32(src.f16[i]);
-}
-
-static void pasteRGBA32FtoRGBA8(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u8[i] = (uint8) (clamp01(src.f32[i]) * 255.0f + 0.5f);
-}
-
-static void pasteRGBA32FtoRGBA16(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.u16[i] = (uint16) (clamp01(src.f32[i]) * 65535.0f + 0.5f);
-}
-
-static void pasteRGBA32FtoRGBA16F(Row src, Row dst, int w)
-{
-	for (int i = 0; i < w * 4; i++)
-		dst.f16[i] = float32to16(src.f32[i]);
-}
-
 void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh)
 {
 	PixelFormat dstformat = getFormat();
@@ -697,73 +630,261 @@ void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, in
 	uint8 *s = (uint8 *) src->getData();
 	uint8 *d = (uint8 *) getData();
 
-	auto getfunction = src->pixelGetFunction;
-	auto setfunction = pixelSetFunction;
-
 	// If the dimensions match up, copy the entire memory stream in one go
 	if (srcformat == dstformat && (sw == dstW && dstW == srcW && sh == dstH && dstH == srcH))
 	{
 		memcpy(d, s, srcpixelsize * sw * sh);
 	}
-	else if (sw > 0)
+	else if (sw > 0 && sh > 0 && srcformat == dstformat)
 	{
 		// Otherwise, copy each row individually.
 		for (int i = 0; i < sh; i++)
 		{
-			Row rowsrc = {s + (sx + (i + sy) * srcW) * srcpixelsize};
-			Row rowdst = {d + (dx + (i + dy) * dstW) * dstpixelsize};
-
-			if (srcformat == dstformat)
-				memcpy(rowdst.u8, rowsrc.u8, srcpixelsize * sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA8toRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA8toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA8_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA8toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA16toRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA16toRGBA16F(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_UNORM && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA16toRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA16FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA16FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA16_FLOAT && dstformat == PIXELFORMAT_RGBA32_FLOAT)
-				pasteRGBA16FtoRGBA32F(rowsrc, rowdst, sw);
-
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA8_UNORM)
-				pasteRGBA32FtoRGBA8(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_UNORM)
-				pasteRGBA32FtoRGBA16(rowsrc, rowdst, sw);
-			else if (srcformat == PIXELFORMAT_RGBA32_FLOAT && dstformat == PIXELFORMAT_RGBA16_FLOAT)
-				pasteRGBA32FtoRGBA16F(rowsrc, rowdst, sw);
-
-			else if (getfunction != nullptr && setfunction != nullptr)
+			const uint8 *rowsrc = s + (sx + (i + sy) * srcW) * srcpixelsize;
+			uint8 *rowdst = d + (dx + (i + dy) * dstW) * dstpixelsize;
+			memcpy(rowdst, rowsrc, srcpixelsize * sw);
+		}
+	}
+	else if (sw > 0 && sh > 0)
+	{
+		if (!isPixelConversionSupported(srcformat, dstformat))
+		{
+			if (getPixelGetFunction(srcformat) == nullptr)
+				throw love::Exception("ImageData:paste does not currently support converting from the %s pixel format.", getPixelFormatName(srcformat));
+			else
+				throw love::Exception("ImageData:paste does not currently support converting to the %s pixel format.", getPixelFormatName(dstformat));
+		}
+
+		// Otherwise, convert each row individually.
+		const uint8 *rowsrc = s + (sx + sy * srcW) * srcpixelsize;
+		uint8 *rowdst = d + (dx + dy * dstW) * dstpixelsize;
+
+		convertPixels(rowsrc, srcW * srcpixelsize, srcformat, false,
+		              rowdst, dstW * dstpixelsize, dstformat, false, sw, sh);
+	}
+}
+
+ImageData *ImageData::convert(PixelFormat format, bool linear) const
+{
+	if (!validPixelFormat(format))
+		throw love::Exception("ImageData does not support the %s pixel format.", getPixelFormatName(format));
+
+	if (!isPixelConversionSupported(this->format, format))
+		throw love::Exception("Converting ImageData from the %s pixel format to %s is not supported.", getPixelFormatName(this->format), getPixelFormatName(format));
+
+	StrongRef<ImageData> dst(new ImageData(width, height, format), Acquire::NORETAIN);
+	dst->setLinear(linear);
+
+	convertPixels(getData(), getPixelSize() * width, this->format, isLinear(),
+	              dst->getData(), dst->getPixelSize() * width, format, linear, width, height);
+
+	dst->retain();
+	return dst.get();
+}
+
+void ImageData::checkFilterable(const char *name) const
+{
+	if (!isPixelConversionSupported(format, PIXELFORMAT_RGBA32_FLOAT) || !isPixelConversionSupported(PIXELFORMAT_RGBA32_FLOAT, format))
+		throw love::Exception("ImageData:%s does not support the %s pixel format.", name, getPixelFormatName(format));
+}
+
+ImageData *ImageData::resize(int dstwidth, int dstheight, ResizeFilter filter) const
+{
+	if (dstwidth <= 0 || dstheight <= 0)
+		throw love::Exception("Invalid ImageData dimensions.");
+
+	if (filter != RESIZE_FILTER_NEAREST)
+		checkFilterable("resize");
+
+	StrongRef<ImageData> dst(new ImageData(dstwidth, dstheight, format), Acquire::NORETAIN);
+	dst->setLinear(isLinear());
+
+	size_t pixelsize = getPixelSize();
+
+	if (filter == RESIZE_FILTER_NEAREST)
+	{
+		// Nearest neighbour sampling copies whole pixels, so any format works.
+		std::vector<int> srcx(dstwidth);
+		for (int x = 0; x < dstwidth; x++)
+			srcx[x] = std::min((int) ((x + 0.5) * width / dstwidth), width - 1);
+
+		parallelForRows(dstheight, dstwidth * pixelsize, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				int sy = std::min((int) ((y + 0.5) * height / dstheight), height - 1);
+				const uint8 *srcrow = data + (size_t) sy * width * pixelsize;
+				uint8 *dstrow = dst->data + y * dstwidth * pixelsize;
+
+				for (int x = 0; x < dstwidth; x++)
+					memcpy(dstrow + x * pixelsize, srcrow + srcx[x] * pixelsize, pixelsize);
+			}
+		});
+	}
+	else
+	{
+		std::vector<float> src((size_t) width * height * 4);
+		std::vector<float> resized((size_t) dstwidth * dstheight * 4);
+
+		convertPixels(data, width * pixelsize, format, isLinear(),
+		              src.data(), width * sizeof(float) * 4, PIXELFORMAT_RGBA32_FLOAT, true,
+		              width, height);
+
+		premultiplyRGBA32F(src.data(), (size_t) width * height);
+		resizeRGBA32F(src.data(), width, height, resized.data(), dstwidth, dstheight, filter);
+		unpremultiplyRGBA32F(resized.data(), (size_t) dstwidth * dstheight);
+
+		convertPixels(resized.data(), dstwidth * sizeof(float) * 4, PIXELFORMAT_RGBA32_FLOAT, true,
+		              dst->data, dstwidth * pixelsize, format, isLinear(), dstwidth, dstheight);
+	}
+
+	dst->retain();
+	return dst.get();
+}
+
+void ImageData::premultiplyAlpha()
+{
+	bool hasalpha = format == PIXELFORMAT_LA8_UNORM || getPixelFormatColorComponents(format) == 4;
+	if (!hasalpha)
+		return;
+
+	size_t pixelsize = getPixelSize();
+	size_t rowsize = width * pixelsize;
+
+	if (format == PIXELFORMAT_RGBA8_UNORM || format == PIXELFORMAT_LA8_UNORM)
+	{
+		int colorcomponents = (int) pixelsize - 1;
+
+		parallelForRows(height, rowsize, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
 			{
-				// Slow path: convert src -> Colorf -> dst.
-				Colorf c;
-				for (int x = 0; x < sw; x++)
+				uint8 *p = data + y * rowsize;
+				for (int x = 0; x < width; x++, p += pixelsize)
 				{
-					auto srcp = (const Pixel *) (rowsrc.u8 + x * srcpixelsize);
-					auto dstp = (Pixel *) (rowdst.u8 + x * dstpixelsize);
-					getfunction(srcp, c);
-					setfunction(c, dstp);
+					uint32 a = p[colorcomponents];
+					for (int c = 0; c < colorcomponents; c++)
+					{
+						// Rounded c * a / 255.
+						uint32 t = p[c] * a + 128;
+						p[c] = (uint8) ((t + (t >> 8)) >> 8);
+					}
 				}
 			}
-			else if (getfunction == nullptr)
-				throw love::Exception("ImageData:paste does not currently support converting from the %s pixel format.", getPixelFormatName(srcformat));
-			else
-				throw love::Exception("ImageData:paste does not currently support converting to the %s pixel format.", getPixelFormatName(dstformat));
+		});
+
+		return;
+	}
+
+	checkFilterable("premultiplyAlpha");
+
+	parallelForRows(height, rowsize, [&](size_t begin, size_t end)
+	{
+		std::vector<float> row((size_t) width * 4);
+		for (size_t y = begin; y < end; y++)
+		{
+			uint8 *p = data + y * rowsize;
+			convertPixels(p, rowsize, format, false, row.data(), 0, PIXELFORMAT_RGBA32_FLOAT, false, width, 1);
+			premultiplyRGBA32F(row.data(), width);
+			convertPixels(row.data(), 0, PIXELFORMAT_RGBA32_FLOAT, false, p, rowsize, format, false, width, 1);
 		}
+	});
+}
+
+void ImageData::gaussianBlur(float radius)
+{
+	if (radius <= 0.0f)
+		return;
+
+	checkFilterable("gaussianBlur");
+
+	size_t rowsize = width * getPixelSize();
+	std::vector<float> pixels((size_t) width * height * 4);
+
+	convertPixels(data, rowsize, format, isLinear(),
+	              pixels.data(), width * sizeof(float) * 4, PIXELFORMAT_RGBA32_FLOAT, true,
+	              width, height);
+
+	premultiplyRGBA32F(pixels.data(), (size_t) width * height);
+	gaussianBlurRGBA32F(pixels.data(), width, height, radius);
+	unpremultiplyRGBA32F(pixels.data(), (size_t) width * height);
+
+	convertPixels(pixels.data(), width * sizeof(float) * 4, PIXELFORMAT_RGBA32_FLOAT, true,
+	              data, rowsize, format, isLinear(), width, height);
+}
+
+void ImageData::flip(bool horizontal, bool vertical)
+{
+	size_t pixelsize = getPixelSize();
+	size_t rowsize = width * pixelsize;
+
+	if (vertical)
+	{
+		parallelForRows(height / 2, rowsize, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				uint8 *a = data + y * rowsize;
+				uint8 *b = data + (height - 1 - y) * rowsize;
+				std::swap_ranges(a, a + rowsize, b);
+			}
+		});
+	}
+
+	if (horizontal)
+	{
+		parallelForRows(height, rowsize, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; y++)
+			{
+				uint8 *row = data + y * rowsize;
+				for (int x = 0; x < width / 2; x++)
+				{
+					uint8 *a = row + x * pixelsize;
+					uint8 *b = row + (width - 1 - x) * pixelsize;
+					std::swap_ranges(a, a + pixelsize, b);
+				}
+			}
+		});
 	}
 }
 
+ImageData *ImageData::rotate90(bool clockwise) const
+{
+	StrongRef<ImageData> dst(new ImageData(height, width, format), Acquire::NORETAIN);
+	dst->setLinear(isLinear());
+
+	size_t pixelsize = getPixelSize();
+	int dstwidth = height;
+
+	// Copy in square tiles, so neither image is walked across a whole column.
+	const int TILE_SIZE = 32;
+	int tilerows = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	parallelForRows(tilerows, TILE_SIZE * width * pixelsize, [&](size_t begin, size_t end)
+	{
+		for (int ty = (int) begin * TILE_SIZE; ty < std::min((int) end * TILE_SIZE, height); ty += TILE_SIZE)
+		{
+			for (int tx = 0; tx < width; tx += TILE_SIZE)
+			{
+				for (int y = ty; y < std::min(ty + TILE_SIZE, height); y++)
+				{
+					const uint8 *srcrow = data + (size_t) y * width * pixelsize;
+					for (int x = tx; x < std::min(tx + TILE_SIZE, width); x++)
+					{
+						int dx = clockwise ? height - 1 - y : y;
+						int dy = clockwise ? x : width - 1 - x;
+						memcpy(dst->data + ((size_t) dy * dstwidth + dx) * pixelsize, srcrow + x * pixelsize, pixelsize);
+					}
+				}
+			}
+		}
+	});
+
+	dst->retain();
+	return dst.get();
+}
+
 size_t ImageData::getPixelSize() const
 {
 	return getPixelFormatBlockSize(format);
@@ -780,6 +901,7 @@ ImageData::PixelSetFunction ImageData::getPixelSetFunction(PixelFormat format)
 	{
 		case PIXELFORMAT_R8_UNORM: return setPixelR8;
 		case PIXELFORMAT_RG8_UNORM: return setPixelRG8;
+		case PIXELFORMAT_LA8_UNORM: return setPixelLA8;
 		case PIXELFORMAT_RGBA8_UNORM: return setPixelRGBA8;
 		case PIXELFORMAT_R16_UNORM: return setPixelR16;
 		case PIXELFORMAT_RG16_UNORM: return setPixelRG16;
@@ -805,6 +927,7 @@ ImageData::PixelGetFunction ImageData::getPixelGetFunction(PixelFormat format)
 	{
 		case PIXELFORMAT_R8_UNORM: return getPixelR8;
 		case PIXELFORMAT_RG8_UNORM: return getPixelRG8;
+		case PIXELFORMAT_LA8_UNORM: return getPixelLA8;
 		case PIXELFORMAT_RGBA8_UNORM: return getPixelRGBA8;
 		case PIXELFORMAT_R16_UNORM: return getPixelR16;
 		case PIXELFORMAT_RG16_UNORM: return getPixelRG16;
@@ -849,5 +972,26 @@ StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry
 
 StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> ImageData::encodedFormats(ImageData::encodedFormatEntries, sizeof(ImageData::encodedFormatEntries));
 
+STRINGMAP_CLASS_BEGIN(ImageData, FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM, rowFilter)
+{
+	{ "none",    FormatHandler::ROW_FILTER_NONE    },
+	{ "sub",     FormatHandler::ROW_FILTER_SUB     },
+	{ "up",      FormatHandler::ROW_FILTER_UP      },
+	{ "average", FormatHandler::ROW_FILTER_AVERAGE },
+	{ "paeth",   FormatHandler::ROW_FILTER_PAETH   },
+	{ "minsum",  FormatHandler::ROW_FILTER_MINSUM  },
+	{ "entropy", FormatHandler::ROW_FILTER_ENTROPY },
+}
+STRINGMAP_CLASS_END(ImageData, FormatHandler::RowFilter, FormatHandler::ROW_FILTER_MAX_ENUM, rowFilter)
+
+STRINGMAP_CLASS_BEGIN(ImageData, ResizeFilter, RESIZE_FILTER_MAX_ENUM, resizeFilter)
+{
+	{ "nearest", RESIZE_FILTER_NEAREST },
+	{ "box",     RESIZE_FILTER_BOX     },
+	{ "linear",  RESIZE_FILTER_LINEAR  },
+	{ "lanczos", RESIZE_FILTER_LANCZOS },
+}
+STRINGMAP_CLASS_END(ImageData, ResizeFilter, RESIZE_FILTER_MAX_ENUM, resizeFilter)
+
 } // image
 } // love
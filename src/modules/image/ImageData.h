@@ -30,6 +30,7 @@
 #include "filesystem/FileData.h"
 #include "thread/threads.h"
 #include "ImageDataBase.h"
+#include "ImageFilters.h"
 #include "FormatHandler.h"
 
 using love::thread::Mutex;
@@ -79,6 +80,45 @@ class ImageData : public ImageDataBase
 	 **/
 	void paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, int sh);
 
+	/**
+	 * Creates a copy of this ImageData with its pixels converted to a different
+	 * format. Color values are converted between sRGB and linear encodings if
+	 * the linear flag differs from this ImageData's.
+	 * @param format The pixel format of the new ImageData.
+	 * @param linear Whether the new ImageData's contents are linear (not sRGB).
+	 **/
+	ImageData *convert(PixelFormat format, bool linear) const;
+
+	/**
+	 * Creates a resampled copy of this ImageData. Filtering happens on linear
+	 * premultiplied colors, so sRGB and transparent edges resize correctly.
+	 * @param width The width of the new ImageData.
+	 * @param height The height of the new ImageData.
+	 * @param filter The resampling filter to use.
+	 **/
+	ImageData *resize(int width, int height, ResizeFilter filter) const;
+
+	/**
+	 * Multiplies the color components of every pixel by its alpha.
+	 **/
+	void premultiplyAlpha();
+
+	/**
+	 * Blurs the contents of this ImageData in-place.
+	 * @param radius The standard deviation of the blur, in pixels.
+	 **/
+	void gaussianBlur(float radius);
+
+	/**
+	 * Mirrors the contents of this ImageData in-place.
+	 **/
+	void flip(bool horizontal, bool vertical);
+
+	/**
+	 * Creates a copy of this ImageData rotated by 90 degrees.
+	 **/
+	ImageData *rotate90(bool clockwise) const;
+
 	/**
 	 * Checks whether a position is inside this ImageData. Useful for checking bounds.
 	 * @param x The position along the x-axis.
@@ -107,8 +147,9 @@ class ImageData : public ImageDataBase
 	 * Encodes raw pixel data into a given format.
 	 * @param f The file to save the encoded image data to.
 	 * @param format The format of the encoded data.
+	 * @param settings Optional parameters for the encoder.
 	 **/
-	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
+	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings = FormatHandler::EncodeSettings()) const;
 
 	// Implements ImageDataBase.
 	ImageData *clone() const override;
@@ -129,6 +170,9 @@ class ImageData : public ImageDataBase
 	static bool getConstant(FormatHandler::EncodedFormat in, const char *&out);
 	static std::vector<std::string> getConstants(FormatHandler::EncodedFormat);
 
+	STRINGMAP_CLASS_DECLARE(FormatHandler::RowFilter);
+	STRINGMAP_CLASS_DECLARE(ResizeFilter);
+
 private:
 
 	// Create imagedata. Initialize with data if not null.
@@ -137,6 +181,9 @@ class ImageData : public ImageDataBase
 	// Decode and load an encoded format.
 	void decode(Data *data);
 
+	// Checks whether the filters which work on float pixels support this format.
+	void checkFilterable(const char *name) const;
+
 	// The actual data.
 	unsigned char *data = nullptr;
 
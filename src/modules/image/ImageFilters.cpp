@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ImageFilters.h"
+#include "common/config.h"
+#include "common/math.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace image
+{
+
+// Filter passes over fewer values than this aren't worth splitting up.
+static const size_t PARALLEL_MIN_WORK = 256 * 256 * 4;
+static const size_t PARALLEL_CHUNK_WORK = 64 * 1024;
+
+// One RGBA32F pixel.
+#if defined(LOVE_SIMD_SSE)
+
+typedef __m128 Pixel4;
+
+static inline Pixel4 zero4() { return _mm_setzero_ps(); }
+static inline Pixel4 load4(const float *p) { return _mm_loadu_ps(p); }
+static inline void store4(float *p, Pixel4 v) { _mm_storeu_ps(p, v); }
+static inline Pixel4 madd4(Pixel4 acc, Pixel4 v, float w) { return _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(w))); }
+
+#elif defined(LOVE_SIMD_NEON)
+
+typedef float32x4_t Pixel4;
+
+static inline Pixel4 zero4() { return vdupq_n_f32(0.0f); }
+static inline Pixel4 load4(const float *p) { return vld1q_f32(p); }
+static inline void store4(float *p, Pixel4 v) { vst1q_f32(p, v); }
+static inline Pixel4 madd4(Pixel4 acc, Pixel4 v, float w) { return vmlaq_n_f32(acc, v, w); }
+
+#else
+
+struct Pixel4 { float v[4]; };
+
+static inline Pixel4 zero4() { return {{0.0f, 0.0f, 0.0f, 0.0f}}; }
+static inline Pixel4 load4(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+static inline void store4(float *p, Pixel4 v) { memcpy(p, v.v, sizeof(float) * 4); }
+static inline Pixel4 madd4(Pixel4 acc, Pixel4 v, float w)
+{
+	for (int i = 0; i < 4; i++)
+		acc.v[i] += v.v[i] * w;
+	return acc;
+}
+
+#endif
+
+/**
+ * The source pixels and weights which contribute to each destination pixel,
+ * along one axis.
+ **/
+struct Contributions
+{
+	std::vector<int> first;
+	std::vector<int> count;
+	std::vector<float> weights;
+	int stride = 0;
+
+	const float *getWeights(int i) const { return &weights[(size_t) i * stride]; }
+};
+
+static float sinc(float x)
+{
+	if (x == 0.0f)
+		return 1.0f;
+	x *= (float) LOVE_M_PI;
+	return sinf(x) / x;
+}
+
+static float getFilterSupport(ResizeFilter filter)
+{
+	switch (filter)
+	{
+		case RESIZE_FILTER_BOX: return 0.5f;
+		case RESIZE_FILTER_LINEAR: return 1.0f;
+		case RESIZE_FILTER_LANCZOS: return 3.0f;
+		case RESIZE_FILTER_NEAREST:
+		default: return 0.0f;
+	}
+}
+
+static float evaluateFilter(ResizeFilter filter, float x)
+{
+	x = fabsf(x);
+
+	switch (filter)
+	{
+	case RESIZE_FILTER_BOX:
+		return x < 0.5f ? 1.0f : (x == 0.5f ? 0.5f : 0.0f);
+	case RESIZE_FILTER_LINEAR:
+		return x < 1.0f ? 1.0f - x : 0.0f;
+	case RESIZE_FILTER_LANCZOS:
+		return x < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+	case RESIZE_FILTER_NEAREST:
+	default:
+		return 0.0f;
+	}
+}
+
+template <typename Center, typename Weight>
+static void computeContributions(int dstsize, int srcsize, float radius, const Center &center, const Weight &weight, Contributions &c)
+{
+	int stride = (int) ceilf(radius) * 2 + 2;
+
+	c.first.resize(dstsize);
+	c.count.resize(dstsize);
+	c.weights.assign((size_t) dstsize * stride, 0.0f);
+	c.stride = stride;
+
+	for (int i = 0; i < dstsize; i++)
+	{
+		float centerpos = center(i);
+		int first = std::max((int) floorf(centerpos - radius), 0);
+		int last = std::min((int) ceilf(centerpos + radius), srcsize - 1);
+
+		float *weights = &c.weights[(size_t) i * stride];
+		float total = 0.0f;
+		int count = 0;
+
+		for (int j = first; j <= last && count < stride; j++)
+		{
+			float w = weight(j + 0.5f - centerpos);
+			weights[count++] = w;
+			total += w;
+		}
+
+		if (total != 0.0f)
+		{
+			for (int k = 0; k < count; k++)
+				weights[k] /= total;
+
+			c.first[i] = first;
+			c.count[i] = count;
+		}
+		else
+		{
+			// The filter didn't touch any source pixel, use the nearest one.
+			c.first[i] = std::min(std::max((int) centerpos, 0), srcsize - 1);
+			c.count[i] = 1;
+			weights[0] = 1.0f;
+		}
+	}
+}
+
+static void computeResizeContributions(int dstsize, int srcsize, ResizeFilter filter, Contributions &c)
+{
+	float scale = (float) dstsize / (float) srcsize;
+
+	// Widen the filter when downscaling so it covers every source pixel.
+	float filterscale = std::max(1.0f / scale, 1.0f);
+	float radius = getFilterSupport(filter) * filterscale;
+
+	auto center = [scale](int i)
+	{
+		return (i + 0.5f) / scale;
+	};
+
+	auto weight = [filter, filterscale](float x)
+	{
+		return evaluateFilter(filter, x / filterscale);
+	};
+
+	computeContributions(dstsize, srcsize, radius, center, weight, c);
+}
+
+static void computeGaussianContributions(int size, float sigma, Contributions &c)
+{
+	float radius = ceilf(sigma * 3.0f);
+	float scale = -1.0f / (2.0f * sigma * sigma);
+
+	auto center = [](int i)
+	{
+		return i + 0.5f;
+	};
+
+	auto weight = [scale](float x)
+	{
+		return expf(x * x * scale);
+	};
+
+	computeContributions(size, size, radius, center, weight, c);
+}
+
+void parallelForRows(int rows, size_t valuesperrow, const std::function<void(size_t, size_t)> &func)
+{
+	if ((size_t) rows * valuesperrow >= PARALLEL_MIN_WORK && rows > 1)
+	{
+		size_t rowsperchunk = std::max<size_t>(PARALLEL_CHUNK_WORK / std::max<size_t>(valuesperrow, 1), 1);
+		love::thread::ThreadPool::getShared().parallelFor(rows, rowsperchunk, func);
+	}
+	else
+		func(0, rows);
+}
+
+static void filterHorizontal(const float *src, int srcwidth, float *dst, int dstwidth, int height, const Contributions &c)
+{
+	parallelForRows(height, (size_t) dstwidth * 4 * c.stride, [&](size_t begin, size_t end)
+	{
+		for (size_t y = begin; y < end; y++)
+		{
+			const float *srcrow = src + y * srcwidth * 4;
+			float *dstrow = dst + y * dstwidth * 4;
+
+			for (int x = 0; x < dstwidth; x++)
+			{
+				const float *weights = c.getWeights(x);
+				const float *s = srcrow + c.first[x] * 4;
+				int count = c.count[x];
+
+				Pixel4 acc = zero4();
+				for (int k = 0; k < count; k++)
+					acc = madd4(acc, load4(s + k * 4), weights[k]);
+
+				store4(dstrow + x * 4, acc);
+			}
+		}
+	});
+}
+
+static void filterVertical(const float *src, float *dst, int width, int dstheight, const Contributions &c)
+{
+	parallelForRows(dstheight, (size_t) width * 4 * c.stride, [&](size_t begin, size_t end)
+	{
+		for (size_t y = begin; y < end; y++)
+		{
+			const float *weights = c.getWeights((int) y);
+			int first = c.first[y];
+			int count = c.count[y];
+
+			float *dstrow = dst + y * width * 4;
+
+			// Accumulate whole source rows at a time, to read memory linearly.
+			for (int x = 0; x < width; x++)
+				store4(dstrow + x * 4, zero4());
+
+			for (int k = 0; k < count; k++)
+			{
+				const float *srcrow = src + (size_t) (first + k) * width * 4;
+				float w = weights[k];
+
+				for (int x = 0; x < width; x++)
+					store4(dstrow + x * 4, madd4(load4(dstrow + x * 4), load4(srcrow + x * 4), w));
+			}
+		}
+	});
+}
+
+void resizeRGBA32F(const float *src, int srcwidth, int srcheight, float *dst, int dstwidth, int dstheight, ResizeFilter filter)
+{
+	if (srcwidth == dstwidth && srcheight == dstheight)
+	{
+		memcpy(dst, src, sizeof(float) * 4 * dstwidth * dstheight);
+		return;
+	}
+
+	// Resize horizontally first, then vertically from the intermediate image.
+	const float *hsrc = src;
+	std::vector<float> temp;
+
+	if (srcwidth != dstwidth)
+	{
+		Contributions c;
+		computeResizeContributions(dstwidth, srcwidth, filter, c);
+
+		temp.resize((size_t) dstwidth * srcheight * 4);
+		filterHorizontal(src, srcwidth, temp.data(), dstwidth, srcheight, c);
+		hsrc = temp.data();
+	}
+
+	if (srcheight != dstheight)
+	{
+		Contributions c;
+		computeResizeContributions(dstheight, srcheight, filter, c);
+		filterVertical(hsrc, dst, dstwidth, dstheight, c);
+	}
+	else
+		memcpy(dst, hsrc, sizeof(float) * 4 * dstwidth * dstheight);
+}
+
+void gaussianBlurRGBA32F(float *pixels, int width, int height, float sigma)
+{
+	if (sigma <= 0.0f || width <= 0 || height <= 0)
+		return;
+
+	std::vector<float> temp((size_t) width * height * 4);
+
+	Contributions c;
+	computeGaussianContributions(width, sigma, c);
+	filterHorizontal(pixels, width, temp.data(), width, height, c);
+
+	computeGaussianContributions(height, sigma, c);
+	filterVertical(temp.data(), pixels, width, height, c);
+}
+
+void premultiplyRGBA32F(float *pixels, size_t count)
+{
+	for (size_t i = 0; i < count; i++, pixels += 4)
+	{
+		float a = pixels[3];
+		pixels[0] *= a;
+		pixels[1] *= a;
+		pixels[2] *= a;
+	}
+}
+
+void unpremultiplyRGBA32F(float *pixels, size_t count)
+{
+	for (size_t i = 0; i < count; i++, pixels += 4)
+	{
+		float a = pixels[3];
+		if (a > 0.0f)
+		{
+			float inva = 1.0f / a;
+			pixels[0] *= inva;
+			pixels[1] *= inva;
+			pixels[2] *= inva;
+		}
+	}
+}
+
+} // image
+} // love
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// C++
+#include <stddef.h>
+#include <functional>
+
+namespace love
+{
+namespace image
+{
+
+enum ResizeFilter
+{
+	RESIZE_FILTER_NEAREST,
+	RESIZE_FILTER_BOX,
+	RESIZE_FILTER_LINEAR,
+	RESIZE_FILTER_LANCZOS,
+	RESIZE_FILTER_MAX_ENUM
+};
+
+/**
+ * Image filters which operate on tightly packed RGBA32F pixels. Each pass is
+ * separated into a horizontal and a vertical step, and large images are split
+ * into groups of rows which are processed on the shared thread pool.
+ **/
+
+/**
+ * Resamples src into dst. Downscaling widens the filter so every source pixel
+ * contributes to the result.
+ **/
+void resizeRGBA32F(const float *src, int srcwidth, int srcheight, float *dst, int dstwidth, int dstheight, ResizeFilter filter);
+
+/**
+ * Blurs the pixels in-place. sigma is the standard deviation of the Gaussian
+ * in pixels. Pixels outside the image don't contribute to the result.
+ **/
+void gaussianBlurRGBA32F(float *pixels, int width, int height, float sigma);
+
+void premultiplyRGBA32F(float *pixels, size_t count);
+void unpremultiplyRGBA32F(float *pixels, size_t count);
+
+/**
+ * Calls func with ranges of rows, on the shared thread pool if there's enough
+ * work to make it worthwhile.
+ **/
+void parallelForRows(int rows, size_t valuesperrow, const std::function<void(size_t, size_t)> &func);
+
+} // image
+} // love
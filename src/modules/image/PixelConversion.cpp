@@ -0,0 +1,500 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "PixelConversion.h"
+#include "ImageData.h"
+#include "common/config.h"
+#include "common/Exception.h"
+#include "common/floattypes.h"
+#include "thread/ThreadPool.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(LOVE_SIMD_SSE) && (defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LOVE_PIXELCONVERSION_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace love
+{
+namespace image
+{
+
+// Conversions of images with fewer pixels than this aren't worth splitting up.
+static const size_t PARALLEL_MIN_PIXELS = 256 * 256;
+static const size_t PARALLEL_CHUNK_PIXELS = 64 * 1024;
+
+static float clamp01(float x)
+{
+	return std::min(std::max(x, 0.0f), 1.0f);
+}
+
+// Component converters. n is the number of components, not pixels.
+
+static void convertU8toF32(const uint8 *src, float *dst, size_t n)
+{
+	const float scale = 1.0f / 255.0f;
+	size_t i = 0;
+
+#if defined(LOVE_PIXELCONVERSION_SSE2)
+	const __m128 vscale = _mm_set1_ps(scale);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+
+		_mm_storeu_ps(dst + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), vscale));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), vscale));
+		_mm_storeu_ps(dst + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), vscale));
+		_mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), vscale));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float32x4_t vscale = vdupq_n_f32(scale);
+
+	for (; i + 16 <= n; i += 16)
+	{
+		uint8x16_t v = vld1q_u8(src + i);
+		uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+
+		vst1q_f32(dst + i + 0, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), vscale));
+		vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), vscale));
+		vst1q_f32(dst + i + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), vscale));
+		vst1q_f32(dst + i + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), vscale));
+	}
+#endif
+
+	for (; i < n; i++)
+		dst[i] = src[i] * scale;
+}
+
+static void convertF32toU8(const float *src, uint8 *dst, size_t n)
+{
+	size_t i = 0;
+
+#if defined(LOVE_PIXELCONVERSION_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	auto convert4 = [&](const float *p)
+	{
+		__m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), zero), one);
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+	};
+
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i a = _mm_packs_epi32(convert4(src + i + 0), convert4(src + i + 4));
+		__m128i b = _mm_packs_epi32(convert4(src + i + 8), convert4(src + i + 12));
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t scale = vdupq_n_f32(255.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+
+	auto convert4 = [&](const float *p)
+	{
+		float32x4_t v = vminq_f32(vmaxq_f32(vld1q_f32(p), zero), one);
+		return vqmovn_u32(vcvtq_u32_f32(vaddq_f32(vmulq_f32(v, scale), half)));
+	};
+
+	for (; i + 16 <= n; i += 16)
+	{
+		uint16x8_t a = vcombine_u16(convert4(src + i + 0), convert4(src + i + 4));
+		uint16x8_t b = vcombine_u16(convert4(src + i + 8), convert4(src + i + 12));
+		vst1q_u8(dst + i, vcombine_u8(vqmovn_u16(a), vqmovn_u16(b)));
+	}
+#endif
+
+	for (; i < n; i++)
+		dst[i] = (uint8) (clamp01(src[i]) * 255.0f + 0.5f);
+}
+
+static void convertU8toU16(const uint8 *src, uint16 *dst, size_t n)
+{
+	size_t i = 0;
+
+#if defined(LOVE_PIXELCONVERSION_SSE2)
+	// Interleaving a byte with itself is the same as multiplying it by 257.
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+		_mm_storeu_si128((__m128i *) (dst + i + 0), _mm_unpacklo_epi8(v, v));
+		_mm_storeu_si128((__m128i *) (dst + i + 8), _mm_unpackhi_epi8(v, v));
+	}
+#elif defined(LOVE_SIMD_NEON)
+	for (; i + 16 <= n; i += 16)
+	{
+		uint8x16x2_t v;
+		v.val[0] = v.val[1] = vld1q_u8(src + i);
+		vst2q_u8((uint8 *) (dst + i), v);
+	}
+#endif
+
+	for (; i < n; i++)
+		dst[i] = (uint16) (src[i] * 257);
+}
+
+static void convertU16toU8(const uint16 *src, uint8 *dst, size_t n)
+{
+	// Same as rounding x * 255 / 65535, for every 16 bit value.
+	for (size_t i = 0; i < n; i++)
+		dst[i] = (uint8) ((src[i] * 255u + 32895u) >> 16);
+}
+
+static void convertU16toF32(const uint16 *src, float *dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		dst[i] = src[i] / 65535.0f;
+}
+
+static void convertF32toU16(const float *src, uint16 *dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		dst[i] = (uint16) (clamp01(src[i]) * 65535.0f + 0.5f);
+}
+
+static void convertF16toF32(const float16 *src, float *dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		dst[i] = float16to32(src[i]);
+}
+
+static void convertF32toF16(const float *src, float16 *dst, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		dst[i] = float32to16(src[i]);
+}
+
+// Direct row converters, for format pairs which don't need a float step.
+
+typedef void (*DirectRowFunction)(const uint8 *src, uint8 *dst, int width);
+
+static void rowRGBA8toRGBA16(const uint8 *src, uint8 *dst, int width)
+{
+	convertU8toU16(src, (uint16 *) dst, (size_t) width * 4);
+}
+
+static void rowRGBA16toRGBA8(const uint8 *src, uint8 *dst, int width)
+{
+	convertU16toU8((const uint16 *) src, dst, (size_t) width * 4);
+}
+
+static void rowR8toRGBA8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, dst += 4)
+	{
+		dst[0] = src[x];
+		dst[1] = 0;
+		dst[2] = 0;
+		dst[3] = 255;
+	}
+}
+
+static void rowRG8toRGBA8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, src += 2, dst += 4)
+	{
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = 0;
+		dst[3] = 255;
+	}
+}
+
+static void rowLA8toRGBA8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, src += 2, dst += 4)
+	{
+		dst[0] = dst[1] = dst[2] = src[0];
+		dst[3] = src[1];
+	}
+}
+
+static void rowRGBA8toR8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, src += 4)
+		dst[x] = src[0];
+}
+
+static void rowRGBA8toRG8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, src += 4, dst += 2)
+	{
+		dst[0] = src[0];
+		dst[1] = src[1];
+	}
+}
+
+static void rowRGBA8toLA8(const uint8 *src, uint8 *dst, int width)
+{
+	for (int x = 0; x < width; x++, src += 4, dst += 2)
+	{
+		dst[0] = src[0];
+		dst[1] = src[3];
+	}
+}
+
+static DirectRowFunction getDirectRowFunction(PixelFormat srcformat, PixelFormat dstformat)
+{
+	if (srcformat == PIXELFORMAT_RGBA8_UNORM)
+	{
+		switch (dstformat)
+		{
+			case PIXELFORMAT_RGBA16_UNORM: return rowRGBA8toRGBA16;
+			case PIXELFORMAT_R8_UNORM: return rowRGBA8toR8;
+			case PIXELFORMAT_RG8_UNORM: return rowRGBA8toRG8;
+			case PIXELFORMAT_LA8_UNORM: return rowRGBA8toLA8;
+			default: return nullptr;
+		}
+	}
+	else if (dstformat == PIXELFORMAT_RGBA8_UNORM)
+	{
+		switch (srcformat)
+		{
+			case PIXELFORMAT_RGBA16_UNORM: return rowRGBA16toRGBA8;
+			case PIXELFORMAT_R8_UNORM: return rowR8toRGBA8;
+			case PIXELFORMAT_RG8_UNORM: return rowRG8toRGBA8;
+			case PIXELFORMAT_LA8_UNORM: return rowLA8toRGBA8;
+			default: return nullptr;
+		}
+	}
+
+	return nullptr;
+}
+
+// Float RGBA row converters, for everything else.
+
+static void toFloatRow(const uint8 *src, PixelFormat format, ImageData::PixelGetFunction get, float *rgba, int width)
+{
+	size_t n = (size_t) width * 4;
+
+	switch (format)
+	{
+	case PIXELFORMAT_RGBA8_UNORM:
+		convertU8toF32(src, rgba, n);
+		break;
+	case PIXELFORMAT_RGBA16_UNORM:
+		convertU16toF32((const uint16 *) src, rgba, n);
+		break;
+	case PIXELFORMAT_RGBA16_FLOAT:
+		convertF16toF32((const float16 *) src, rgba, n);
+		break;
+	case PIXELFORMAT_RGBA32_FLOAT:
+		memcpy(rgba, src, n * sizeof(float));
+		break;
+	default:
+	{
+		size_t pixelsize = getPixelFormatBlockSize(format);
+		for (int x = 0; x < width; x++)
+			get((const ImageData::Pixel *) (src + x * pixelsize), *(Colorf *) (rgba + x * 4));
+		break;
+	}
+	}
+}
+
+static void fromFloatRow(const float *rgba, PixelFormat format, ImageData::PixelSetFunction set, uint8 *dst, int width)
+{
+	size_t n = (size_t) width * 4;
+
+	switch (format)
+	{
+	case PIXELFORMAT_RGBA8_UNORM:
+		convertF32toU8(rgba, dst, n);
+		break;
+	case PIXELFORMAT_RGBA16_UNORM:
+		convertF32toU16(rgba, (uint16 *) dst, n);
+		break;
+	case PIXELFORMAT_RGBA16_FLOAT:
+		convertF32toF16(rgba, (float16 *) dst, n);
+		break;
+	case PIXELFORMAT_RGBA32_FLOAT:
+		memcpy(dst, rgba, n * sizeof(float));
+		break;
+	default:
+	{
+		size_t pixelsize = getPixelFormatBlockSize(format);
+		for (int x = 0; x < width; x++)
+			set(*(const Colorf *) (rgba + x * 4), (ImageData::Pixel *) (dst + x * pixelsize));
+		break;
+	}
+	}
+}
+
+// sRGB transfer functions.
+
+static float srgbToLinear(float c)
+{
+	if (c <= 0.04045f)
+		return c / 12.92f;
+	else
+		return powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSRGB(float c)
+{
+	if (c <= 0.0031308f)
+		return c * 12.92f;
+	else
+		return 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static void applyTransfer(float *rgba, int width, bool tolinear)
+{
+	for (int x = 0; x < width; x++, rgba += 4)
+	{
+		for (int c = 0; c < 3; c++)
+			rgba[c] = tolinear ? srgbToLinear(rgba[c]) : linearToSRGB(rgba[c]);
+	}
+}
+
+struct TransferTable8
+{
+	uint8 values[256];
+
+	TransferTable8(bool tolinear)
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			float c = i / 255.0f;
+			c = tolinear ? srgbToLinear(c) : linearToSRGB(c);
+			values[i] = (uint8) (clamp01(c) * 255.0f + 0.5f);
+		}
+	}
+};
+
+static const uint8 *getTransferTable8(bool tolinear)
+{
+	static const TransferTable8 tolinearTable(true);
+	static const TransferTable8 toSRGBTable(false);
+	return tolinear ? tolinearTable.values : toSRGBTable.values;
+}
+
+static bool isColorChannel8(PixelFormat format, int channel)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_R8_UNORM: return true;
+		case PIXELFORMAT_RG8_UNORM: return true;
+		case PIXELFORMAT_LA8_UNORM: return channel == 0;
+		case PIXELFORMAT_RGBA8_UNORM: return channel < 3;
+		default: return false;
+	}
+}
+
+bool isPixelConversionSupported(PixelFormat srcformat, PixelFormat dstformat)
+{
+	if (srcformat == dstformat && isColorChannel8(srcformat, 0))
+		return true;
+
+	if (getDirectRowFunction(srcformat, dstformat) != nullptr)
+		return true;
+
+	return ImageData::getPixelGetFunction(srcformat) != nullptr
+		&& ImageData::getPixelSetFunction(dstformat) != nullptr;
+}
+
+void convertPixels(const void *src, size_t srcstride, PixelFormat srcformat, bool srclinear,
+                   void *dst, size_t dststride, PixelFormat dstformat, bool dstlinear,
+                   int width, int height)
+{
+	if (width <= 0 || height <= 0)
+		return;
+
+	bool transfer = srclinear != dstlinear;
+	bool tolinear = dstlinear;
+
+	auto get = ImageData::getPixelGetFunction(srcformat);
+	auto set = ImageData::getPixelSetFunction(dstformat);
+
+	DirectRowFunction direct = transfer ? nullptr : getDirectRowFunction(srcformat, dstformat);
+
+	// 8 bit formats can be converted between sRGB and linear with a table.
+	bool table8 = transfer && srcformat == dstformat && isColorChannel8(srcformat, 0);
+
+	if (!direct && !table8 && !(srcformat == dstformat && !transfer))
+	{
+		if (get == nullptr)
+			throw love::Exception("Converting from the %s pixel format is not supported.", getPixelFormatName(srcformat));
+		if (set == nullptr)
+			throw love::Exception("Converting to the %s pixel format is not supported.", getPixelFormatName(dstformat));
+	}
+
+	size_t rowsize = getPixelFormatUncompressedRowSize(dstformat, width);
+
+	auto convertRows = [&](size_t begin, size_t end)
+	{
+		std::vector<float> rgba;
+
+		for (size_t y = begin; y < end; y++)
+		{
+			const uint8 *s = (const uint8 *) src + y * srcstride;
+			uint8 *d = (uint8 *) dst + y * dststride;
+
+			if (srcformat == dstformat && !transfer)
+				memcpy(d, s, rowsize);
+			else if (direct != nullptr)
+				direct(s, d, width);
+			else if (table8)
+			{
+				const uint8 *table = getTransferTable8(tolinear);
+				int components = (int) getPixelFormatBlockSize(srcformat);
+				for (int i = 0; i < width * components; i++)
+					d[i] = isColorChannel8(srcformat, i % components) ? table[s[i]] : s[i];
+			}
+			else
+			{
+				rgba.resize((size_t) width * 4);
+				toFloatRow(s, srcformat, get, rgba.data(), width);
+				if (transfer)
+					applyTransfer(rgba.data(), width, tolinear);
+				fromFloatRow(rgba.data(), dstformat, set, d, width);
+			}
+		}
+	};
+
+	size_t pixels = (size_t) width * height;
+
+	if (pixels >= PARALLEL_MIN_PIXELS && height > 1)
+	{
+		size_t rowsperchunk = std::max<size_t>(PARALLEL_CHUNK_PIXELS / width, 1);
+		love::thread::ThreadPool::getShared().parallelFor(height, rowsperchunk, convertRows);
+	}
+	else
+		convertRows(0, height);
+}
+
+} // image
+} // love
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/pixelformat.h"
+
+// C++
+#include <stddef.h>
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * Gets whether convertPixels can convert between the two formats.
+ **/
+bool isPixelConversionSupported(PixelFormat srcformat, PixelFormat dstformat);
+
+/**
+ * Converts a rectangle of pixels between two uncompressed color formats.
+ * Common format pairs use dedicated row kernels, and everything else goes
+ * through a float RGBA intermediate. Large rectangles are split into groups of
+ * rows which are converted on the shared thread pool.
+ * When srclinear and dstlinear differ, color values are also converted between
+ * the sRGB and linear encodings. Alpha values are never changed.
+ * Strides are in bytes.
+ **/
+void convertPixels(const void *src, size_t srcstride, PixelFormat srcformat, bool srclinear,
+                   void *dst, size_t dststride, PixelFormat dstformat, bool dstlinear,
+                   int width, int height);
+
+} // image
+} // love
@@ -274,6 +274,49 @@ PixelFormat convertFormat(uint32 glformat)
 	}
 }
 
+uint32 convertToGLFormat(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_ETC1_UNORM:
+		return KTX_GL_ETC1_RGB8_OES;
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+		return KTX_GL_COMPRESSED_RGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_ETC2;
+	case PIXELFORMAT_ETC2_RGBA_UNORM:
+		return KTX_GL_COMPRESSED_RGBA8_ETC2_EAC;
+	case PIXELFORMAT_ETC2_RGBA_sRGB:
+		return KTX_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+	case PIXELFORMAT_DXT1_UNORM:
+		return KTX_GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT1_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+	case PIXELFORMAT_DXT3_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+	case PIXELFORMAT_DXT3_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+	case PIXELFORMAT_DXT5_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_DXT5_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+	case PIXELFORMAT_BC4_UNORM:
+		return KTX_GL_COMPRESSED_RED_RGTC1;
+	case PIXELFORMAT_BC4_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_RED_RGTC1;
+	case PIXELFORMAT_BC5_UNORM:
+		return KTX_GL_COMPRESSED_RG_RGTC2;
+	case PIXELFORMAT_BC5_SNORM:
+		return KTX_GL_COMPRESSED_SIGNED_RG_RGTC2;
+	case PIXELFORMAT_BC7_UNORM:
+		return KTX_GL_COMPRESSED_RGBA_BPTC_UNORM;
+	case PIXELFORMAT_BC7_sRGB:
+		return KTX_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+	default:
+		return 0;
+	}
+}
+
 } // Anonymous namespace.
 
 bool KTXHandler::canParseCompressed(Data *data)
@@ -383,6 +426,52 @@ StrongRef<ByteData> KTXHandler::parseCompressed(Data *filedata, std::vector<Stro
 	return memory;
 }
 
+ByteData *KTXHandler::encodeCompressed(PixelFormat format, const std::vector<StrongRef<CompressedSlice>> &images)
+{
+	uint32 glformat = convertToGLFormat(format);
+
+	if (glformat == 0)
+		throw love::Exception("Cannot write the %s pixel format to a KTX file.", getPixelFormatName(format));
+
+	if (images.empty())
+		throw love::Exception("Cannot write a KTX file with no image data.");
+
+	size_t totalsize = sizeof(KTXHeader);
+	for (const auto &image : images)
+		totalsize += sizeof(uint32) + ((image->getSize() + 3) & ~size_t(3));
+
+	ByteData *filedata = new ByteData(totalsize, true);
+	uint8 *filebytes = (uint8 *) filedata->getData();
+
+	KTXHeader header = {};
+	uint8 ktxidentifier[12] = KTX_IDENTIFIER_REF;
+	memcpy(header.identifier, ktxidentifier, 12);
+
+	// Compressed formats have a glType and glFormat of 0, and a glTypeSize of 1.
+	header.endianness = KTX_ENDIAN_REF;
+	header.glTypeSize = 1;
+	header.glInternalFormat = glformat;
+	header.pixelWidth = (uint32) images[0]->getWidth();
+	header.pixelHeight = (uint32) images[0]->getHeight();
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32) images.size();
+
+	memcpy(filebytes, &header, sizeof(KTXHeader));
+	size_t fileoffset = sizeof(KTXHeader);
+
+	for (const auto &image : images)
+	{
+		uint32 mipsize = (uint32) image->getSize();
+		memcpy(filebytes + fileoffset, &mipsize, sizeof(uint32));
+		fileoffset += sizeof(uint32);
+
+		memcpy(filebytes + fileoffset, image->getData(), mipsize);
+		fileoffset += (mipsize + 3) & ~uint32(3);
+	}
+
+	return filedata;
+}
+
 } // magpie
 } // image
 } // love
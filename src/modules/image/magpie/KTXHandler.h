@@ -46,6 +46,12 @@ class KTXHandler : public FormatHandler
 	        std::vector<StrongRef<CompressedSlice>> &images,
 	        PixelFormat &format) override;
 
+	/**
+	 * Writes compressed mipmap levels into a new KTX file in memory, which can
+	 * be read back with parseCompressed.
+	 **/
+	static ByteData *encodeCompressed(PixelFormat format, const std::vector<StrongRef<CompressedSlice>> &images);
+
 }; // KTXHandler
 
 } // magpie
@@ -23,6 +23,7 @@
 // LOVE
 #include "common/Exception.h"
 #include "common/math.h"
+#include "thread/ThreadPool.h"
 
 // LodePNG
 #include "lodepng/lodepng.h"
@@ -32,9 +33,12 @@
 
 // C++
 #include <algorithm>
+#include <vector>
 
 // C
+#include <climits>
 #include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -43,64 +47,282 @@ namespace image
 namespace magpie
 {
 
+// Gets the size of a PNG's filtered scanlines, which is exactly what its image
+// data inflates to.
+static size_t getInflatedImageSize(unsigned int width, unsigned int height, const LodePNGInfo &info)
+{
+	size_t bpp = lodepng_get_bpp(&info.color);
+
+	auto getPassSize = [bpp](size_t w, size_t h) -> size_t
+	{
+		if (w == 0 || h == 0)
+			return 0;
+
+		// Each row starts with a filter type byte.
+		return h * (1 + (w * bpp + 7) / 8);
+	};
+
+	if (info.interlace_method == 0)
+		return getPassSize(width, height);
+
+	// Adam7 interlacing stores 7 reduced images one after another.
+	static const unsigned int startx[7] = {0, 4, 0, 2, 0, 1, 0};
+	static const unsigned int starty[7] = {0, 0, 4, 0, 2, 0, 1};
+	static const unsigned int stepx[7] = {8, 8, 4, 4, 2, 2, 1};
+	static const unsigned int stepy[7] = {8, 8, 8, 4, 4, 2, 2};
+
+	size_t size = 0;
+	for (int i = 0; i < 7; i++)
+	{
+		size_t w = (width + stepx[i] - startx[i] - 1) / stepx[i];
+		size_t h = (height + stepy[i] - starty[i] - 1) / stepy[i];
+		size += getPassSize(w, h);
+	}
+
+	return size;
+}
+
 // Custom PNG decompression function for LodePNG, using zlib.
 static unsigned zlibDecompress(unsigned char **out, size_t *outsize, const unsigned char *in,
-                               size_t insize, const LodePNGDecompressSettings* /*settings*/)
+                               size_t insize, const LodePNGDecompressSettings *settings)
 {
-	int status = Z_OK;
+	// The image data inflates to a size known from the PNG header, so it can
+	// go straight into a buffer of the right size. Other compressed chunks
+	// (text, ICC profiles) have an output size limit set instead, and grow
+	// their buffer as needed.
+	auto inflatedsize = (const size_t *) settings->custom_context;
+	bool knownsize = inflatedsize != nullptr && settings->max_output_size == 0;
 
-	uLongf outdatasize = insize;
-	size_t sizemultiplier = 0;
+	// The extra byte lets zlib reach the end of the stream without running
+	// out of space for valid data.
+	size_t capacity = knownsize ? *inflatedsize + 1 : std::max(insize * 4, (size_t) 1024);
+
+	// LodePNG uses malloc, realloc, and free.
+	// Since version 2014-08-23, LodePNG passes in an existing pointer in
+	// the 'out' argument that it expects to be realloc'd. Not doing so can
+	// result in a memory leak.
 	unsigned char *outdata = out != nullptr ? *out : nullptr;
 
-	while (true)
+	if (outdata != nullptr)
+		outdata = (unsigned char *) realloc(outdata, capacity);
+	else
+		outdata = (unsigned char *) malloc(capacity);
+
+	if (!outdata)
+		return 83; // "Memory allocation failed" error code for LodePNG.
+
+	z_stream stream = {};
+	stream.next_in = (Bytef *) in;
+	stream.avail_in = (uInt) insize;
+
+	int status = inflateInit(&stream);
+	size_t total = 0;
+
+	while (status == Z_OK)
 	{
-		// Enough size to hold the decompressed data, hopefully.
-		outdatasize = insize << (++sizemultiplier);
-
-		// LodePNG uses malloc, realloc, and free.
-		// Since version 2014-08-23, LodePNG passes in an existing pointer in
-		// the 'out' argument that it expects to be realloc'd. Not doing so can
-		// result in a memory leak.
-		if (outdata != nullptr)
-			outdata = (unsigned char *) realloc(outdata, outdatasize);
-		else
-			outdata = (unsigned char *) malloc(outdatasize);
-
-		if (!outdata)
-			return 83; // "Memory allocation failed" error code for LodePNG.
-
-		// Use zlib to decompress the PNG data.
-		status = uncompress(outdata, &outdatasize, in, insize);
-
-		// If the out buffer was big enough, break out of the loop.
-		if (status != Z_BUF_ERROR)
+		uInt avail = (uInt) std::min(capacity - total, (size_t) UINT_MAX);
+		stream.next_out = outdata + total;
+		stream.avail_out = avail;
+
+		status = inflate(&stream, Z_NO_FLUSH);
+		total += avail - stream.avail_out;
+
+		if (status == Z_STREAM_END)
+			break;
+		else if (status != Z_OK)
 			break;
 
-		// Otherwise delete the out buffer and try again with a larger size...
-		free(outdata);
-		outdata = nullptr;
+		if (stream.avail_out == 0 && total == capacity)
+		{
+			// Only reached for chunks of unknown size, or corrupt image data.
+			if (settings->max_output_size > 0 && capacity >= settings->max_output_size)
+			{
+				status = Z_BUF_ERROR;
+				break;
+			}
+
+			capacity *= 2;
+			unsigned char *newdata = (unsigned char *) realloc(outdata, capacity);
+
+			if (!newdata)
+			{
+				status = Z_MEM_ERROR;
+				break;
+			}
+
+			outdata = newdata;
+		}
 	}
 
-	if (status != Z_OK)
+	inflateEnd(&stream);
+
+	if (status != Z_STREAM_END)
 	{
 		free(outdata);
-		return 10000; // "Unknown error code" for LodePNG.
+
+		if (out != nullptr)
+			*out = nullptr;
+
+		return status == Z_MEM_ERROR ? 83 : 10000; // "Unknown error code" for LodePNG.
 	}
 
 	if (out != nullptr)
 		*out = outdata;
+	else
+		free(outdata);
 
 	if (outsize != nullptr)
-		*outsize = outdatasize;
+		*outsize = total;
+
+	return 0; // Success.
+}
+
+// Data is deflated in independent chunks of this size on the thread pool,
+// when there's more than one chunk's worth.
+static const size_t DEFLATE_CHUNK_SIZE = 128 * 1024;
+
+// Each chunk is primed with the end of the previous one, so matches can still
+// reach back across chunk boundaries.
+static const size_t DEFLATE_DICTIONARY_SIZE = 32 * 1024;
+
+struct DeflateChunk
+{
+	std::vector<unsigned char> data;
+	uLong adler = 0;
+	bool success = false;
+};
+
+// Compresses part of a zlib stream as raw deflate data. Every chunk except the
+// last ends with a sync flush, which aligns it to a byte boundary so the
+// chunks can be concatenated.
+static bool deflateChunk(const unsigned char *in, size_t insize, const unsigned char *dictionary,
+                         size_t dictionarysize, int level, bool last, std::vector<unsigned char> &out)
+{
+	z_stream stream = {};
+
+	if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	if (dictionarysize > 0 && deflateSetDictionary(&stream, dictionary, (uInt) dictionarysize) != Z_OK)
+	{
+		deflateEnd(&stream);
+		return false;
+	}
+
+	// Extra room for the sync flush marker.
+	out.resize(deflateBound(&stream, (uLong) insize) + 16);
+
+	stream.next_in = (Bytef *) in;
+	stream.avail_in = (uInt) insize;
+	stream.next_out = out.data();
+	stream.avail_out = (uInt) out.size();
+
+	int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+
+	bool success = false;
+	if (last)
+		success = status == Z_STREAM_END;
+	else
+		success = status == Z_OK && stream.avail_in == 0 && stream.avail_out > 0;
+
+	out.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	return success;
+}
+
+static unsigned zlibCompressParallel(unsigned char **out, size_t *outsize, const unsigned char *in,
+                                     size_t insize, int level)
+{
+	size_t chunkcount = (insize + DEFLATE_CHUNK_SIZE - 1) / DEFLATE_CHUNK_SIZE;
+	std::vector<DeflateChunk> chunks(chunkcount);
+
+	love::thread::ThreadPool::getShared().parallelFor(chunkcount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t offset = i * DEFLATE_CHUNK_SIZE;
+			size_t size = std::min(DEFLATE_CHUNK_SIZE, insize - offset);
+			size_t dictionarysize = std::min(offset, DEFLATE_DICTIONARY_SIZE);
+
+			DeflateChunk &chunk = chunks[i];
+			chunk.success = deflateChunk(in + offset, size, in + offset - dictionarysize, dictionarysize,
+			                             level, i == chunkcount - 1, chunk.data);
+			chunk.adler = adler32(adler32(0L, Z_NULL, 0), in + offset, (uInt) size);
+		}
+	});
+
+	size_t datasize = 0;
+	uLong adler = adler32(0L, Z_NULL, 0);
+
+	for (size_t i = 0; i < chunkcount; i++)
+	{
+		if (!chunks[i].success)
+			return 10000; // "Unknown error code" for LodePNG.
+
+		size_t size = std::min(DEFLATE_CHUNK_SIZE, insize - i * DEFLATE_CHUNK_SIZE);
+		adler = adler32_combine(adler, chunks[i].adler, (z_off_t) size);
+		datasize += chunks[i].data.size();
+	}
+
+	// LodePNG uses malloc, realloc, and free.
+	unsigned char *outdata = (unsigned char *) malloc(datasize + 6);
+
+	if (!outdata)
+		return 83; // "Memory allocation failed" error code for LodePNG.
+
+	// zlib header: deflate with a 32K window, and the compression level hint.
+	int flevel = 2;
+	if (level >= 0 && level <= 1)
+		flevel = 0;
+	else if (level >= 2 && level <= 5)
+		flevel = 1;
+	else if (level >= 7)
+		flevel = 3;
+
+	unsigned int header = (0x78 << 8) | (flevel << 6);
+	header += 31 - (header % 31);
+
+	outdata[0] = (unsigned char) (header >> 8);
+	outdata[1] = (unsigned char) (header & 0xFF);
+
+	size_t offset = 2;
+	for (const DeflateChunk &chunk : chunks)
+	{
+		memcpy(outdata + offset, chunk.data.data(), chunk.data.size());
+		offset += chunk.data.size();
+	}
+
+	// zlib trailer: big-endian Adler-32 of the uncompressed data.
+	outdata[offset + 0] = (unsigned char) (adler >> 24);
+	outdata[offset + 1] = (unsigned char) (adler >> 16);
+	outdata[offset + 2] = (unsigned char) (adler >> 8);
+	outdata[offset + 3] = (unsigned char) (adler >> 0);
+
+	if (out != nullptr)
+		*out = outdata;
+	else
+		free(outdata);
+
+	if (outsize != nullptr)
+		*outsize = datasize + 6;
 
 	return 0; // Success.
 }
 
 // Custom PNG compression function for LodePNG, using zlib.
 static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigned char *in,
-                             size_t insize, const LodePNGCompressSettings* /*settings*/)
+                             size_t insize, const LodePNGCompressSettings *settings)
 {
+	auto encodesettings = (const FormatHandler::EncodeSettings *) settings->custom_context;
+
+	int level = Z_DEFAULT_COMPRESSION;
+	if (encodesettings != nullptr && encodesettings->compressionLevel >= 0)
+		level = std::min(encodesettings->compressionLevel, 9);
+
+	if (insize > DEFLATE_CHUNK_SIZE)
+		return zlibCompressParallel(out, outsize, in, insize, level);
+
 	// Get the maximum compressed size of the data.
 	uLongf outdatasize = compressBound(insize);
 
@@ -111,7 +333,7 @@ static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigne
 		return 83; // "Memory allocation failed" error code for LodePNG.
 
 	// Use zlib to compress the PNG data.
-	int status = compress(outdata, &outdatasize, in, insize);
+	int status = compress2(outdata, &outdatasize, in, insize, level);
 
 	if (status != Z_OK)
 	{
@@ -128,6 +350,21 @@ static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigne
 	return 0; // Success.
 }
 
+static LodePNGFilterStrategy getFilterStrategy(FormatHandler::RowFilter filter)
+{
+	switch (filter)
+	{
+		case FormatHandler::ROW_FILTER_NONE: return LFS_ZERO;
+		case FormatHandler::ROW_FILTER_SUB: return LFS_ONE;
+		case FormatHandler::ROW_FILTER_UP: return LFS_TWO;
+		case FormatHandler::ROW_FILTER_AVERAGE: return LFS_THREE;
+		case FormatHandler::ROW_FILTER_PAETH: return LFS_FOUR;
+		case FormatHandler::ROW_FILTER_ENTROPY: return LFS_ENTROPY;
+		case FormatHandler::ROW_FILTER_MINSUM:
+		default: return LFS_MINSUM;
+	}
+}
+
 bool PNGHandler::canDecode(Data *data)
 {
 	unsigned int width = 0, height = 0;
@@ -163,7 +400,10 @@ PNGHandler::DecodedImage PNGHandler::decode(Data *fdata)
 		throw love::Exception("Could not decode PNG image (%s)", err);
 	}
 
+	size_t inflatedsize = getInflatedImageSize(width, height, state.info_png);
+
 	state.decoder.zlibsettings.custom_zlib = zlibDecompress;
+	state.decoder.zlibsettings.custom_context = &inflatedsize;
 	state.info_raw.colortype = LCT_RGBA;
 
 	if (state.info_png.color.bitdepth == 16)
@@ -199,7 +439,7 @@ PNGHandler::DecodedImage PNGHandler::decode(Data *fdata)
 	return img;
 }
 
-FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat, const EncodeSettings &settings)
 {
 	if (!canEncode(img.format, encodedFormat))
 		throw love::Exception("PNG encoder cannot encode to non-PNG format.");
@@ -215,6 +455,8 @@ FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedF
 	state.info_png.color.bitdepth = state.info_raw.bitdepth;
 
 	state.encoder.zlibsettings.custom_zlib = zlibCompress;
+	state.encoder.zlibsettings.custom_context = &settings;
+	state.encoder.filter_strategy = getFilterStrategy(settings.rowFilter);
 
 	const uint8 *data = img.data;
 	uint16 *swappeddata = nullptr;
@@ -105,6 +105,42 @@ int w_newImageData(lua_State *L)
 
 int w_newCompressedData(lua_State *L)
 {
+	if (luax_istype(L, 1, ImageData::type))
+	{
+		ImageData *source = luax_checkimagedata(L, 1);
+
+		const char *fstr = luaL_checkstring(L, 2);
+		PixelFormat format = PIXELFORMAT_UNKNOWN;
+		if (!getConstant(fstr, format))
+			return luax_enumerror(L, "pixel format", fstr);
+
+		bool mipmaps = false;
+		std::string cachedir;
+
+		if (!lua_isnoneornil(L, 3))
+		{
+			luaL_checktype(L, 3, LUA_TTABLE);
+
+			mipmaps = luax_boolflag(L, 3, "mipmaps", false);
+
+			lua_getfield(L, 3, "cache");
+			if (lua_type(L, -1) == LUA_TSTRING)
+				cachedir = lua_tostring(L, -1);
+			else if (luax_toboolean(L, -1))
+				cachedir = "compressedimagecache";
+			lua_pop(L, 1);
+		}
+
+		CompressedImageData *t = nullptr;
+		luax_catchexcept(L, [&]() {
+			t = instance()->newCompressedData(source, format, mipmaps, cachedir.empty() ? nullptr : cachedir.c_str());
+		});
+
+		luax_pushtype(L, CompressedImageData::type, t);
+		t->release();
+		return 1;
+	}
+
 	Data *data = love::filesystem::luax_getdata(L, 1);
 
 	CompressedImageData *t = nullptr;
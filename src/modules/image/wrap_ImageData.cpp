@@ -53,6 +53,24 @@ int w_ImageData_clone(lua_State *L)
 	return 1;
 }
 
+int w_ImageData_convert(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	const char *fstr = luaL_checkstring(L, 2);
+	PixelFormat format = PIXELFORMAT_UNKNOWN;
+	if (!getConstant(fstr, format))
+		return luax_enumerror(L, "pixel format", fstr);
+
+	bool linear = luax_optboolean(L, 3, t->isLinear());
+
+	ImageData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->convert(format, linear); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
 int w_ImageData_getFormat(lua_State *L)
 {
 	ImageData *t = luax_checkimagedata(L, 1);
@@ -234,6 +252,63 @@ int w_ImageData_paste(lua_State *L)
 	return 0;
 }
 
+int w_ImageData_resize(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	int w = (int) luaL_checkinteger(L, 2);
+	int h = (int) luaL_checkinteger(L, 3);
+
+	ResizeFilter filter = RESIZE_FILTER_LINEAR;
+	if (!lua_isnoneornil(L, 4))
+	{
+		const char *fstr = luaL_checkstring(L, 4);
+		if (!ImageData::getConstant(fstr, filter))
+			return luax_enumerror(L, "resize filter", ImageData::getConstants(filter), fstr);
+	}
+
+	ImageData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->resize(w, h, filter); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_ImageData_premultiplyAlpha(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	luax_catchexcept(L, [&](){ t->premultiplyAlpha(); });
+	return 0;
+}
+
+int w_ImageData_gaussianBlur(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	float radius = (float) luaL_checknumber(L, 2);
+	luax_catchexcept(L, [&](){ t->gaussianBlur(radius); });
+	return 0;
+}
+
+int w_ImageData_flip(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	bool horizontal = luax_checkboolean(L, 2);
+	bool vertical = luax_optboolean(L, 3, false);
+	t->flip(horizontal, vertical);
+	return 0;
+}
+
+int w_ImageData_rotate90(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+	bool clockwise = luax_optboolean(L, 2, true);
+
+	ImageData *c = nullptr;
+	luax_catchexcept(L, [&](){ c = t->rotate90(clockwise); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
 int w_ImageData_encode(lua_State *L)
 {
 	ImageData *t = luax_checkimagedata(L, 1);
@@ -252,8 +327,34 @@ int w_ImageData_encode(lua_State *L)
 		filename = luax_checkstring(L, 3);
 	}
 
+	FormatHandler::EncodeSettings settings;
+
+	if (!lua_isnoneornil(L, 4))
+	{
+		luaL_checktype(L, 4, LUA_TTABLE);
+
+		lua_getfield(L, 4, "compression");
+		if (!lua_isnoneornil(L, -1))
+		{
+			int level = (int) luaL_checkinteger(L, -1);
+			if (level < 0 || level > 9)
+				return luaL_error(L, "Invalid compression level: %d (must be between 0 and 9)", level);
+			settings.compressionLevel = level;
+		}
+		lua_pop(L, 1);
+
+		lua_getfield(L, 4, "filter");
+		if (!lua_isnoneornil(L, -1))
+		{
+			const char *str = luaL_checkstring(L, -1);
+			if (!ImageData::getConstant(str, settings.rowFilter))
+				return luax_enumerror(L, "row filter", ImageData::getConstants(settings.rowFilter), str);
+		}
+		lua_pop(L, 1);
+	}
+
 	love::filesystem::FileData *filedata = nullptr;
-	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename); });
+	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename, settings); });
 
 	luax_pushtype(L, filedata);
 	filedata->release();
@@ -287,6 +388,7 @@ static FFI_ImageData ffifuncs =
 static const luaL_Reg w_ImageData_functions[] =
 {
 	{ "clone", w_ImageData_clone },
+	{ "convert", w_ImageData_convert },
 	{ "getFormat", w_ImageData_getFormat },
 	{ "setLinear", w_ImageData_setLinear },
 	{ "isLinear", w_ImageData_isLinear },
@@ -296,6 +398,11 @@ static const luaL_Reg w_ImageData_functions[] =
 	{ "getPixel", w_ImageData_getPixel },
 	{ "setPixel", w_ImageData_setPixel },
 	{ "paste", w_ImageData_paste },
+	{ "resize", w_ImageData_resize },
+	{ "premultiplyAlpha", w_ImageData_premultiplyAlpha },
+	{ "gaussianBlur", w_ImageData_gaussianBlur },
+	{ "flip", w_ImageData_flip },
+	{ "rotate90", w_ImageData_rotate90 },
 	{ "mapPixel", w_ImageData_mapPixel },
 	{ "encode", w_ImageData_encode },
 	{ 0, 0 }
@@ -73,6 +73,7 @@ typedef struct FFI_ImageData
 
 struct ImageData_Pixel_R8 { uint8_t r; };
 struct ImageData_Pixel_RG8 { uint8_t r, g; };
+struct ImageData_Pixel_LA8 { uint8_t l, a; };
 struct ImageData_Pixel_RGBA8 { uint8_t r, g, b, a; };
 
 struct ImageData_Pixel_R16 { uint16_t r; };
@@ -116,6 +117,17 @@ local conversions = {
 			self.g = (clamp01(g) * 255) + 0.5
 		end,
 	},
+	la8 = {
+		pointer = ffi.typeof("struct ImageData_Pixel_LA8 *"),
+		tolua = function(self)
+			local l = tonumber(self.l) / 255
+			return l, l, l, tonumber(self.a) / 255
+		end,
+		fromlua = function(self, r, g, b, a)
+			self.l = (clamp01(r) * 255) + 0.5
+			self.a = a == nil and 255 or (clamp01(a) * 255) + 0.5
+		end,
+	},
 	rgba8 = {
 		pointer = ffi.typeof("struct ImageData_Pixel_RGBA8 *"),
 		tolua = function(self)
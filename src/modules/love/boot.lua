@@ -226,6 +226,12 @@ function love.init()
 			mixwithsystem = true, -- Only relevant for Android / iOS.
 			mic = false, -- Only relevant for Android.
 		},
+		run = {
+			tickrate = 0, -- Fixed love.update rate in ticks per second. 0 uses a variable timestep.
+			maxticks = 8, -- Most fixed ticks per frame before love.run stops catching up.
+			framerate = 0, -- Frame rate cap. 0 means no cap beyond vsync.
+			spintime = 0.002, -- How early love.run stops sleeping and busy-waits for a capped frame.
+		},
 		console = false, -- Only relevant for windows.
 		identity = false,
 		appendidentity = false,
@@ -375,6 +381,9 @@ function love.init()
 		love.createhandlers()
 	end
 
+	-- Used by the default love.run.
+	love._runconf = type(c.run) == "table" and c.run or {}
+
 	-- Check the version
 	c.version = tostring(c.version)
 	if not love.isVersionCompatible(c.version) then
@@ -165,12 +165,34 @@ end
 -- Default callbacks.
 -----------------------------------------------------------
 
+-- Sleep until the given love.timer time. Sleeps can overshoot by a
+-- millisecond or more, so the last stretch is spent busy-waiting instead.
+local function waituntil(time, spintime)
+	local remaining = time - love.timer.getTime()
+	if remaining > spintime then
+		love.timer.sleep(remaining - spintime)
+	end
+	while love.timer.getTime() < time do end
+end
+
 function love.run()
 	if love.load then love.load(love.parsedGameArguments, love.rawGameArguments) end
 
 	-- We don't want the first frame's dt to include time taken by love.load.
 	if love.timer then love.timer.step() end
 
+	local conf = love._runconf or {}
+	local tickrate = love.timer and tonumber(conf.tickrate) or 0
+	local framerate = love.timer and tonumber(conf.framerate) or 0
+
+	local tickdt = tickrate > 0 and 1 / tickrate or nil
+	local maxticks = tonumber(conf.maxticks) or 8
+	local accumulator = 0
+
+	local framedt = framerate > 0 and 1 / framerate or nil
+	local spintime = tonumber(conf.spintime) or 0.002
+	local nextframe = love.timer and love.timer.getTime() or 0
+
 	-- Main loop time.
 	return function()
 		-- Process events.
@@ -189,19 +211,52 @@ function love.run()
 		-- Update dt, as we'll be passing it to update
 		local dt = love.timer and love.timer.step() or 0
 
-		-- Call update and draw
-		if love.update then love.update(dt) end -- will pass 0 if love.timer is disabled
+		-- Fraction of a tick that has yet to be simulated, for draw to
+		-- interpolate with. Only used with a fixed tick rate.
+		local alpha
+
+		if tickdt then
+			accumulator = accumulator + dt
+
+			local ticks = 0
+			while accumulator >= tickdt and ticks < maxticks do
+				if love.update then love.update(tickdt) end
+				accumulator = accumulator - tickdt
+				ticks = ticks + 1
+			end
+
+			-- Drop whatever we couldn't catch up on, rather than spiraling.
+			if accumulator >= tickdt then
+				accumulator = accumulator % tickdt
+			end
+
+			alpha = accumulator / tickdt
+		elseif love.update then
+			love.update(dt) -- will pass 0 if love.timer is disabled
+		end
 
 		if love.graphics and love.graphics.isActive() then
 			love.graphics.origin()
 			love.graphics.clear(love.graphics.getBackgroundColor())
 
-			if love.draw then love.draw() end
+			if love.draw then love.draw(alpha) end
 
 			love.graphics.present()
 		end
 
-		if love.timer then love.timer.sleep(0.001) end
+		if framedt then
+			nextframe = nextframe + framedt
+
+			-- Don't try to make up for frames that took too long.
+			local now = love.timer.getTime()
+			if nextframe < now then
+				nextframe = now
+			else
+				waituntil(nextframe, spintime)
+			end
+		elseif love.timer then
+			love.timer.sleep(0.001)
+		end
 	end
 end
 
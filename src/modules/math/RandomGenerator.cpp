@@ -27,6 +27,7 @@
 // C
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 
 namespace love
 {
@@ -47,6 +48,107 @@ static uint64 wangHash64(uint64 key)
 	return key;
 }
 
+// The xorshift state transition is linear over GF(2), so it can be written as
+// a 64x64 bit matrix. Each column is stored as the image of a single set bit.
+struct StateMatrix
+{
+	uint64 columns[64];
+
+	uint64 apply(uint64 v) const
+	{
+		uint64 r = 0;
+		for (int i = 0; v != 0; i++, v >>= 1)
+		{
+			if (v & 1)
+				r ^= columns[i];
+		}
+		return r;
+	}
+
+	StateMatrix squared() const
+	{
+		StateMatrix m;
+		for (int i = 0; i < 64; i++)
+			m.columns[i] = apply(columns[i]);
+		return m;
+	}
+};
+
+static uint64 xorshiftStep(uint64 s)
+{
+	s ^= (s >> 12);
+	s ^= (s << 25);
+	s ^= (s >> 27);
+	return s;
+}
+
+// jumpMatrices[i] advances the state by 2^(STREAM_JUMP_EXPONENT + i) steps.
+struct JumpMatrices
+{
+	StateMatrix matrices[64];
+
+	JumpMatrices()
+	{
+		StateMatrix m;
+		for (int i = 0; i < 64; i++)
+			m.columns[i] = xorshiftStep(1ULL << i);
+
+		for (int i = 0; i < RandomGenerator::STREAM_JUMP_EXPONENT; i++)
+			m = m.squared();
+
+		for (int i = 0; i < 64; i++)
+		{
+			matrices[i] = m;
+			m = m.squared();
+		}
+	}
+};
+
+static const JumpMatrices &getJumpMatrices()
+{
+	static const JumpMatrices jumpMatrices;
+	return jumpMatrices;
+}
+
+// Fill destinations can start at any byte offset, so values are copied in
+// rather than written through a typed pointer.
+template <typename T>
+static inline void storeFillValue(void *dst, size_t i, T value)
+{
+	memcpy((uint8 *) dst + i * sizeof(T), &value, sizeof(T));
+}
+
+template <typename T>
+static void fillUniformInteger(void *dst, RandomGenerator &rng, size_t count, double min, double max)
+{
+	const double tmin = (double) std::numeric_limits<T>::min();
+	const double tmax = (double) std::numeric_limits<T>::max();
+
+	double lo = std::floor(min);
+	double hi = std::floor(max);
+
+	if (!(lo <= hi))
+		throw love::Exception("Invalid random range: min (%g) must not be greater than max (%g).", min, max);
+
+	if (lo < tmin || hi > tmax)
+		throw love::Exception("Random range [%g, %g] does not fit in the fill format's range [%g, %g].", min, max, tmin, tmax);
+
+	double range = hi - lo + 1.0;
+
+	for (size_t i = 0; i < count; i++)
+		storeFillValue(dst, i, (T) std::min(std::floor(rng.random() * range) + lo, hi));
+}
+
+template <typename T>
+static void fillNormalInteger(void *dst, RandomGenerator &rng, size_t count, double stddev, double mean)
+{
+	const double lo = (double) std::numeric_limits<T>::min();
+	const double hi = (double) std::numeric_limits<T>::max();
+
+	for (size_t i = 0; i < count; i++)
+		storeFillValue(dst, i, (T) std::min(std::max(std::round(rng.randomNormal(stddev) + mean), lo), hi));
+}
+
 love::Type RandomGenerator::type("RandomGenerator", &Object::type);
 
 // 64 bit Xorshift implementation taken from the end of Sec. 3 (page 4) in
@@ -90,6 +192,98 @@ double RandomGenerator::randomNormal(double stddev)
 	return r * sin(phi) * stddev;
 }
 
+void RandomGenerator::fill(void *dst, size_t count, FillFormat format, double min, double max)
+{
+	switch (format)
+	{
+	case FILL_FLOAT:
+		for (size_t i = 0; i < count; i++)
+			storeFillValue(dst, i, (float) random(min, max));
+		break;
+	case FILL_DOUBLE:
+		for (size_t i = 0; i < count; i++)
+			storeFillValue(dst, i, random(min, max));
+		break;
+	case FILL_INT8:
+		fillUniformInteger<int8>(dst, *this, count, min, max);
+		break;
+	case FILL_UINT8:
+		fillUniformInteger<uint8>(dst, *this, count, min, max);
+		break;
+	case FILL_INT16:
+		fillUniformInteger<int16>(dst, *this, count, min, max);
+		break;
+	case FILL_UINT16:
+		fillUniformInteger<uint16>(dst, *this, count, min, max);
+		break;
+	case FILL_INT32:
+		fillUniformInteger<int32>(dst, *this, count, min, max);
+		break;
+	case FILL_UINT32:
+		fillUniformInteger<uint32>(dst, *this, count, min, max);
+		break;
+	default:
+		throw love::Exception("Invalid random fill format.");
+	}
+}
+
+void RandomGenerator::fillNormal(void *dst, size_t count, FillFormat format, double stddev, double mean)
+{
+	switch (format)
+	{
+	case FILL_FLOAT:
+		for (size_t i = 0; i < count; i++)
+			storeFillValue(dst, i, (float) (randomNormal(stddev) + mean));
+		break;
+	case FILL_DOUBLE:
+		for (size_t i = 0; i < count; i++)
+			storeFillValue(dst, i, randomNormal(stddev) + mean);
+		break;
+	case FILL_INT8:
+		fillNormalInteger<int8>(dst, *this, count, stddev, mean);
+		break;
+	case FILL_UINT8:
+		fillNormalInteger<uint8>(dst, *this, count, stddev, mean);
+		break;
+	case FILL_INT16:
+		fillNormalInteger<int16>(dst, *this, count, stddev, mean);
+		break;
+	case FILL_UINT16:
+		fillNormalInteger<uint16>(dst, *this, count, stddev, mean);
+		break;
+	case FILL_INT32:
+		fillNormalInteger<int32>(dst, *this, count, stddev, mean);
+		break;
+	case FILL_UINT32:
+		fillNormalInteger<uint32>(dst, *this, count, stddev, mean);
+		break;
+	default:
+		throw love::Exception("Invalid random fill format.");
+	}
+}
+
+void RandomGenerator::jump(uint64 count)
+{
+	const JumpMatrices &jumps = getJumpMatrices();
+
+	for (int i = 0; count != 0; i++, count >>= 1)
+	{
+		if (count & 1)
+			rng_state.b64 = jumps.matrices[i].apply(rng_state.b64);
+	}
+
+	last_randomnormal = std::numeric_limits<double>::infinity();
+}
+
+RandomGenerator *RandomGenerator::split(uint64 index) const
+{
+	RandomGenerator *rng = new RandomGenerator();
+	rng->seed = seed;
+	rng->rng_state = rng_state;
+	rng->jump(index);
+	return rng;
+}
+
 void RandomGenerator::setSeed(RandomGenerator::Seed newseed)
 {
 	seed = newseed;
@@ -145,5 +339,35 @@ std::string RandomGenerator::getState() const
 	return ss.str();
 }
 
+size_t RandomGenerator::getFillFormatSize(FillFormat format)
+{
+	switch (format)
+	{
+	case FILL_FLOAT: return sizeof(float);
+	case FILL_DOUBLE: return sizeof(double);
+	case FILL_INT8: return sizeof(int8);
+	case FILL_UINT8: return sizeof(uint8);
+	case FILL_INT16: return sizeof(int16);
+	case FILL_UINT16: return sizeof(uint16);
+	case FILL_INT32: return sizeof(int32);
+	case FILL_UINT32: return sizeof(uint32);
+	case FILL_MAX_ENUM: return 0;
+	}
+	return 0;
+}
+
+STRINGMAP_CLASS_BEGIN(RandomGenerator, RandomGenerator::FillFormat, RandomGenerator::FILL_MAX_ENUM, fillFormat)
+{
+	{ "float",  RandomGenerator::FILL_FLOAT  },
+	{ "double", RandomGenerator::FILL_DOUBLE },
+	{ "int8",   RandomGenerator::FILL_INT8   },
+	{ "uint8",  RandomGenerator::FILL_UINT8  },
+	{ "int16",  RandomGenerator::FILL_INT16  },
+	{ "uint16", RandomGenerator::FILL_UINT16 },
+	{ "int32",  RandomGenerator::FILL_INT32  },
+	{ "uint32", RandomGenerator::FILL_UINT32 },
+}
+STRINGMAP_CLASS_END(RandomGenerator, RandomGenerator::FillFormat, RandomGenerator::FILL_MAX_ENUM, fillFormat)
+
 } // math
 } // love
@@ -27,6 +27,7 @@
 #include "common/math.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/StringMap.h"
 
 // C++
 #include <limits>
@@ -58,6 +59,24 @@ class RandomGenerator : public Object
 		} b32;
 	};
 
+	// Value types which fill() and fillNormal() can write.
+	enum FillFormat
+	{
+		FILL_FLOAT,
+		FILL_DOUBLE,
+		FILL_INT8,
+		FILL_UINT8,
+		FILL_INT16,
+		FILL_UINT16,
+		FILL_INT32,
+		FILL_UINT32,
+		FILL_MAX_ENUM
+	};
+
+	// Number of rand() steps between consecutive streams created by split().
+	// Streams don't overlap unless more than 2^48 numbers are drawn from one.
+	static const int STREAM_JUMP_EXPONENT = 48;
+
 	RandomGenerator();
 	virtual ~RandomGenerator() {}
 
@@ -112,6 +131,36 @@ class RandomGenerator : public Object
 	 **/
 	double randomNormal(double stddev);
 
+	/**
+	 * Fills memory with uniformly distributed pseudo random values. The
+	 * generated sequence is identical to calling random() count times.
+	 * Integer formats use the inclusive range [min, max].
+	 *
+	 * @param dst Destination memory, tightly packed values of the given format.
+	 * @param count Number of values to write.
+	 **/
+	void fill(void *dst, size_t count, FillFormat format, double min, double max);
+
+	/**
+	 * Fills memory with normally distributed pseudo random values. Integer
+	 * formats are rounded and clamped to the range of the type.
+	 **/
+	void fillNormal(void *dst, size_t count, FillFormat format, double stddev, double mean);
+
+	/**
+	 * Advances the state as if rand() was called count * 2^STREAM_JUMP_EXPONENT
+	 * times, in O(log count) time.
+	 **/
+	void jump(uint64 count = 1);
+
+	/**
+	 * Creates a new generator whose sequence is independent from this one's,
+	 * by jumping ahead index streams from the current state. Calling split
+	 * with the same index on generators with the same state gives the same
+	 * result, so streams can be handed out to threads reproducibly.
+	 **/
+	RandomGenerator *split(uint64 index) const;
+
 	/**
 	 * Set pseudo-random seed.
 	 * It's up to the implementation how to use this.
@@ -134,6 +183,10 @@ class RandomGenerator : public Object
 	 **/
 	std::string getState() const;
 
+	static size_t getFillFormatSize(FillFormat format);
+
+	STRINGMAP_CLASS_DECLARE(FillFormat);
+
 private:
 
 	Seed seed;
@@ -69,12 +69,6 @@ class Transform : public Object
 	const Matrix4 &getMatrix() const;
 	void setMatrix(const Matrix4 &m);
 
-	static bool getConstant(const char *in, MatrixLayout &out);
-	static bool getConstant(MatrixLayout in, const char *&out);
-	static std::vector<std::string> getConstants(MatrixLayout);
-
-private:
-
 	inline const Matrix4 &getInverseMatrix()
 	{
 		if (inverseDirty)
@@ -85,7 +79,13 @@ class Transform : public Object
 
 		return inverseMatrix;
 	}
-	
+
+	static bool getConstant(const char *in, MatrixLayout &out);
+	static bool getConstant(MatrixLayout in, const char *&out);
+	static std::vector<std::string> getConstants(MatrixLayout);
+
+private:
+
 	Matrix4 matrix;
 	bool inverseDirty;
 	Matrix4 inverseMatrix;
@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_RandomGenerator.h"
+#include "data/wrap_Data.h"
 
 #include <cmath>
 #include <algorithm>
@@ -85,6 +86,116 @@ int w_RandomGenerator_randomNormal(lua_State *L)
 	return 1;
 }
 
+static void *checkfilldest(lua_State *L, int idx, RandomGenerator::FillFormat format, size_t &count)
+{
+	Data *data = data::luax_checkdata(L, idx);
+	size_t valuesize = RandomGenerator::getFillFormatSize(format);
+
+	int64 offset = (int64) luaL_optnumber(L, idx + 4, 0);
+	if (offset < 0 || offset > (int64) data->getSize())
+		luaL_error(L, "The given byte offset is out of range.");
+
+	size_t maxcount = (data->getSize() - (size_t) offset) / valuesize;
+	if (lua_isnoneornil(L, idx + 5))
+		count = maxcount;
+	else
+	{
+		int64 c = (int64) luaL_checknumber(L, idx + 5);
+		if (c < 0 || (size_t) c > maxcount)
+			luaL_error(L, "The given offset and value count don't fit within the Data's size.");
+		count = (size_t) c;
+	}
+
+	return (uint8 *) data->getData() + offset;
+}
+
+static RandomGenerator::FillFormat checkfillformat(lua_State *L, int idx)
+{
+	RandomGenerator::FillFormat format = RandomGenerator::FILL_FLOAT;
+	const char *str = lua_isnoneornil(L, idx) ? nullptr : luaL_checkstring(L, idx);
+	if (str != nullptr && !RandomGenerator::getConstant(str, format))
+		luax_enumerror(L, "random fill format", RandomGenerator::getConstants(format), str);
+	return format;
+}
+
+template <typename T>
+static void getfillrange(double &min, double &max)
+{
+	min = (double) std::numeric_limits<T>::min();
+	max = (double) std::numeric_limits<T>::max();
+}
+
+int w_RandomGenerator_fill(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	RandomGenerator::FillFormat format = checkfillformat(L, 3);
+
+	double min = 0.0;
+	double max = 1.0;
+
+	switch (format)
+	{
+	case RandomGenerator::FILL_INT8: getfillrange<int8>(min, max); break;
+	case RandomGenerator::FILL_UINT8: getfillrange<uint8>(min, max); break;
+	case RandomGenerator::FILL_INT16: getfillrange<int16>(min, max); break;
+	case RandomGenerator::FILL_UINT16: getfillrange<uint16>(min, max); break;
+	case RandomGenerator::FILL_INT32: getfillrange<int32>(min, max); break;
+	case RandomGenerator::FILL_UINT32: getfillrange<uint32>(min, max); break;
+	default: break;
+	}
+
+	min = luaL_optnumber(L, 4, min);
+	max = luaL_optnumber(L, 5, max);
+
+	size_t count = 0;
+	void *dst = checkfilldest(L, 2, format, count);
+
+	luax_catchexcept(L, [&](){ rng->fill(dst, count, format, min, max); });
+	lua_pushnumber(L, (lua_Number) count);
+	return 1;
+}
+
+int w_RandomGenerator_fillNormal(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	RandomGenerator::FillFormat format = checkfillformat(L, 3);
+
+	double stddev = luaL_optnumber(L, 4, 1.0);
+	double mean = luaL_optnumber(L, 5, 0.0);
+
+	size_t count = 0;
+	void *dst = checkfilldest(L, 2, format, count);
+
+	luax_catchexcept(L, [&](){ rng->fillNormal(dst, count, format, stddev, mean); });
+	lua_pushnumber(L, (lua_Number) count);
+	return 1;
+}
+
+int w_RandomGenerator_jump(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	double count = luaL_optnumber(L, 2, 1);
+	if (count < 0)
+		return luaL_argerror(L, 2, "jump count must not be negative");
+	rng->jump((uint64) count);
+	return 0;
+}
+
+int w_RandomGenerator_split(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	double index = luaL_checknumber(L, 2);
+	if (index < 0)
+		return luaL_argerror(L, 2, "stream index must not be negative");
+
+	RandomGenerator *stream = nullptr;
+	luax_catchexcept(L, [&](){ stream = rng->split((uint64) index); });
+
+	luax_pushtype(L, stream);
+	stream->release();
+	return 1;
+}
+
 int w_RandomGenerator_setSeed(lua_State *L)
 {
 	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
@@ -141,6 +252,10 @@ static const luaL_Reg w_RandomGenerator_functions[] =
 {
 	{ "_random", w_RandomGenerator__random }, // random() is defined in wrap_RandomGenerator.lua.
 	{ "randomNormal", w_RandomGenerator_randomNormal },
+	{ "fill", w_RandomGenerator_fill },
+	{ "fillNormal", w_RandomGenerator_fillNormal },
+	{ "jump", w_RandomGenerator_jump },
+	{ "split", w_RandomGenerator_split },
 	{ "setSeed", w_RandomGenerator_setSeed },
 	{ "getSeed", w_RandomGenerator_getSeed },
 	{ "setState", w_RandomGenerator_setState },
@@ -19,6 +19,10 @@
  **/
 
 #include "wrap_Transform.h"
+#include "data/wrap_Data.h"
+
+// C++
+#include <vector>
 
 namespace love
 {
@@ -293,6 +297,70 @@ int w_Transform_inverseTransformPoint(lua_State *L)
 	return 2;
 }
 
+int luax_transformpoints(lua_State *L, int idx, const Matrix4 &m)
+{
+	if (lua_istable(L, idx))
+	{
+		int ncoords = (int) luax_objlen(L, idx);
+		if (ncoords % 2 != 0)
+			return luaL_error(L, "Number of point coordinates must be a multiple of two.");
+
+		int npoints = ncoords / 2;
+		std::vector<Vector2> points(npoints);
+
+		for (int i = 0; i < npoints; i++)
+		{
+			lua_rawgeti(L, idx, i * 2 + 1);
+			lua_rawgeti(L, idx, i * 2 + 2);
+			points[i].x = (float) luaL_checknumber(L, -2);
+			points[i].y = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 2);
+		}
+
+		m.transformXY(points.data(), points.data(), npoints);
+
+		lua_createtable(L, ncoords, 0);
+		for (int i = 0; i < npoints; i++)
+		{
+			lua_pushnumber(L, points[i].x);
+			lua_rawseti(L, -2, i * 2 + 1);
+			lua_pushnumber(L, points[i].y);
+			lua_rawseti(L, -2, i * 2 + 2);
+		}
+
+		return 1;
+	}
+
+	Data *data = data::luax_checkdata(L, idx);
+	int64 offset = (int64) luaL_optnumber(L, idx + 1, 0);
+
+	if (offset < 0 || offset > (int64) data->getSize())
+		return luaL_error(L, "The given byte offset is out of range.");
+
+	int64 maxpoints = (int64) ((data->getSize() - (size_t) offset) / sizeof(Vector2));
+	int64 npoints = (int64) luaL_optnumber(L, idx + 2, (lua_Number) maxpoints);
+
+	if (npoints < 0 || npoints > maxpoints || npoints > std::numeric_limits<int>::max())
+		return luaL_error(L, "The given offset and point count don't fit within the Data's size.");
+
+	Vector2 *points = (Vector2 *) ((uint8 *) data->getData() + offset);
+	m.transformXY(points, points, (int) npoints);
+
+	return 0;
+}
+
+int w_Transform_transformPoints(lua_State *L)
+{
+	Transform *t = luax_checktransform(L, 1);
+	return luax_transformpoints(L, 2, t->getMatrix());
+}
+
+int w_Transform_inverseTransformPoints(lua_State *L)
+{
+	Transform *t = luax_checktransform(L, 1);
+	return luax_transformpoints(L, 2, t->getInverseMatrix());
+}
+
 int w_Transform__mul(lua_State *L)
 {
 	Transform *t1 = luax_checktransform(L, 1);
@@ -320,6 +388,8 @@ static const luaL_Reg functions[] =
 	{ "getMatrix", w_Transform_getMatrix },
 	{ "transformPoint", w_Transform_transformPoint },
 	{ "inverseTransformPoint", w_Transform_inverseTransformPoint },
+	{ "transformPoints", w_Transform_transformPoints },
+	{ "inverseTransformPoints", w_Transform_inverseTransformPoints },
 	{ "__mul", w_Transform__mul },
 	{ 0, 0 }
 };
@@ -31,6 +31,14 @@ namespace math
 
 Transform *luax_checktransform(lua_State *L, int idx);
 void luax_checkmatrix(lua_State *L, int idx, Transform::MatrixLayout layout, float elements[16]);
+
+/**
+ * Transforms a batch of 2D points by the given matrix. Accepts either a flat
+ * table of coordinates (returning a new table), or a Data object containing
+ * packed pairs of floats followed by an optional byte offset and point count
+ * (transformed in-place).
+ **/
+int luax_transformpoints(lua_State *L, int idx, const Matrix4 &m);
 extern "C" int luaopen_transform(lua_State *L);
 
 } // math
@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "ThreadPool.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace love
+{
+namespace thread
+{
+
+ThreadPool::Worker::Worker(ThreadPool *pool, const std::string &name)
+	: pool(pool)
+{
+	threadName = name;
+}
+
+void ThreadPool::Worker::threadFunction()
+{
+	Task task;
+	while (pool->popTask(task))
+	{
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			// An exception escaping the thread would terminate the program.
+		}
+
+		task = nullptr;
+	}
+}
+
+ThreadPool::ThreadPool(int threadCount, const std::string &name)
+	: submitted(0)
+	, stopping(false)
+{
+	for (int i = 0; i < threadCount; i++)
+	{
+		Worker *worker = new Worker(this, name);
+		if (!worker->start())
+		{
+			worker->release();
+			break;
+		}
+		workers.push_back(worker);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		Lock lock(mutex);
+		stopping = true;
+		cond->broadcast();
+	}
+
+	for (Worker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+void ThreadPool::submit(const Task &task, int priority)
+{
+	if (workers.empty())
+	{
+		task();
+		return;
+	}
+
+	Lock lock(mutex);
+	tasks.push({task, priority, submitted++});
+	cond->signal();
+}
+
+bool ThreadPool::popTask(Task &task)
+{
+	Lock lock(mutex);
+
+	while (!stopping && tasks.empty())
+		cond->wait(mutex);
+
+	if (stopping)
+		return false;
+
+	task = tasks.top().task;
+	tasks.pop();
+	return true;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, const RangeTask &func)
+{
+	chunkSize = std::max(chunkSize, (size_t) 1);
+	size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	if (chunkCount <= 1 || workers.empty())
+	{
+		if (count > 0)
+			func(0, count);
+		return;
+	}
+
+	struct State
+	{
+		const RangeTask *func;
+		size_t count;
+		size_t chunkSize;
+		size_t chunkCount;
+		std::atomic<size_t> nextChunk;
+		std::atomic<size_t> finishedChunks;
+		MutexRef mutex;
+		ConditionalRef cond;
+		std::string error;
+	};
+
+	auto state = std::make_shared<State>();
+	state->func = &func;
+	state->count = count;
+	state->chunkSize = chunkSize;
+	state->chunkCount = chunkCount;
+	state->nextChunk = 0;
+	state->finishedChunks = 0;
+
+	// Helpers which start after every chunk has been claimed return without
+	// touching func, so it only needs to outlive this call.
+	auto runChunks = [](State *s)
+	{
+		while (true)
+		{
+			size_t chunk = s->nextChunk++;
+			if (chunk >= s->chunkCount)
+				break;
+
+			size_t begin = chunk * s->chunkSize;
+			size_t end = std::min(begin + s->chunkSize, s->count);
+
+			try
+			{
+				(*s->func)(begin, end);
+			}
+			catch (std::exception &e)
+			{
+				Lock lock(s->mutex);
+				if (s->error.empty())
+					s->error = e.what();
+			}
+			catch (...)
+			{
+				Lock lock(s->mutex);
+				if (s->error.empty())
+					s->error = "Unknown error in a parallel task.";
+			}
+
+			if (++s->finishedChunks == s->chunkCount)
+			{
+				Lock lock(s->mutex);
+				s->cond->broadcast();
+			}
+		}
+	};
+
+	size_t helpers = std::min(workers.size(), chunkCount - 1);
+	for (size_t i = 0; i < helpers; i++)
+		submit([state, runChunks]() { runChunks(state.get()); }, std::numeric_limits<int>::max());
+
+	runChunks(state.get());
+
+	Lock lock(state->mutex);
+	while (state->finishedChunks < chunkCount)
+		state->cond->wait(state->mutex);
+
+	if (!state->error.empty())
+		throw love::Exception("%s", state->error.c_str());
+}
+
+int ThreadPool::getThreadCount() const
+{
+	return (int) workers.size();
+}
+
+ThreadPool &ThreadPool::getShared()
+{
+	// Intentionally never destroyed, so worker threads don't have to be torn
+	// down during static destruction at exit.
+	static ThreadPool *pool = new ThreadPool(std::max((int) std::thread::hardware_concurrency() - 1, 1), "LoveWorker");
+	return *pool;
+}
+
+} // thread
+} // love
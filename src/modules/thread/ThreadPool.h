@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "threads.h"
+
+// C++
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace love
+{
+namespace thread
+{
+
+/**
+ * A fixed set of worker threads which run queued tasks in priority order.
+ **/
+class ThreadPool
+{
+public:
+
+	typedef std::function<void()> Task;
+	typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+	ThreadPool(int threadCount, const std::string &name);
+	~ThreadPool();
+
+	/**
+	 * Queues a task to be run on one of the worker threads. Tasks with a
+	 * higher priority are started first. Tasks with the same priority are
+	 * started in the order they were submitted. Exceptions thrown by a task
+	 * are discarded, so tasks should report errors themselves.
+	 **/
+	void submit(const Task &task, int priority = 0);
+
+	/**
+	 * Splits the range [0, count) into chunks of at most chunkSize elements
+	 * and calls func for each chunk on the worker threads. Returns once every
+	 * chunk has completed. The calling thread runs chunks as well, so this can
+	 * safely be used from inside a task. If a chunk throws an exception, the
+	 * first error is re-thrown on the calling thread.
+	 **/
+	void parallelFor(size_t count, size_t chunkSize, const RangeTask &func);
+
+	int getThreadCount() const;
+
+	/**
+	 * Gets the pool shared by LOVE's internal systems. It has one worker per
+	 * logical CPU core, minus one for the calling thread.
+	 **/
+	static ThreadPool &getShared();
+
+private:
+
+	class Worker : public Threadable
+	{
+	public:
+
+		Worker(ThreadPool *pool, const std::string &name);
+		void threadFunction() override;
+
+	private:
+
+		ThreadPool *pool;
+	};
+
+	struct QueuedTask
+	{
+		Task task;
+		int priority;
+		uint64 order;
+
+		bool operator < (const QueuedTask &other) const
+		{
+			if (priority != other.priority)
+				return priority < other.priority;
+			return order > other.order;
+		}
+	};
+
+	bool popTask(Task &task);
+
+	std::vector<Worker *> workers;
+	std::priority_queue<QueuedTask> tasks;
+
+	MutexRef mutex;
+	ConditionalRef cond;
+
+	uint64 submitted;
+	bool stopping;
+
+}; // ThreadPool
+
+} // thread
+} // love
@@ -40,8 +40,11 @@ class Video : public Module
 
 	/**
 	 * Create a VideoStream representing video frames
+	 * @param bufferFrames The number of frames to decode ahead of playback.
+	 * @param cacheKeyframes Whether to cache the video's keyframe index in the
+	 *        save directory.
 	 **/
-	virtual VideoStream *newVideoStream(love::filesystem::File *file) = 0;
+	virtual VideoStream *newVideoStream(love::filesystem::File *file, int bufferFrames, bool cacheKeyframes) = 0;
 
 protected:
 
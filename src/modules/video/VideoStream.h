@@ -37,6 +37,9 @@ class VideoStream : public love::Object
 
 	static love::Type type;
 
+	// The default number of frames decoded ahead of the one being displayed.
+	static const int DEFAULT_BUFFER_FRAMES = 4;
+
 	virtual ~VideoStream() {}
 
 	/**
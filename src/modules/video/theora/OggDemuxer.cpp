@@ -18,7 +18,13 @@
  * 3. This notice may not be removed or altered from any source distribution.
  **/
 
+// STL
+#include <algorithm>
+#include <string.h>
+
+// LOVE
 #include "OggDemuxer.h"
+#include "filesystem/Filesystem.h"
 
 namespace love
 {
@@ -32,15 +38,25 @@ OggDemuxer::OggDemuxer(love::filesystem::File *file)
 	, streamInited(false)
 	, videoSerial(0)
 	, eos(false)
+	, indexComplete(false)
+	, indexStreamInited(false)
+	, indexReadOffset(0)
+	, indexPageOffset(0)
+	, indexLastPageOffset(0)
+	, indexLastPagePackets(0)
 {
 	ogg_sync_init(&sync);
+	ogg_sync_init(&indexSync);
 }
 
 OggDemuxer::~OggDemuxer()
 {
 	if (streamInited)
 		ogg_stream_clear(&stream);
+	if (indexStreamInited)
+		ogg_stream_clear(&indexStream);
 	ogg_sync_clear(&sync);
+	ogg_sync_clear(&indexSync);
 }
 
 bool OggDemuxer::readPage(bool erroreof)
@@ -147,6 +163,7 @@ OggDemuxer::StreamType OggDemuxer::findStream()
 		switch(type)
 		{
 		case TYPE_THEORA:
+			resetKeyframeIndex();
 			return type;
 		default:
 			break;
@@ -264,6 +281,272 @@ bool OggDemuxer::seek(ogg_packet &packet, double target, std::function<double(in
 	return true;
 }
 
+void OggDemuxer::resetKeyframeIndex()
+{
+	keyframes.clear();
+	indexComplete = false;
+
+	if (indexStreamInited)
+		ogg_stream_clear(&indexStream);
+	indexStreamInited = false;
+
+	ogg_sync_reset(&indexSync);
+	indexReadOffset = indexPageOffset = indexLastPageOffset = 0;
+	indexLastPagePackets = 0;
+}
+
+void OggDemuxer::indexPage(ogg_page &indexedPage, int64 pageOffset, int granuleShift)
+{
+	ogg_stream_pagein(&indexStream, &indexedPage);
+
+	// Collect the data packets which end on this page. Only the last one has
+	// a known granule position, the others are counted back from it. Header
+	// packets never share a page with data packets, but still count towards
+	// the packets read after seeking here.
+	indexPacketKeyframes.clear();
+	int64 headerPackets = 0;
+
+	ogg_packet packet;
+	int result;
+	while ((result = ogg_stream_packetout(&indexStream, &packet)) != 0)
+	{
+		// A gap in the data.
+		if (result < 0)
+			continue;
+
+		if (packet.bytes > 0 && (packet.packet[0] & 0x80) != 0)
+		{
+			headerPackets++;
+			continue;
+		}
+
+		// See https://www.theora.org/doc/Theora.pdf section 7.1. Empty packets
+		// are duplicated frames.
+		indexPacketKeyframes.push_back(packet.bytes > 0 && (packet.packet[0] & 0x40) == 0);
+	}
+
+	int64 count = (int64) indexPacketKeyframes.size();
+	if (headerPackets + count == 0)
+		return;
+
+	// When reading starts at this page, a packet continued from earlier pages
+	// is dropped, so the first packet read is the one after it.
+	int64 continued = ogg_page_continued(&indexedPage) ? 1 : 0;
+
+	int64 granulepos = ogg_page_granulepos(&indexedPage);
+	if (granulepos >= 0 && count > 0)
+	{
+		int64 lastFrame = (granulepos >> granuleShift) + (granulepos & ((int64(1) << granuleShift) - 1));
+
+		for (int64 i = 0; i < count; i++)
+		{
+			if (!indexPacketKeyframes[i])
+				continue;
+
+			int64 frame = lastFrame - (count - 1 - i);
+			int64 position = headerPackets + i;
+
+			Keyframe keyframe = {frame << granuleShift, pageOffset, position - continued};
+
+			// A packet continued from earlier pages started after the packets
+			// completed by the last page which completed any.
+			if (position < continued)
+			{
+				keyframe.offset = indexLastPageOffset;
+				keyframe.skip = indexLastPagePackets;
+			}
+
+			keyframes.push_back(keyframe);
+		}
+	}
+
+	indexLastPageOffset = pageOffset;
+	indexLastPagePackets = headerPackets + count - continued;
+}
+
+bool OggDemuxer::buildKeyframeIndex(int granuleShift, int64 maxBytes)
+{
+	if (indexComplete || !streamInited)
+		return indexComplete;
+
+	if (!indexStreamInited)
+	{
+		ogg_stream_init(&indexStream, videoSerial);
+		indexStreamInited = true;
+	}
+
+	int64 resumePosition = file->tell();
+	file->seek(indexReadOffset);
+
+	int64 scanned = 0;
+	bool done = false;
+
+	while (!done && scanned < maxBytes)
+	{
+		ogg_page indexedPage;
+		long result = ogg_sync_pageseek(&indexSync, &indexedPage);
+
+		if (result < 0)
+		{
+			// Skipped bytes which weren't part of a page.
+			indexPageOffset -= result;
+		}
+		else if (result == 0)
+		{
+			char *syncBuffer = ogg_sync_buffer(&indexSync, 8192);
+			int64 read = file->read(syncBuffer, 8192);
+			if (read <= 0)
+			{
+				done = true;
+				break;
+			}
+
+			ogg_sync_wrote(&indexSync, (long) read);
+			indexReadOffset += read;
+			scanned += read;
+		}
+		else
+		{
+			int64 pageOffset = indexPageOffset;
+			indexPageOffset += result;
+
+			if (ogg_page_serialno(&indexedPage) != videoSerial)
+				continue;
+
+			indexPage(indexedPage, pageOffset, granuleShift);
+
+			if (ogg_page_eos(&indexedPage))
+				done = true;
+		}
+	}
+
+	file->seek(resumePosition);
+
+	if (done)
+	{
+		indexComplete = true;
+
+		ogg_stream_clear(&indexStream);
+		indexStreamInited = false;
+		ogg_sync_reset(&indexSync);
+	}
+
+	return indexComplete;
+}
+
+bool OggDemuxer::isKeyframeIndexComplete() const
+{
+	return indexComplete;
+}
+
+bool OggDemuxer::seekKeyframe(ogg_packet &packet, double target, std::function<double(int64)> getTime)
+{
+	auto it = std::upper_bound(keyframes.begin(), keyframes.end(), target, [&](double time, const Keyframe &keyframe) {
+		return time < getTime(keyframe.granulepos);
+	});
+
+	// A later keyframe might not have been indexed yet.
+	if (it == keyframes.begin() || (it == keyframes.end() && !indexComplete))
+		return false;
+
+	const Keyframe &keyframe = *(it - 1);
+
+	eos = false;
+	file->seek(keyframe.offset);
+	resync();
+
+	readPage();
+	if (ogg_page_serialno(&page) == videoSerial)
+		ogg_stream_pagein(&stream, &page);
+
+	// Skip the packets in the first pages which precede the keyframe.
+	for (int64 i = 0; i <= keyframe.skip; i++)
+	{
+		if (readPacket(packet))
+			return false;
+	}
+
+	// The file doesn't match the index.
+	if (packet.bytes == 0 || (packet.packet[0] & 0xC0) != 0)
+		return false;
+
+	packet.granulepos = keyframe.granulepos;
+	return true;
+}
+
+// Cache files start with this header, followed by the keyframes.
+struct KeyframeIndexHeader
+{
+	char magic[8];
+	uint32 version;
+	uint32 serial;
+	int64 fileSize;
+	uint32 granuleShift;
+	uint32 count;
+};
+
+static const char keyframeIndexMagic[8] = {'L', 'O', 'V', 'E', 'O', 'G', 'G', 'K'};
+static const uint32 keyframeIndexVersion = 2;
+
+bool OggDemuxer::loadKeyframeIndex(const std::string &filename, int granuleShift)
+{
+	auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr || !fs->exists(filename.c_str()))
+		return false;
+
+	StrongRef<filesystem::FileData> data;
+
+	try
+	{
+		data.set(fs->read(filename.c_str()), Acquire::NORETAIN);
+	}
+	catch (love::Exception &)
+	{
+		return false;
+	}
+
+	KeyframeIndexHeader header;
+	if (data->getSize() < sizeof(header))
+		return false;
+
+	memcpy(&header, data->getData(), sizeof(header));
+
+	// The cache is stale if the video has changed.
+	if (memcmp(header.magic, keyframeIndexMagic, sizeof(header.magic)) != 0
+		|| header.version != keyframeIndexVersion
+		|| header.serial != (uint32) videoSerial
+		|| header.fileSize != file->getSize()
+		|| header.granuleShift != (uint32) granuleShift
+		|| data->getSize() != sizeof(header) + header.count * sizeof(Keyframe))
+		return false;
+
+	keyframes.resize(header.count);
+	memcpy(keyframes.data(), (const uint8 *) data->getData() + sizeof(header), header.count * sizeof(Keyframe));
+
+	indexComplete = true;
+	return true;
+}
+
+bool OggDemuxer::getKeyframeIndexData(int granuleShift, std::vector<uint8> &data) const
+{
+	if (!indexComplete)
+		return false;
+
+	KeyframeIndexHeader header;
+	memcpy(header.magic, keyframeIndexMagic, sizeof(header.magic));
+	header.version = keyframeIndexVersion;
+	header.serial = (uint32) videoSerial;
+	header.fileSize = file->getSize();
+	header.granuleShift = (uint32) granuleShift;
+	header.count = (uint32) keyframes.size();
+
+	data.resize(sizeof(header) + keyframes.size() * sizeof(Keyframe));
+	memcpy(data.data(), &header, sizeof(header));
+	memcpy(data.data() + sizeof(header), keyframes.data(), keyframes.size() * sizeof(Keyframe));
+
+	return true;
+}
+
 } // theora
 } // video
 } // love
@@ -23,6 +23,8 @@
 
 // STL
 #include <functional>
+#include <string>
+#include <vector>
 
 // LOVE
 #include "filesystem/File.h"
@@ -56,7 +58,40 @@ class OggDemuxer
 	const std::string &getFilename() const;
 	bool seek(ogg_packet &packet, double target, std::function<double(int64)> getTime);
 
+	/**
+	 * Scans up to maxBytes more of the file for Theora keyframes, in between
+	 * regular reads. Returns true once the whole file has been indexed.
+	 **/
+	bool buildKeyframeIndex(int granuleShift, int64 maxBytes);
+	bool isKeyframeIndexComplete() const;
+
+	/**
+	 * Jumps straight to the last keyframe at or before the target time, using
+	 * the keyframe index. Returns false if the index can't be used for the
+	 * target yet, in which case seek should be used instead.
+	 **/
+	bool seekKeyframe(ogg_packet &packet, double target, std::function<double(int64)> getTime);
+
+	// Keyframe index caches, stored next to the video in the save directory.
+	// The cache contents can be created on any thread, but are written by
+	// the caller.
+	bool loadKeyframeIndex(const std::string &filename, int granuleShift);
+	bool getKeyframeIndexData(int granuleShift, std::vector<uint8> &data) const;
+
 private:
+
+	struct Keyframe
+	{
+		int64 granulepos;
+
+		// Offset of the page the keyframe's packet starts in, or an earlier
+		// one.
+		int64 offset;
+
+		// The number of packets read from that page onwards before the
+		// keyframe's packet.
+		int64 skip;
+	};
 	StrongRef<love::filesystem::File> file;
 
 	ogg_sync_state sync;
@@ -67,8 +102,24 @@ class OggDemuxer
 	int videoSerial;
 	bool eos;
 
+	std::vector<Keyframe> keyframes;
+	bool indexComplete;
+
+	// The index is built with its own sync state, so it doesn't disturb the
+	// regular reads.
+	ogg_sync_state indexSync;
+	ogg_stream_state indexStream;
+	bool indexStreamInited;
+	int64 indexReadOffset;
+	int64 indexPageOffset;
+	int64 indexLastPageOffset;
+	int64 indexLastPagePackets;
+	std::vector<bool> indexPacketKeyframes;
+
 	bool readPage(bool erroreof = false);
 	StreamType determineType();
+	void resetKeyframeIndex();
+	void indexPage(ogg_page &indexedPage, int64 pageOffset, int granuleShift);
 }; // OggDemuxer
 
 } // theora
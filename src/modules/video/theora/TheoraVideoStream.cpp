@@ -20,9 +20,12 @@
 
 // STL
 #include <iostream>
+#include <algorithm>
+#include <string.h>
 
 // LOVE
 #include "TheoraVideoStream.h"
+#include "filesystem/Filesystem.h"
 
 using love::filesystem::File;
 
@@ -33,11 +36,15 @@ namespace video
 namespace theora
 {
 
-TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
+TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file, int bufferFrames, bool cacheKeyframes)
 	: demuxer(file)
 	, headerParsed(false)
 	, decoder(nullptr)
-	, frameReady(false)
+	, bufferFrames(std::max(bufferFrames, 1))
+	, frameDuration(0)
+	, cacheKeyframes(cacheKeyframes)
+	, frontBuffer(nullptr)
+	, frontTime(-1)
 	, lastFrame(0)
 	, nextFrame(0)
 {
@@ -46,8 +53,8 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 
 	th_info_init(&videoInfo);
 
-	frontBuffer = new Frame();
-	backBuffer = new Frame();
+	for (int i = 0; i < this->bufferFrames + 1; i++)
+		frames.push_back(new Frame());
 
 	try
 	{
@@ -55,12 +62,19 @@ TheoraVideoStream::TheoraVideoStream(love::filesystem::File *file)
 	}
 	catch (love::Exception &ex)
 	{
-		delete backBuffer;
-		delete frontBuffer;
+		for (Frame *frame : frames)
+			delete frame;
 		th_info_clear(&videoInfo);
 		throw ex;
 	}
 
+	frontBuffer = frames[0];
+	freeFrames.assign(frames.begin() + 1, frames.end());
+
+	// Otherwise the index is built while the video plays.
+	if (cacheKeyframes)
+		demuxer.loadKeyframeIndex(getKeyframeIndexFilename(), videoInfo.keyframe_granule_shift);
+
 	frameSync.set(new DeltaSync(), Acquire::NORETAIN);
 }
 
@@ -71,8 +85,8 @@ TheoraVideoStream::~TheoraVideoStream()
 
 	th_info_clear(&videoInfo);
 
-	delete frontBuffer;
-	delete backBuffer;
+	for (Frame *frame : frames)
+		delete frame;
 }
 
 int TheoraVideoStream::getWidth() const
@@ -162,27 +176,28 @@ void TheoraVideoStream::parseHeader()
 	decoder = th_decode_alloc(&videoInfo, setupInfo);
 	th_setup_free(setupInfo);
 
-	Frame *buffers[2] = {backBuffer, frontBuffer};
+	if (videoInfo.fps_numerator > 0 && videoInfo.fps_denominator > 0)
+		frameDuration = (double) videoInfo.fps_denominator / (double) videoInfo.fps_numerator;
 
 	yPlaneXOffset = cPlaneXOffset = videoInfo.pic_x;
 	yPlaneYOffset = cPlaneYOffset = videoInfo.pic_y;
 
 	scaleFormat(videoInfo.pixel_fmt, cPlaneXOffset, cPlaneYOffset);
 
-	for (int i = 0; i < 2; i++)
+	for (Frame *frame : frames)
 	{
-		buffers[i]->cw = buffers[i]->yw = videoInfo.pic_width;
-		buffers[i]->ch = buffers[i]->yh = videoInfo.pic_height;
+		frame->cw = frame->yw = videoInfo.pic_width;
+		frame->ch = frame->yh = videoInfo.pic_height;
 
-		scaleFormat(videoInfo.pixel_fmt, buffers[i]->cw, buffers[i]->ch);
+		scaleFormat(videoInfo.pixel_fmt, frame->cw, frame->ch);
 
-		buffers[i]->yplane = new unsigned char[buffers[i]->yw * buffers[i]->yh];
-		buffers[i]->cbplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
-		buffers[i]->crplane = new unsigned char[buffers[i]->cw * buffers[i]->ch];
+		frame->yplane = new unsigned char[frame->yw * frame->yh];
+		frame->cbplane = new unsigned char[frame->cw * frame->ch];
+		frame->crplane = new unsigned char[frame->cw * frame->ch];
 
-		memset(buffers[i]->yplane, 16, buffers[i]->yw * buffers[i]->yh);
-		memset(buffers[i]->cbplane, 128, buffers[i]->cw * buffers[i]->ch);
-		memset(buffers[i]->crplane, 128, buffers[i]->cw * buffers[i]->ch);
+		memset(frame->yplane, 16, frame->yw * frame->yh);
+		memset(frame->cbplane, 128, frame->cw * frame->ch);
+		memset(frame->crplane, 128, frame->cw * frame->ch);
 	}
 
 	headerParsed = true;
@@ -191,9 +206,25 @@ void TheoraVideoStream::parseHeader()
 
 void TheoraVideoStream::seekDecoder(double target)
 {
-	bool success = demuxer.seek(packet, target, [this](int64 granulepos) {
+	auto getTime = [this](int64 granulepos) {
 		return th_granule_time(decoder, granulepos);
-	});
+	};
+
+	if (demuxer.seekKeyframe(packet, target, getTime))
+	{
+		// Decode the keyframe right away, so every frame from here on is
+		// exact.
+		ogg_int64_t decoderPosition;
+		th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
+		if (th_decode_packetin(decoder, &packet, &decoderPosition) == 0)
+		{
+			lastFrame = -1;
+			nextFrame = th_granule_time(decoder, decoderPosition);
+			return;
+		}
+	}
+
+	bool success = demuxer.seek(packet, target, getTime);
 
 	if (!success)
 		return;
@@ -203,34 +234,115 @@ void TheoraVideoStream::seekDecoder(double target)
 	th_decode_ctl(decoder, TH_DECCTL_SET_GRANPOS, &packet.granulepos, sizeof(packet.granulepos));
 }
 
+void TheoraVideoStream::flushQueuedFrames()
+{
+	love::thread::Lock l(bufferMutex);
+
+	for (const QueuedFrame &queued : queuedFrames)
+		freeFrames.push_back(queued.frame);
+	queuedFrames.clear();
+}
+
+static void copyPlane(unsigned char *dst, int w, int h, const th_img_plane &src, unsigned int xoffset, unsigned int yoffset)
+{
+	const unsigned char *srcrow = src.data + src.stride * (int) yoffset + xoffset;
+
+	if (src.stride == w)
+	{
+		memcpy(dst, srcrow, (size_t) w * h);
+		return;
+	}
+
+	for (int y = 0; y < h; y++)
+		memcpy(dst + (size_t) w * y, srcrow + (ptrdiff_t) src.stride * y, w);
+}
+
+void TheoraVideoStream::copyFrame(const th_ycbcr_buffer &bufferinfo, Frame *frame) const
+{
+	copyPlane(frame->yplane, frame->yw, frame->yh, bufferinfo[0], yPlaneXOffset, yPlaneYOffset);
+	copyPlane(frame->cbplane, frame->cw, frame->ch, bufferinfo[1], cPlaneXOffset, cPlaneYOffset);
+	copyPlane(frame->crplane, frame->cw, frame->ch, bufferinfo[2], cPlaneXOffset, cPlaneYOffset);
+}
+
 void TheoraVideoStream::threadedFillBackBuffer(double dt)
 {
 	// Synchronize
 	frameSync->update(dt);
 	double position = frameSync->getPosition();
 
-	// Seeking backwards
-	if (position < lastFrame)
-		seekDecoder(position);
+	bool seekBackwards = false;
+	{
+		love::thread::Lock l(bufferMutex);
 
-	th_ycbcr_buffer bufferinfo;
-	bool hasFrame = false;
+		// Seeking backwards. The front buffer's time is forgotten so the
+		// frame on screen until the next swap doesn't cause another seek.
+		if (frontTime >= 0 && position < frontTime)
+		{
+			seekBackwards = true;
+			frontTime = -1;
+		}
+	}
+
+	if (seekBackwards)
+	{
+		flushQueuedFrames();
+		seekDecoder(position);
+	}
 
-	// Until we are at the end of the stream, or we are displaying the right frame
 	unsigned int framesBehind = 0;
-	bool failedSeek = false;
-	while (!demuxer.isEos() && position >= nextFrame)
+
+	// Decoding forwards after a seek is never slower than seeking again.
+	bool didSeek = seekBackwards;
+
+	while (!demuxer.isEos())
 	{
-		// If we can't catch up, seek
-		if (framesBehind++ > 5 && !failedSeek)
+		double frameTime = nextFrame;
+
+		// Frames which will be replaced by a later frame before they could be
+		// displayed are decoded but never copied out of the decoder.
+		bool late = frameDuration > 0 && frameTime + frameDuration <= position;
+
+		if (late)
 		{
-			seekDecoder(position);
-			framesBehind = 0;
-			failedSeek = true;
+			// If we can't catch up, seek
+			if (framesBehind++ > 5 && !didSeek)
+			{
+				flushQueuedFrames();
+				seekDecoder(position);
+				framesBehind = 0;
+				didSeek = true;
+				continue;
+			}
 		}
+		else
+		{
+			Frame *frame = nullptr;
+			{
+				love::thread::Lock l(bufferMutex);
+				if (!freeFrames.empty())
+				{
+					frame = freeFrames.back();
+					freeFrames.pop_back();
+				}
+			}
+
+			// Every buffer is full, so spend the spare time indexing.
+			if (frame == nullptr)
+			{
+				buildKeyframeIndex();
+				break;
+			}
+
+			th_ycbcr_buffer bufferinfo;
+			th_decode_ycbcr_out(decoder, bufferinfo);
+
+			// The copy happens outside the lock, so swapping buffers on the
+			// main thread never waits for it.
+			copyFrame(bufferinfo, frame);
 
-		th_decode_ycbcr_out(decoder, bufferinfo);
-		hasFrame = true;
+			love::thread::Lock l(bufferMutex);
+			queuedFrames.push_back({frame, frameTime});
+		}
 
 		ogg_int64_t decoderPosition;
 		do
@@ -245,45 +357,58 @@ void TheoraVideoStream::threadedFillBackBuffer(double dt)
 		lastFrame = nextFrame;
 		nextFrame = th_granule_time(decoder, decoderPosition);
 	}
+}
 
-	// Only swap once, even if we read many frames to get here
-	if (hasFrame)
+std::string TheoraVideoStream::getKeyframeIndexFilename() const
+{
+	return getFilename() + ".keyframes";
+}
+
+void TheoraVideoStream::buildKeyframeIndex()
+{
+	if (demuxer.isKeyframeIndexComplete())
+		return;
+
+	if (!demuxer.buildKeyframeIndex(videoInfo.keyframe_granule_shift, INDEX_BYTES_PER_UPDATE) || !cacheKeyframes)
+		return;
+
+	std::vector<uint8> data;
+	if (!demuxer.getKeyframeIndexData(videoInfo.keyframe_granule_shift, data))
+		return;
+
+	love::thread::Lock l(bufferMutex);
+	pendingKeyframeIndex = std::move(data);
+}
+
+void TheoraVideoStream::saveKeyframeIndex()
+{
+	// Done in main thread
+	std::vector<uint8> data;
 	{
-		// Don't swap whilst we're writing to the backbuffer
-		{
-			love::thread::Lock l(bufferMutex);
-			frameReady = false;
-		}
+		love::thread::Lock l(bufferMutex);
+		if (pendingKeyframeIndex.empty())
+			return;
+		data.swap(pendingKeyframeIndex);
+	}
 
-		for (int y = 0; y < backBuffer->yh; ++y)
-		{
-			memcpy(backBuffer->yplane+backBuffer->yw*y,
-					bufferinfo[0].data+
-						bufferinfo[0].stride*(y+yPlaneYOffset)+yPlaneXOffset,
-					backBuffer->yw);
-		}
+	auto fs = Module::getInstance<filesystem::Filesystem>(Module::M_FILESYSTEM);
+	if (fs == nullptr)
+		return;
 
-		for (int y = 0; y < backBuffer->ch; ++y)
-		{
-			memcpy(backBuffer->cbplane+backBuffer->cw*y,
-					bufferinfo[1].data+
-						bufferinfo[1].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
-		}
+	std::string filename = getKeyframeIndexFilename();
 
-		for (int y = 0; y < backBuffer->ch; ++y)
-		{
-			memcpy(backBuffer->crplane+backBuffer->cw*y,
-					bufferinfo[2].data+
-						bufferinfo[2].stride*(y+cPlaneYOffset)+cPlaneXOffset,
-					backBuffer->cw);
-		}
+	// The cache is optional, so it's fine if the save directory isn't
+	// writable.
+	try
+	{
+		size_t slash = filename.rfind('/');
+		if (slash != std::string::npos)
+			fs->createDirectory(filename.substr(0, slash).c_str());
 
-		// Re-enable swapping
-		{
-			love::thread::Lock l(bufferMutex);
-			frameReady = true;
-		}
+		fs->write(filename.c_str(), data.data(), (int64) data.size());
+	}
+	catch (love::Exception &)
+	{
 	}
 }
 
@@ -294,20 +419,36 @@ void TheoraVideoStream::fillBackBuffer()
 
 bool TheoraVideoStream::swapBuffers()
 {
-	if (demuxer.isEos())
-		return false;
+	saveKeyframeIndex();
 
 	if (!frameSync->isPlaying())
 		return false;
 
+	double position = frameSync->getPosition();
+
 	love::thread::Lock l(bufferMutex);
-	if (!frameReady)
+
+	// Show the newest queued frame which is due, and recycle any older ones
+	// which were never displayed.
+	Frame *due = nullptr;
+	double dueTime = 0.0;
+
+	while (!queuedFrames.empty() && queuedFrames.front().time <= position)
+	{
+		if (due != nullptr)
+			freeFrames.push_back(due);
+
+		due = queuedFrames.front().frame;
+		dueTime = queuedFrames.front().time;
+		queuedFrames.pop_front();
+	}
+
+	if (due == nullptr)
 		return false;
-	frameReady = false;
 
-	Frame *temp = frontBuffer;
-	frontBuffer = backBuffer;
-	backBuffer = temp;
+	freeFrames.push_back(frontBuffer);
+	frontBuffer = due;
+	frontTime = dueTime;
 
 	return true;
 }
@@ -29,6 +29,10 @@
 #include "thread/threads.h"
 #include "OggDemuxer.h"
 
+// C++
+#include <deque>
+#include <vector>
+
 // OGG/Theora
 #include <ogg/ogg.h>
 #include <theora/codec.h>
@@ -44,7 +48,11 @@ namespace theora
 class TheoraVideoStream : public love::video::VideoStream
 {
 public:
-	TheoraVideoStream(love::filesystem::File *file);
+
+	// bufferFrames is the number of frames which are decoded ahead of the one
+	// being displayed. If cacheKeyframes is true, the keyframe index is loaded
+	// from and saved to '<video>.keyframes' in the save directory.
+	TheoraVideoStream(love::filesystem::File *file, int bufferFrames = DEFAULT_BUFFER_FRAMES, bool cacheKeyframes = false);
 	~TheoraVideoStream();
 
 	const void *getFrontBuffer() const;
@@ -59,9 +67,23 @@ class TheoraVideoStream : public love::video::VideoStream
 
 	bool isPlaying() const;
 
+	int getBufferFrames() const { return bufferFrames; }
+
+	// Decodes frames into any free buffers. Called on a worker thread, never
+	// by more than one thread at a time.
 	void threadedFillBackBuffer(double dt);
 
 private:
+
+	// How much of the file is scanned for keyframes while the decoder is idle.
+	static const int64 INDEX_BYTES_PER_UPDATE = 256 * 1024;
+
+	struct QueuedFrame
+	{
+		Frame *frame;
+		double time;
+	};
+
 	OggDemuxer demuxer;
 
 	bool headerParsed;
@@ -71,21 +93,40 @@ class TheoraVideoStream : public love::video::VideoStream
 	th_info videoInfo;
 	th_dec_ctx *decoder;
 
+	int bufferFrames;
+	double frameDuration;
+
+	// The keyframe index cache is written on the main thread, once the
+	// decoder has finished the index.
+	bool cacheKeyframes;
+	std::vector<uint8> pendingKeyframeIndex;
+
+	// Every frame buffer is allocated up front. The front buffer is owned by
+	// the main thread, the free ones by the decoder, and the queued ones are
+	// waiting for their presentation time.
+	std::vector<Frame *> frames;
+	std::vector<Frame *> freeFrames;
+	std::deque<QueuedFrame> queuedFrames;
 	Frame *frontBuffer;
-	Frame *backBuffer;
+	double frontTime;
+
 	unsigned int yPlaneXOffset;
 	unsigned int cPlaneXOffset;
 	unsigned int yPlaneYOffset;
 	unsigned int cPlaneYOffset;
 
 	love::thread::MutexRef bufferMutex;
-	bool frameReady;
 
 	double lastFrame;
 	double nextFrame;
 
 	void parseHeader();
 	void seekDecoder(double target);
+	void flushQueuedFrames();
+	void copyFrame(const th_ycbcr_buffer &bufferinfo, Frame *frame) const;
+	std::string getKeyframeIndexFilename() const;
+	void buildKeyframeIndex();
+	void saveKeyframeIndex();
 }; // TheoraVideoStream
 
 } // theora
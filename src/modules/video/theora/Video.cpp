@@ -19,11 +19,12 @@
  **/
 
 // STL
+#include <algorithm>
 #include <vector>
 
 // LOVE
 #include "Video.h"
-#include "common/delay.h"
+#include "thread/ThreadPool.h"
 #include "timer/Timer.h"
 
 namespace love
@@ -45,9 +46,9 @@ Video::~Video()
 	delete workerThread;
 }
 
-VideoStream *Video::newVideoStream(love::filesystem::File *file)
+VideoStream *Video::newVideoStream(love::filesystem::File *file, int bufferFrames, bool cacheKeyframes)
 {
-	TheoraVideoStream *stream = new TheoraVideoStream(file);
+	TheoraVideoStream *stream = new TheoraVideoStream(file, bufferFrames, cacheKeyframes);
 	workerThread->addStream(stream);
 	return stream;
 }
@@ -85,37 +86,46 @@ void Worker::threadFunction()
 {
 	double lastFrame = love::timer::Timer::getTime();
 
+	std::vector<StrongRef<TheoraVideoStream>> active;
+
 	while (true)
 	{
-		love::sleep(2);
+		{
+			love::thread::Lock l(mutex);
 
-		love::thread::Lock l(mutex);
+			// Wakes up early when a stream is added or the worker is stopped.
+			cond->wait(mutex, 2);
 
-		while (!stopping && streams.empty())
-		{
-			cond->wait(mutex);
-			lastFrame = love::timer::Timer::getTime();
-		}
+			while (!stopping && streams.empty())
+			{
+				cond->wait(mutex);
+				lastFrame = love::timer::Timer::getTime();
+			}
 
-		if (stopping)
-			return;
+			if (stopping)
+				return;
+
+			// We're the only ones left holding these.
+			streams.erase(std::remove_if(streams.begin(), streams.end(), [](const StrongRef<TheoraVideoStream> &stream) {
+				return stream->getReferenceCount() == 1;
+			}), streams.end());
+
+			active = streams;
+		}
 
 		double curFrame = love::timer::Timer::getTime();
 		double dt = curFrame-lastFrame;
 		lastFrame = curFrame;
 
-		for (auto it = streams.begin(); it != streams.end(); ++it)
+		// Each stream is decoded by a single thread, but separate streams are
+		// decoded in parallel.
+		love::thread::ThreadPool::getShared().parallelFor(active.size(), 1, [&](size_t begin, size_t end)
 		{
-			TheoraVideoStream *stream = *it;
-			if (stream->getReferenceCount() == 1)
-			{
-				// We're the only ones left
-				streams.erase(it);
-				break;
-			}
+			for (size_t i = begin; i < end; i++)
+				active[i]->threadedFillBackBuffer(dt);
+		});
 
-			stream->threadedFillBackBuffer(dt);
-		}
+		active.clear();
 	}
 }
 
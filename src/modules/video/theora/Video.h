@@ -46,7 +46,7 @@ class Video : public love::video::Video
 	Video();
 	virtual ~Video();
 
-	VideoStream *newVideoStream(love::filesystem::File* file);
+	VideoStream *newVideoStream(love::filesystem::File* file, int bufferFrames, bool cacheKeyframes) override;
 
 private:
 	Worker *workerThread;
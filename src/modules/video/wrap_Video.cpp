@@ -35,6 +35,14 @@ namespace video
 int w_newVideoStream(lua_State *L)
 {
 	love::filesystem::File *file = love::filesystem::luax_getfile(L, 1);
+	int bufferFrames = (int) luaL_optinteger(L, 2, VideoStream::DEFAULT_BUFFER_FRAMES);
+	bool cacheKeyframes = luax_optboolean(L, 3, false);
+
+	if (bufferFrames < 1)
+	{
+		file->release();
+		return luaL_error(L, "Invalid number of buffered frames: %d", bufferFrames);
+	}
 
 	VideoStream *stream = nullptr;
 	luax_catchexcept(L, [&]() {
@@ -42,7 +50,7 @@ int w_newVideoStream(lua_State *L)
 		if (!file->isOpen() && !file->open(love::filesystem::File::MODE_READ))
 			luaL_error(L, "File is not open and cannot be opened");
 
-		stream = instance()->newVideoStream(file);
+		stream = instance()->newVideoStream(file, bufferFrames, cacheKeyframes);
 	});
 
 	luax_pushtype(L, stream);
@@ -62,6 +62,47 @@ love.test.data.CompressedData = function(test)
 end
 
 
+-- CompressionStream (love.data.newCompressionStream)
+love.test.data.CompressionStream = function(test)
+
+  -- create new compression streams
+  local compressor = love.data.newCompressionStream('lz4frame')
+  local decompressor = love.data.newCompressionStream('lz4frame', 'decompress')
+  test:assertObject(compressor)
+  test:assertObject(decompressor)
+  test:assertEquals('lz4frame', compressor:getFormat(), 'check format used')
+  test:assertEquals('compress', compressor:getMode(), 'check compress mode')
+  test:assertEquals('decompress', decompressor:getMode(), 'check decompress mode')
+
+  -- compress in several pieces and decompress in several pieces
+  local original = string.rep('helloworld', 10000)
+  local compressed = compressor:process('string', original:sub(1, 40000))
+  compressed = compressed .. compressor:process('data', love.data.newByteData(original:sub(40001))):getString()
+  compressed = compressed .. compressor:finish('string')
+  test:assertTrue(compressor:isFinished(), 'check compressor finished')
+  test:assertEquals(#original, compressor:getTotalIn(), 'check compressor input size')
+  test:assertEquals(#compressed, compressor:getTotalOut(), 'check compressor output size')
+
+  local decompressed = ''
+  for i=1,#compressed,1000 do
+    decompressed = decompressed .. decompressor:process('string', compressed:sub(i, i + 999))
+  end
+  decompressed = decompressed .. decompressor:finish('string')
+  test:assertTrue(decompressor:isFinished(), 'check decompressor finished')
+  test:assertEquals(original, decompressed, 'check streamed round trip')
+
+  -- stream output matches the one-shot functions
+  test:assertEquals(original, love.data.decompress('string', 'lz4frame', compressed), 'check one-shot decompress')
+
+  -- incomplete data is an error when finishing
+  local truncated = love.data.newCompressionStream('zlib', 'decompress')
+  local zcompressed = love.data.compress('string', 'zlib', original)
+  truncated:process('string', zcompressed:sub(1, 10))
+  test:assertFalse(pcall(truncated.finish, truncated, 'string'), 'check incomplete data errors')
+
+end
+
+
 --------------------------------------------------------------------------------
 --------------------------------------------------------------------------------
 ------------------------------------METHODS-------------------------------------
@@ -99,6 +140,10 @@ love.test.data.compress = function(test)
     { love.data.compress('data', 'deflate', 'heloworld', -1), 'userdata'},
     { love.data.compress('data', 'deflate', 'heloworld', 0), 'userdata'},
     { love.data.compress('data', 'deflate', 'heloworld', 9), 'userdata'},
+    { love.data.compress('string', 'lz4frame', 'helloworld', -1), 'string'},
+    { love.data.compress('data', 'lz4frame', 'helloworld', 9), 'userdata'},
+    { love.data.compress('string', 'lz4blocks', 'helloworld', -1), 'string'},
+    { love.data.compress('data', 'zlibblocks', 'helloworld', 9), 'userdata'},
   }
   for c=1,#compressions do
     test:assertNotNil(compressions[c][1])
@@ -166,6 +211,19 @@ love.test.data.decompress = function(test)
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str16):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str17):getString(), 'check data glib decompress')
   test:assertEquals(love.data.newByteData('helloworld'):getString(), love.data.decompress('data', 'gzip', str18):getString(), 'check data glib decompress')
+  local str19 = love.data.compress('string', 'lz4frame', 'helloworld', -1)
+  local str20 = love.data.compress('data', 'lz4frame', 'helloworld', 9)
+  test:assertEquals('helloworld', love.data.decompress('string', 'lz4frame', str19), 'check string lz4frame decompress')
+  test:assertEquals('helloworld', love.data.decompress('string', str20), 'check data lz4frame decompress')
+  -- block formats can decompress everything or a single block
+  local blockdata = string.rep('a', 1024*1024) .. string.rep('b', 1024*1024) .. 'c'
+  local str21 = love.data.compress('string', 'lz4blocks', blockdata)
+  local str22 = love.data.compress('data', 'zlibblocks', blockdata)
+  test:assertEquals(blockdata, love.data.decompress('string', 'lz4blocks', str21), 'check string lz4blocks decompress')
+  test:assertEquals(blockdata, love.data.decompress('string', str22), 'check data zlibblocks decompress')
+  test:assertEquals(string.rep('b', 1024*1024), love.data.decompress('string', 'lz4blocks', str21, 2), 'check lz4blocks single block')
+  test:assertEquals('c', love.data.decompress('string', str22, 3), 'check zlibblocks single block')
+  test:assertFalse(pcall(love.data.decompress, 'string', str22, 4), 'check invalid block index')
 end
 
 
@@ -193,6 +251,18 @@ love.test.data.encode = function(test)
 end
 
 
+-- love.data.getBlockCount
+love.test.data.getBlockCount = function(test)
+  local blockdata = string.rep('helloworld', 300000)
+  local count, size = love.data.getBlockCount('lz4blocks', love.data.compress('string', 'lz4blocks', blockdata))
+  test:assertEquals(3, count, 'check lz4blocks block count')
+  test:assertEquals(1024*1024, size, 'check lz4blocks block size')
+  test:assertEquals(3, love.data.getBlockCount(love.data.compress('data', 'zlibblocks', blockdata)), 'check zlibblocks block count')
+  test:assertEquals(0, love.data.getBlockCount('zlibblocks', love.data.compress('string', 'zlibblocks', '')), 'check empty block count')
+  test:assertFalse(pcall(love.data.getBlockCount, 'zlib', love.data.compress('string', 'zlib', blockdata)), 'check non-block format')
+end
+
+
 -- love.data.getPackedSize
 love.test.data.getPackedSize = function(test)
   local pack1 = love.data.getPackedSize('>xI3b')
@@ -234,6 +304,10 @@ love.test.data.hash = function(test)
   test:assertEquals('936a185caaa266bb9cbe981e9e05cb78cd732b0b3280eb944412bb6f8f8f07af', love.data.encode("string", "hex", data4), 'check data sha256 encode')
   test:assertEquals('97982a5b1414b9078103a1c008c4e3526c27b41cdbcf80790560a40f2a9bf2ed4427ab1428789915ed4b3dc07c454bd9', love.data.encode("string", "hex", data5), 'check data sha384 encode')
   test:assertEquals('1594244d52f2d8c12b142bb61f47bc2eaf503d6d9ca8480cae9fcf112f66e4967dc5e8fa98285e36db8af1b8ffa8b84cb15e0fbcf836c3deb803c13f37659a60', love.data.encode("string", "hex", data6), 'check data sha512 encode')
+    -- test non-cryptographic hashes
+  test:assertEquals('2362e202', love.data.encode("string", "hex", love.data.hash('string', 'xxh32', 'helloworld')), 'check string xxh32 encode')
+  test:assertEquals('80111601aa1c6a4f', love.data.encode("string", "hex", love.data.hash('string', 'xxh64', 'helloworld')), 'check string xxh64 encode')
+  test:assertEquals('56cbb480', love.data.encode("string", "hex", love.data.hash('data', 'crc32c', 'helloworld')), 'check data crc32c encode')
 end
 
 
@@ -244,6 +318,15 @@ love.test.data.newByteData = function(test)
 end
 
 
+-- love.data.newCompressionStream
+-- @NOTE this is just basic nil checking, objs have their own test method
+love.test.data.newCompressionStream = function(test)
+  test:assertObject(love.data.newCompressionStream('zlib'))
+  test:assertObject(love.data.newCompressionStream('gzip', 'decompress'))
+  test:assertFalse(pcall(love.data.newCompressionStream, 'lz4'), 'check lz4 block format cannot stream')
+end
+
+
 -- love.data.newDataView
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.data.newDataView = function(test)
@@ -251,6 +334,30 @@ love.test.data.newDataView = function(test)
 end
 
 
+-- love.data.newHasher
+love.test.data.newHasher = function(test)
+  -- hashing in pieces matches hashing everything at once, for every function
+  local input = string.rep('helloworld', 1000)
+  local functions = { 'md5', 'sha1', 'sha224', 'sha256', 'sha384', 'sha512', 'xxh32', 'xxh64', 'crc32c' }
+  for f=1,#functions do
+    local hasher = love.data.newHasher(functions[f])
+    test:assertObject(hasher)
+    test:assertEquals(functions[f], hasher:getFunction(), 'check hasher function')
+    hasher:update(input:sub(1, 7))
+    hasher:update(love.data.newByteData(input:sub(8, 5000)))
+    hasher:update(input:sub(5001))
+    local expected = love.data.hash('string', functions[f], input)
+    test:assertEquals(expected, hasher:finish(), 'check incremental ' .. functions[f])
+    test:assertTrue(hasher:isFinished(), 'check hasher finished')
+    test:assertFalse(pcall(hasher.update, hasher, 'more'), 'check update after finish errors')
+  end
+  -- data container
+  local hasher = love.data.newHasher('sha256')
+  hasher:update('helloworld')
+  test:assertEquals('936a185caaa266bb9cbe981e9e05cb78cd732b0b3280eb944412bb6f8f8f07af', love.data.encode('string', 'hex', hasher:finish('data')), 'check data container')
+end
+
+
 -- love.data.pack
 love.test.data.pack = function(test)
   local packed1 = love.data.pack('string', '>I4I4I4I4', 9999, 1000, 1010, 2030)
@@ -24,6 +24,16 @@ love.test.event.clear = function(test)
 end
 
 
+-- love.event.isCoalescingEnabled
+love.test.event.isCoalescingEnabled = function(test)
+  test:assertFalse(love.event.isCoalescingEnabled(), 'check default')
+  love.event.setCoalescingEnabled(true)
+  test:assertTrue(love.event.isCoalescingEnabled(), 'check enabled')
+  love.event.setCoalescingEnabled(false)
+  test:assertFalse(love.event.isCoalescingEnabled(), 'check disabled')
+end
+
+
 -- love.event.poll
 love.test.event.poll = function(test)
   -- push some events first
@@ -39,6 +49,33 @@ love.test.event.poll = function(test)
 end
 
 
+-- love.event.pollAll
+love.test.event.pollAll = function(test)
+  love.event.clear()
+  love.event.push('test', 1, 2, 3)
+  love.event.push('empty')
+  -- check events are flattened as name, argument count, arguments
+  local events, count = love.event.pollAll()
+  test:assertEquals(2, count, 'check 2 events')
+  test:assertEquals('test', events[1], 'check first name')
+  test:assertEquals(3, events[2], 'check first argument count')
+  test:assertEquals(6, events[3] + events[4] + events[5], 'check first arguments')
+  test:assertEquals('empty', events[6], 'check second name')
+  test:assertEquals(0, events[7], 'check second argument count')
+  test:assertEquals(7, events.n, 'check entry count')
+  -- check the queue was emptied and the table can be reused
+  local reused, newcount = love.event.pollAll(events)
+  test:assertEquals(events, reused, 'check table reused')
+  test:assertEquals(0, newcount, 'check no events left')
+  test:assertEquals(nil, events[1], 'check old contents cleared')
+  test:assertEquals(0, events.n, 'check entry count updated')
+  -- check entries past a hole are cleared too
+  local holes = {'a', nil, 'c', n = 3}
+  love.event.pollAll(holes)
+  test:assertEquals(nil, holes[3], 'check entries after a hole cleared')
+end
+
+
 -- love.event.pump
 -- @NOTE dont think can really test as internally used
 love.test.event.pump = function(test)
@@ -73,6 +110,36 @@ love.test.event.quit = function(test)
 end
 
 
+-- love.event.setCoalescingEnabled
+love.test.event.setCoalescingEnabled = function(test)
+  love.event.clear()
+  love.event.setCoalescingEnabled(true)
+  love.event.push('mousemoved', 10, 10, 1, 2, false)
+  love.event.push('mousemoved', 20, 30, 3, 4, false)
+  love.event.push('mousemoved', 5, 5, 1, 1, true)
+  love.event.push('test', 1)
+  love.event.push('test', 1)
+  love.event.setCoalescingEnabled(false)
+  local moves, tests = {}, 0
+  for n, a, b, c, d, e in love.event.poll() do
+    if n == 'mousemoved' then
+      table.insert(moves, {a, b, c, d, e})
+    elseif n == 'test' then
+      tests = tests + 1
+    end
+  end
+  -- check consecutive moves from the same device were merged
+  test:assertEquals(2, #moves, 'check mouse moves merged')
+  test:assertEquals(20, moves[1][1], 'check latest x')
+  test:assertEquals(30, moves[1][2], 'check latest y')
+  test:assertEquals(4, moves[1][3], 'check accumulated dx')
+  test:assertEquals(6, moves[1][4], 'check accumulated dy')
+  test:assertEquals(true, moves[2][5], 'check touch moves kept separate')
+  -- check other events are left alone
+  test:assertEquals(2, tests, 'check other events kept')
+end
+
+
 -- love.event.wait
 -- @NOTE not sure best way to test this one
 love.test.event.wait = function(test)
@@ -352,6 +352,35 @@ love.test.filesystem.load = function(test)
 end
 
 
+-- love.filesystem.loadAsync
+love.test.filesystem.loadAsync = function(test)
+  -- check loading a single file
+  local load = love.filesystem.loadAsync('resources/test.txt')
+  test:assertObject(load)
+  test:assertEquals('filedata', load:getKind(), 'check default kind')
+  test:assertTrue(load:wait(), 'check wait completes')
+  test:assertEquals('complete', load:getStatus(), 'check status')
+  local data = load:getResult()
+  test:assertEquals('helloworld', data:getString(), 'check content match')
+  -- check decoding several files at once
+  local loads = love.filesystem.loadAsync({'resources/love.png', 'resources/pixel.png'}, 'imagedata', 5)
+  test:assertEquals(2, #loads, 'check handle per file')
+  for i=1,#loads do
+    loads[i]:wait()
+    test:assertEquals(5, loads[i]:getPriority(), 'check priority')
+    test:assertObject(loads[i]:getResult())
+  end
+  test:assertEquals(64, loads[1]:getResult():getWidth(), 'check decoded width')
+  -- check missing files report an error
+  local missing = love.filesystem.loadAsync('faker.txt')
+  missing:wait()
+  local result, err = missing:getResult()
+  test:assertEquals(nil, result, 'check no result')
+  test:assertNotEquals(nil, err, 'check error message')
+  test:assertFalse(missing:cancel(), 'check finished loads cannot be cancelled')
+end
+
+
 -- love.filesystem.mount
 love.test.filesystem.mount = function(test)
   -- write an example zip to savedir to use
@@ -486,6 +515,32 @@ love.test.filesystem.read = function(test)
 end
 
 
+-- love.filesystem.readMapped
+love.test.filesystem.readMapped = function(test)
+  -- check contents match a regular read, whether or not it could be mapped
+  local data = love.filesystem.readMapped('resources/test.txt')
+  test:assertObject(data)
+  test:assertEquals('helloworld', data:getString(), 'check content match')
+  test:assertEquals(10, data:getSize(), 'check size match')
+  test:assertEquals('boolean', type(data:isMapped()), 'check mapped flag')
+  -- check clones are regular copies
+  local clone = data:clone()
+  test:assertFalse(clone:isMapped(), 'check clone not mapped')
+  test:assertEquals('helloworld', clone:getString(), 'check clone content')
+  -- check missing files error like read
+  local missing, err = love.filesystem.readMapped('faker.txt')
+  test:assertEquals(nil, missing, 'check missing file')
+  test:assertNotEquals(nil, err, 'check missing file error')
+  -- check files in the save directory are read, not mapped
+  love.filesystem.write('mapped.txt', 'savedfile')
+  local saved = love.filesystem.readMapped('mapped.txt')
+  test:assertFalse(saved:isMapped(), 'check save file not mapped')
+  love.filesystem.write('mapped.txt', 'a')
+  test:assertEquals('savedfile', saved:getString(), 'check content kept after truncation')
+  love.filesystem.remove('mapped.txt')
+end
+
+
 -- love.filesystem.remove
 love.test.filesystem.remove = function(test)
   -- create a dir + subdir with a file
@@ -501,6 +556,51 @@ love.test.filesystem.remove = function(test)
 end
 
 
+-- love.filesystem.scan
+love.test.filesystem.scan = function(test)
+  -- create a dir + subdir with 2 files
+  love.filesystem.createDirectory('scan/bar')
+  love.filesystem.write('scan/file1.txt', 'file1')
+  love.filesystem.write('scan/bar/file2.txt', 'file22')
+  -- check top level items are returned in order
+  local items = love.filesystem.scan('scan')
+  test:assertEquals(2, #items, 'check item count')
+  test:assertEquals('bar', items[1].name, 'check dir name')
+  test:assertEquals('directory', items[1].type, 'check dir type')
+  test:assertEquals('file1.txt', items[2].name, 'check file name')
+  test:assertEquals('file', items[2].type, 'check file type')
+  test:assertEquals(5, items[2].size, 'check file size')
+  test:assertNotEquals(nil, items[2].modtime, 'check file modtime')
+  -- check recursive scans include subdirectories
+  items = love.filesystem.scan('scan', {recursive = true})
+  test:assertEquals(3, #items, 'check recursive item count')
+  test:assertEquals('bar/file2.txt', items[2].name, 'check nested name')
+  test:assertEquals(6, items[2].size, 'check nested size')
+  -- check filters
+  items = love.filesystem.scan('scan', {recursive = true, filter = 'file'})
+  test:assertEquals(2, #items, 'check type filter')
+  items = love.filesystem.scan('scan', {recursive = true, filter = function(name, filetype)
+    return name:match('2%.txt$') ~= nil
+  end})
+  test:assertEquals(1, #items, 'check function filter')
+  test:assertEquals('bar/file2.txt', items[1].name, 'check function filter name')
+  -- check cached scans see new files
+  items = love.filesystem.scan('scan', {recursive = true, cache = true})
+  test:assertEquals(3, #items, 'check cached item count')
+  love.filesystem.write('scan/bar/file3.txt', 'file3')
+  items = love.filesystem.scan('scan', {recursive = true, cache = true})
+  test:assertEquals(4, #items, 'check cache invalidated')
+  -- check missing dirs
+  test:assertEquals(nil, love.filesystem.scan('scanfake'), 'check missing dir')
+  -- cleanup
+  love.filesystem.remove('scan/file1.txt')
+  love.filesystem.remove('scan/bar/file2.txt')
+  love.filesystem.remove('scan/bar/file3.txt')
+  love.filesystem.remove('scan/bar')
+  love.filesystem.remove('scan')
+end
+
+
 -- love.filesystem.setCRequirePath
 love.test.filesystem.setCRequirePath = function(test)
   -- check setting path val is returned
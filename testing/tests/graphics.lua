@@ -1213,6 +1213,55 @@ love.test.graphics.SpriteBatch = function(test)
   local imgdata5 = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata5)
 
+  -- bulk and instanced batches should match sprites added one at a time
+  local single = love.graphics.newSpriteBatch(texture2, 64)
+  local bulk = love.graphics.newSpriteBatch(texture2, 64)
+  local instanced = love.graphics.newSpriteBatch(texture2, 64, nil, true)
+  test:assertFalse(bulk:isInstanced(), 'check not instanced')
+  test:assertTrue(instanced:isInstanced(), 'check instanced')
+  local packed, colors = {}, {}
+  for s=1,64 do
+    local x, y, r = (s % 8) * 8 + 4, math.floor((s - 1) / 8) * 8 + 4, s * 0.1
+    local quad = s % 2 == 0 and quad1 or quad2
+    single:setColor(1, s / 64, 0, 1)
+    single:add(quad, x, y, r, 6, 4, 0.5, 0.5)
+    for _, v in ipairs({x, y, r, 6, 4, 0.5, 0.5, s % 2 == 0 and 1 or 2}) do
+      table.insert(packed, v)
+    end
+    for _, v in ipairs({1, s / 64, 0, 1}) do
+      table.insert(colors, v)
+    end
+  end
+  test:assertEquals(1, bulk:addMany(packed, {quad1, quad2}, colors), 'check addMany index')
+  test:assertEquals(1, instanced:addMany(packed, {quad1, quad2}, colors), 'check instanced addMany index')
+  test:assertEquals(64, bulk:getCount(), 'check addMany count')
+  test:assertEquals(64, instanced:getCount(), 'check instanced count')
+  local images = {}
+  for i, batch in ipairs({single, bulk, instanced}) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 1)
+      love.graphics.draw(batch, 0, 0)
+    love.graphics.setCanvas()
+    images[i] = love.graphics.readbackTexture(canvas)
+  end
+  for i=2,3 do
+    -- allow for a few edge pixels rasterizing differently
+    local mismatches = 0
+    for x=0,63 do
+      for y=0,63 do
+        local r1, g1, b1 = images[1]:getPixel(x, y)
+        local r2, g2, b2 = images[i]:getPixel(x, y)
+        if math.abs(r1 - r2) > 0.02 or math.abs(g1 - g2) > 0.02 or math.abs(b1 - b2) > 0.02 then
+          mismatches = mismatches + 1
+        end
+      end
+    end
+    test:assertRange(mismatches, 0, 4, 'check batch ' .. i .. ' matches individual adds')
+  end
+  bulk:setMany(1, {0, 0, 0, 1, 1, 0, 0, 0})
+  test:assertEquals(64, bulk:getCount(), 'check setMany keeps count')
+  test:assertEquals(false, pcall(bulk.addMany, bulk, {1, 2, 3}), 'check invalid sprite table')
+
 end
 
 
@@ -1315,6 +1364,26 @@ love.test.graphics.Video = function(test)
   local imgdata = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata)
 
+  -- check the keyframe index is only cached when asked for
+  local cachefile = 'resources/sample.ogv.keyframes'
+  test:assertEquals(nil, love.filesystem.getInfo(cachefile), 'check keyframes not cached by default')
+  local cached = love.graphics.newVideo('resources/sample.ogv', {
+    audio = false,
+    cachekeyframes = true
+  })
+  cached:play()
+  for i=1,40 do
+    love.graphics.setCanvas(canvas)
+      love.graphics.draw(cached, 0, 0)
+    love.graphics.setCanvas()
+    if love.filesystem.getInfo(cachefile) ~= nil then break end
+    test:waitSeconds(0.05)
+  end
+  cached:pause()
+  test:assertNotEquals(nil, love.filesystem.getInfo(cachefile), 'check keyframes cached')
+  love.filesystem.remove(cachefile)
+  love.filesystem.remove('resources')
+
 end
 
 
@@ -1647,8 +1716,11 @@ end
 -- love.graphics.captureScreenshot
 love.test.graphics.captureScreenshot = function(test)
   love.graphics.captureScreenshot('example-screenshot.png')
-  test:waitFrames(1)
-  -- need to wait until end of the frame for the screenshot
+  -- screenshots are read back asynchronously, so can take a few frames
+  for i=1,10 do
+    test:waitFrames(1)
+    if love.filesystem.exists('example-screenshot.png') then break end
+  end
   test:assertTrue(love.filesystem.exists('example-screenshot.png'))
   love.filesystem.remove('example-screenshot.png')
   -- test callback version
@@ -1659,7 +1731,10 @@ love.test.graphics.captureScreenshot = function(test)
     test:assertNotEquals(nil, idata, 'check we have image data')
     cbdata = idata
   end)
-  test:waitFrames(1)
+  for i=1,10 do
+    test:waitFrames(1)
+    if cbdata ~= nil then break end
+  end
   TextCommand = prevtextcommand
   test:assertNotNil(cbdata)
 
@@ -1673,6 +1748,72 @@ love.test.graphics.captureScreenshot = function(test)
 end
 
 
+-- love.graphics.startRecording
+-- @NOTE also covers stopRecording, isRecording and getRecordingStats
+love.test.graphics.startRecording = function(test)
+  local renderer = love.graphics.getRendererInfo()
+  if renderer ~= 'OpenGL' and renderer ~= 'OpenGL ES' then
+    test:assertTrue(true, 'skip test')
+    return
+  end
+  test:assertFalse(love.graphics.isRecording(), 'check not recording')
+  -- record every other frame, waiting for slots so nothing is dropped
+  love.graphics.startRecording({
+    format = 'qoi', directory = 'recordtest', interval = 2, maxpending = 2, wait = true
+  })
+  test:assertTrue(love.graphics.isRecording(), 'check recording')
+  test:waitFrames(6)
+  local stats = love.graphics.getRecordingStats()
+  test:assertGreaterEqual(5, stats.presented, 'check presented frames')
+  local final = love.graphics.stopRecording()
+  test:assertFalse(love.graphics.isRecording(), 'check stopped recording')
+  test:assertEquals(0, final.dropped, 'check no dropped frames')
+  test:assertEquals(0, final.pending, 'check no pending frames')
+  test:assertEquals(final.captured, final.written, 'check all frames written')
+  test:assertEquals(math.ceil(final.presented / 2), final.captured, 'check interval')
+  test:assertNotNil(love.filesystem.getInfo('recordtest/00000000.qoi'))
+  local frame = love.image.newImageData('recordtest/00000000.qoi')
+  test:assertEquals(love.graphics.getPixelWidth(), frame:getWidth(), 'check frame width')
+  -- cleanup
+  for _, name in ipairs(love.filesystem.getDirectoryItems('recordtest')) do
+    love.filesystem.remove('recordtest/' .. name)
+  end
+  love.filesystem.remove('recordtest')
+end
+
+
+-- love.graphics.startProfiling
+-- @NOTE also covers stopProfiling, isProfiling, pushProfileZone,
+-- popProfileZone, getProfileZones and saveProfile
+love.test.graphics.startProfiling = function(test)
+  test:assertFalse(love.graphics.isProfiling(), 'check not profiling')
+  -- zones are ignored while not profiling
+  love.graphics.pushProfileZone('ignored')
+  love.graphics.popProfileZone()
+  love.graphics.startProfiling({ frames = 32 })
+  test:assertTrue(love.graphics.isProfiling(), 'check profiling')
+  test:assertFalse(pcall(love.graphics.popProfileZone), 'check unbalanced pop errors')
+  love.graphics.pushProfileZone('testzone')
+  love.graphics.rectangle('fill', 0, 0, 16, 16)
+  love.graphics.popProfileZone()
+  test:waitFrames(20)
+  local zones = love.graphics.getProfileZones()
+  test:assertGreaterEqual(2, #zones, 'check frame and present zones')
+  test:assertEquals('frame', zones[1].name, 'check frame zone')
+  test:assertEquals(0, zones[1].depth, 'check frame zone depth')
+  test:assertGreaterEqual(0, zones[1].cputime, 'check frame zone time')
+  test:assertEquals('present', zones[#zones].name, 'check present zone')
+  local frames = love.graphics.saveProfile('profiletest.json')
+  test:assertGreaterEqual(1, frames, 'check saved frames')
+  local json = love.filesystem.read('profiletest.json')
+  test:assertNotEquals(nil, json:find('"traceEvents"', 1, true), 'check trace events')
+  test:assertNotEquals(nil, json:find('"testzone"', 1, true), 'check pushed zone')
+  love.graphics.stopProfiling()
+  test:assertFalse(love.graphics.isProfiling(), 'check stopped profiling')
+  love.filesystem.remove('profiletest.json')
+end
+
+
 -- love.graphics.newArrayImage
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.graphics.newArrayImage = function(test)
@@ -1804,6 +1945,14 @@ love.test.graphics.newVideo = function(test)
     audio = false,
     dpiscale = 1
   }))
+  test:assertObject(love.graphics.newVideo('resources/sample.ogv', {
+    audio = false,
+    bufferframes = 2
+  }))
+  test:assertObject(love.graphics.newVideo('resources/sample.ogv', {
+    audio = false,
+    cachekeyframes = false
+  }))
 end
 
 
@@ -2570,6 +2719,17 @@ love.test.graphics.inverseTransformPoint = function(test)
 end
 
 
+-- love.graphics.inverseTransformPoints
+love.test.graphics.inverseTransformPoints = function(test)
+  love.graphics.translate(1, 5)
+  local points = love.graphics.inverseTransformPoints({1, 5, 2, 7})
+  test:assertEquals(4, #points, 'check point count')
+  test:assertCoords({0, 0}, {points[1], points[2]}, 'check first point')
+  test:assertCoords({1, 2}, {points[3], points[4]}, 'check second point')
+  love.graphics.origin()
+end
+
+
 -- love.graphics.origin
 love.test.graphics.origin = function(test)
   -- if we do some translations and scaling
@@ -2735,6 +2895,22 @@ love.test.graphics.transformPoint = function(test)
 end
 
 
+-- love.graphics.transformPoints
+love.test.graphics.transformPoints = function(test)
+  love.graphics.translate(1, 5)
+  local points = love.graphics.transformPoints({0, 0, 1, 2})
+  test:assertEquals(4, #points, 'check point count')
+  test:assertCoords({1, 5}, {points[1], points[2]}, 'check first point')
+  test:assertCoords({2, 7}, {points[3], points[4]}, 'check second point')
+  -- check packed float data is transformed in place
+  local data = love.data.newByteData(4 * 2 * 5)
+  data:setFloat(0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4)
+  love.graphics.transformPoints(data)
+  test:assertCoords({5, 9}, {data:getFloat(32), data:getFloat(36)}, 'check data point')
+  love.graphics.origin()
+end
+
+
 -- love.graphics.translate
 love.test.graphics.translate = function(test)
   -- starting at 0,0, we translate 4 times and draw a pixel at each point
@@ -2899,12 +3075,33 @@ end
 love.test.graphics.getStats = function(test)
   local stattypes = {
     'drawcalls', 'canvasswitches', 'texturememory', 'shaderswitches',
-    'drawcallsbatched', 'textures', 'fonts'
+    'drawcallsbatched', 'textures', 'fonts', 'buffermemory', 'bufferuploads',
+    'bufferuploadbytes', 'videouploadbytes', 'videouploadtime'
   }
   local stats = love.graphics.getStats()
   for s=1,#stattypes do
     test:assertNotEquals(nil, stats[stattypes[s] ], 'expected a key for stat: ' .. stattypes[s])
   end
+  -- check two sprites far apart in a batch are uploaded as separate ranges
+  local texture = love.graphics.newImage('resources/love.png')
+  local sbatch = love.graphics.newSpriteBatch(texture, 100, 'dynamic')
+  for i=1,100 do
+    sbatch:add(0, 0)
+  end
+  local canvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(canvas)
+    love.graphics.draw(sbatch)
+    local before = love.graphics.getStats()
+    sbatch:set(2, 1, 1)
+    sbatch:set(90, 1, 1)
+    love.graphics.draw(sbatch)
+    local after = love.graphics.getStats()
+  love.graphics.setCanvas()
+  -- each sprite is 4 vertices of 2 position floats, 2 texcoord floats and 4
+  -- color bytes
+  local spritesize = 4 * (4 * 4 + 4)
+  test:assertEquals(2, after.bufferuploads - before.bufferuploads, 'check separate range uploads')
+  test:assertEquals(2 * spritesize, after.bufferuploadbytes - before.bufferuploadbytes, 'check uploaded range bytes')
 end
 
 
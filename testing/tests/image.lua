@@ -89,6 +89,16 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read1)
   love.filesystem.remove('test-encode.png')
 
+  -- check encoding with compression options round trips
+  local large = love.image.newImageData(512, 512, 'rgba8')
+  large:mapPixel(function(x, y) return (x % 256) / 255, (y % 256) / 255, ((x + y) % 256) / 255, 1 end)
+  local settings = {{compression = 0, filter = 'none'}, {compression = 9, filter = 'paeth'}, {filter = 'entropy'}}
+  for s=1,#settings do
+    local encoded = large:encode('png', nil, settings[s])
+    local decoded = love.image.newImageData(encoded)
+    test:assertEquals(large:getString(), decoded:getString(), 'check png encode settings ' .. s)
+  end
+
   -- check encoding to an image (exr)
   local edata = love.image.newImageData(100, 100, 'r16f')
   edata:encode('exr', 'test-encode.exr')
@@ -96,6 +106,92 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read2)
   love.filesystem.remove('test-encode.exr')
 
+  -- check converting to other formats and back
+  local formats = {'rgba16', 'rgba16f', 'rgba32f'}
+  for f=1,#formats do
+    local converted = idata:convert(formats[f])
+    test:assertEquals(formats[f], converted:getFormat(), 'check converted format ' .. formats[f])
+    local r3, g3, b3, a3 = converted:getPixel(25, 25)
+    test:assertRange(r3, 0.999, 1.001, 'check converted red ' .. formats[f])
+    test:assertRange(g3 + b3, 0, 0.001, 'check converted green/blue ' .. formats[f])
+    local back = converted:convert('rgba8')
+    test:assertEquals(idata:getString(), back:getString(), 'check round trip ' .. formats[f])
+  end
+  local la8 = idata:convert('la8')
+  local l4, l5, _, a4 = la8:getPixel(25, 25)
+  test:assertEquals(1, l4, 'check la8 luminance')
+  test:assertEquals(l4, l5, 'check la8 grey')
+  test:assertEquals(1, a4, 'check la8 alpha')
+
+  -- check pasting between formats
+  local hdata = love.image.newImageData(64, 64, 'rgba16')
+  hdata:paste(idata, 0, 0, 0, 0)
+  local r5, g5, b5 = hdata:getPixel(25, 25)
+  test:assertEquals(1, r5+g5+b5, 'check pasted red')
+  -- check partial pastes between formats without pixel functions are copied
+  local bgra1 = love.image.newImageData(2, 2, 'bgra8', string.rep('\1\2\3\4', 4))
+  local bgra2 = love.image.newImageData(2, 2, 'bgra8')
+  bgra2:paste(bgra1, 1, 0, 0, 0, 1, 2)
+  test:assertEquals(string.rep('\0\0\0\0\1\2\3\4', 2), bgra2:getString(), 'check partial same format paste')
+
+  -- check converting between sRGB and linear
+  local grey = love.image.newImageData(1, 1, 'rgba8')
+  grey:setPixel(0, 0, 0.5, 0.5, 0.5, 0.5)
+  local lgrey = grey:convert('rgba32f', true)
+  test:assertTrue(lgrey:isLinear(), 'check converted linear')
+  local r6, _, _, a6 = lgrey:getPixel(0, 0)
+  test:assertRange(r6, 0.21, 0.22, 'check linear red')
+  test:assertRange(a6, 0.50, 0.51, 'check linear alpha unchanged')
+
+  -- check resizing
+  local half = idata:resize(32, 16)
+  test:assertEquals(32, half:getWidth(), 'check resized w')
+  test:assertEquals(16, half:getHeight(), 'check resized h')
+  test:assertEquals('rgba8', half:getFormat(), 'check resized format')
+  local solid = love.image.newImageData(8, 8, 'rgba8')
+  solid:mapPixel(function() return 0.25, 0.5, 0.75, 1 end)
+  local filters = {'nearest', 'box', 'linear', 'lanczos'}
+  for f=1,#filters do
+    local resized = solid:resize(3, 5, filters[f])
+    local r7, g7, b7, a7 = resized:getPixel(1, 2)
+    test:assertRange(r7, 0.24, 0.26, 'check resized red ' .. filters[f])
+    test:assertRange(g7, 0.49, 0.51, 'check resized green ' .. filters[f])
+    test:assertRange(b7, 0.74, 0.76, 'check resized blue ' .. filters[f])
+    test:assertEquals(1, a7, 'check resized alpha ' .. filters[f])
+  end
+
+  -- check premultiplying alpha
+  local pdata = love.image.newImageData(2, 2, 'rgba8')
+  pdata:setPixel(0, 0, 1, 1, 1, 0.5)
+  pdata:premultiplyAlpha()
+  local r8, _, _, a8 = pdata:getPixel(0, 0)
+  test:assertRange(r8, 0.49, 0.51, 'check premultiplied red')
+  test:assertRange(a8, 0.49, 0.51, 'check premultiplied alpha')
+
+  -- check blurring spreads a single pixel out
+  local bdata = love.image.newImageData(9, 9, 'rgba32f')
+  bdata:mapPixel(function() return 0, 0, 0, 1 end)
+  bdata:setPixel(4, 4, 1, 1, 1, 1)
+  bdata:setLinear(true)
+  bdata:gaussianBlur(1)
+  local r9 = bdata:getPixel(4, 4)
+  local r10 = bdata:getPixel(5, 4)
+  test:assertTrue(r9 < 1 and r10 > 0 and r10 < r9, 'check blurred')
+
+  -- check flipping and rotating
+  local odata = love.image.newImageData(3, 2, 'rgba8')
+  odata:setPixel(0, 0, 1, 0, 0, 1)
+  odata:flip(true, true)
+  local r11 = odata:getPixel(2, 1)
+  test:assertEquals(1, r11, 'check flipped')
+  local rotated = odata:rotate90()
+  test:assertEquals(2, rotated:getWidth(), 'check rotated w')
+  test:assertEquals(3, rotated:getHeight(), 'check rotated h')
+  local r12 = rotated:getPixel(0, 2)
+  test:assertEquals(1, r12, 'check rotated clockwise')
+  local r13 = odata:rotate90(false):getPixel(1, 0)
+  test:assertEquals(1, r13, 'check rotated counterclockwise')
+
   -- check linear
   test:assertFalse(idata:isLinear(), 'check not linear')
   idata:setLinear(true)
@@ -125,6 +221,29 @@ end
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.image.newCompressedData = function(test)
   test:assertObject(love.image.newCompressedData('resources/love.dxt1'))
+  -- compressing imagedata on the cpu
+  local source = love.image.newImageData('resources/love.png')
+  local formats = {'DXT1', 'DXT5', 'BC4', 'BC5', 'BC7', 'ETC1', 'ETC2rgb', 'ETC2rgba'}
+  for f=1,#formats do
+    local cdata = love.image.newCompressedData(source, formats[f])
+    test:assertObject(cdata)
+    test:assertEquals(formats[f], cdata:getFormat(), 'check compressed format')
+    test:assertEquals(source:getWidth(), cdata:getWidth(), 'check compressed width')
+    test:assertEquals(1, cdata:getMipmapCount(), 'check no mipmaps')
+  end
+  local mipmapped = love.image.newCompressedData(source, 'BC7', {mipmaps = true})
+  test:assertGreaterEqual(2, mipmapped:getMipmapCount(), 'check mipmaps')
+  test:assertEquals(1, mipmapped:getWidth(mipmapped:getMipmapCount()), 'check last mip width')
+  -- second call should load the same data back from the cache
+  local cached1 = love.image.newCompressedData(source, 'DXT5', {cache = 'compressedtest'})
+  local cached2 = love.image.newCompressedData(source, 'DXT5', {cache = 'compressedtest'})
+  test:assertEquals(cached1:getString(), cached2:getString(), 'check cached data matches')
+  test:assertEquals(1, #love.filesystem.getDirectoryItems('compressedtest'), 'check cache file')
+  for _, item in ipairs(love.filesystem.getDirectoryItems('compressedtest')) do
+    love.filesystem.remove('compressedtest/' .. item)
+  end
+  love.filesystem.remove('compressedtest')
+  test:assertEquals(false, pcall(love.image.newCompressedData, source, 'ASTC4x4'), 'check unsupported format')
 end
 
 
@@ -104,6 +104,39 @@ love.test.math.RandomGenerator = function(test)
   test:assertNotEquals(rng1:random(), rng2:random(), 'check not matching states')
   test:assertNotEquals(rng1:randomNormal(), rng2:randomNormal(), 'check not matching states')
 
+  -- check bulk fill matches the scalar sequence
+  rng2:setState(rng1:getState())
+  local data = love.data.newByteData(8 * 4)
+  test:assertEquals(4, rng1:fill(data, 'double'), 'check fill count')
+  for i=0,3 do
+    test:assertEquals(rng2:random(), data:getDouble(i * 8), 'check fill value ' .. tostring(i))
+  end
+  rng1:fill(data, 'uint8', 3, 5)
+  for i=0,data:getSize()-1 do
+    test:assertRange(data:getUInt8(i), 3, 5, 'check fill integer range')
+  end
+  test:assertEquals(2, rng1:fillNormal(data, 'float', 1, 0, 8, 2), 'check fillNormal count')
+  -- check unaligned offsets
+  rng2:setState(rng1:getState())
+  test:assertEquals(3, rng1:fill(data, 'double', 0, 1, 1), 'check unaligned fill count')
+  for i=0,2 do
+    test:assertEquals(rng2:random(), data:getDouble(1 + i * 8), 'check unaligned fill value ' .. tostring(i))
+  end
+  -- check invalid integer ranges are rejected
+  test:assertFalse(pcall(rng1.fill, rng1, data, 'uint8', 5, 3), 'check min > max')
+  test:assertFalse(pcall(rng1.fill, rng1, data, 'uint8', 0, 256), 'check max out of range')
+  test:assertFalse(pcall(rng1.fill, rng1, data, 'int8', -129, 0), 'check min out of range')
+
+  -- check streams are reproducible and independent
+  rng1:setSeed(1234)
+  local stream1 = rng1:split(1)
+  local stream2 = rng1:split(2)
+  test:assertObject(stream1)
+  rng2:setState(rng1:getState())
+  rng2:jump(1)
+  test:assertEquals(stream1:getState(), rng2:getState(), 'check split matches jump')
+  test:assertNotEquals(stream1:random(), stream2:random(), 'check streams differ')
+
 end
 
 
@@ -125,6 +158,20 @@ love.test.math.Transform = function(test)
   px, py = transform:transformPoint(1, 1)
   test:assertCoords({1, 1}, {px, py}, 'check reset')
 
+  -- check batch transforms match single point transforms
+  transform:translate(3, 2)
+  local points = transform:transformPoints({1, 1, -2, 4})
+  test:assertCoords({4, 3}, {points[1], points[2]}, 'check batch transform 1')
+  test:assertCoords({1, 6}, {points[3], points[4]}, 'check batch transform 2')
+  points = transform:inverseTransformPoints(points)
+  test:assertCoords({-2, 4}, {points[3], points[4]}, 'check batch inverse transform')
+  local data = love.data.newByteData(4 * 2 * 6)
+  data:setFloat(0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5)
+  transform:transformPoints(data, 8, 5)
+  test:assertCoords({0, 0}, {data:getFloat(0), data:getFloat(4)}, 'check data offset')
+  test:assertCoords({8, 7}, {data:getFloat(40), data:getFloat(44)}, 'check data transform')
+  transform:reset()
+
   -- apply a transform to another transform
   local transform2 = love.math.newTransform()
   transform2:translate(5, 3)
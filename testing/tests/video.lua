@@ -43,4 +43,8 @@ end
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.video.newVideoStream = function(test)
   test:assertObject(love.video.newVideoStream('resources/sample.ogv'))
+  test:assertObject(love.video.newVideoStream('resources/sample.ogv', 8))
+  test:assertObject(love.video.newVideoStream('resources/sample.ogv', nil, true))
+  local ok = pcall(love.video.newVideoStream, 'resources/sample.ogv', 0)
+  test:assertFalse(ok, 'check invalid buffer frame count')
 end